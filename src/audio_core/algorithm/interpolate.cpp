@@ -13,6 +13,17 @@
 #include "common/common_types.h"
 #include "common/logging/log.h"
 
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+
+#ifdef _MSC_VER
+#define SSE41_FUNCTION
+#else
+#define SSE41_FUNCTION __attribute__((target("sse4.1")))
+#endif
+#endif
+
 namespace AudioCore {
 
 constexpr std::array<s16, 512> curve_lut0{
@@ -141,31 +152,72 @@ constexpr std::array<s16, 512> curve_lut2{
     26230, 2688,  -42,   3751,  26253, 2811,  -38,   3608,  26270, 2936,  -34,   3467,  26281,
     3064,  -32,   3329,  26287, 3195};
 
-std::vector<s16> Interpolate(InterpolationState& state, std::vector<s16> input, double ratio) {
+namespace {
+const std::array<s16, 512>& GetCurve(s32 step) {
+    if (step > 0xaaaa) {
+        return curve_lut0;
+    }
+    if (step <= 0x8000) {
+        return curve_lut1;
+    }
+    return curve_lut2;
+}
+
+// The curves widened to 32 bits, one 16 byte aligned row of taps per phase, so that a phase can be
+// multiplied with the input samples in a single vector operation
+struct alignas(16) Phase {
+    std::array<s32, 4> taps;
+};
+using PhaseTable = std::array<Phase, 128>;
+
+constexpr PhaseTable MakePhaseTable(const std::array<s16, 512>& curve) {
+    PhaseTable table{};
+    for (std::size_t i = 0; i < curve.size(); i++) {
+        table[i / 4].taps[i % 4] = curve[i];
+    }
+    return table;
+}
+
+constexpr PhaseTable phase_table0 = MakePhaseTable(curve_lut0);
+constexpr PhaseTable phase_table1 = MakePhaseTable(curve_lut1);
+constexpr PhaseTable phase_table2 = MakePhaseTable(curve_lut2);
+
+[[maybe_unused]] const PhaseTable& GetPhaseTable(s32 pitch) {
+    if (pitch > 0xaaaa) {
+        return phase_table0;
+    }
+    if (pitch <= 0x8000) {
+        return phase_table1;
+    }
+    return phase_table2;
+}
+} // Anonymous namespace
+
+std::size_t InterpolatedSize(std::size_t input_size, double ratio) {
+    if (ratio <= 0) {
+        return input_size;
+    }
+    // Every input frame moves the position by one, every output frame by ratio
+    const auto num_frames = static_cast<double>(input_size / 2);
+    return (static_cast<std::size_t>(num_frames / ratio) + 2) * 2;
+}
+
+std::size_t Interpolate(InterpolationState& state, std::span<const s16> input,
+                        std::span<s16> output, double ratio) {
     if (input.size() < 2)
-        return {};
+        return 0;
 
     if (ratio <= 0) {
         LOG_ERROR(Audio, "Nonsensical interpolation ratio {}", ratio);
-        return input;
+        std::copy(input.begin(), input.end(), output.begin());
+        return input.size();
     }
 
     const s32 step{static_cast<s32>(ratio * 0x8000)};
-    const std::array<s16, 512>& lut = [step] {
-        if (step > 0xaaaa) {
-            return curve_lut0;
-        }
-        if (step <= 0x8000) {
-            return curve_lut1;
-        }
-        return curve_lut2;
-    }();
+    const std::array<s16, 512>& lut = GetCurve(step);
 
     const std::size_t num_frames{input.size() / 2};
-
-    std::vector<s16> output;
-    output.reserve(static_cast<std::size_t>(static_cast<double>(input.size()) / ratio +
-                                            InterpolationState::taps));
+    std::size_t output_size{};
 
     for (std::size_t frame{}; frame < num_frames; ++frame) {
         const std::size_t lut_index{(state.fraction >> 8) * InterpolationState::taps};
@@ -187,31 +239,38 @@ std::vector<s16> Interpolate(InterpolationState& state, std::vector<s16> input,
 
             state.fraction = new_offset & 0x7fff;
 
-            output.emplace_back(static_cast<s16>(std::clamp(left >> 15, SHRT_MIN, SHRT_MAX)));
-            output.emplace_back(static_cast<s16>(std::clamp(right >> 15, SHRT_MIN, SHRT_MAX)));
+            output[output_size++] = static_cast<s16>(std::clamp(left >> 15, SHRT_MIN, SHRT_MAX));
+            output[output_size++] = static_cast<s16>(std::clamp(right >> 15, SHRT_MIN, SHRT_MAX));
 
             state.position += ratio;
         }
         state.position -= 1.0;
     }
 
+    return output_size;
+}
+
+std::vector<s16> Interpolate(InterpolationState& state, std::vector<s16> input, double ratio) {
+    if (input.size() < 2)
+        return {};
+
+    if (ratio <= 0) {
+        LOG_ERROR(Audio, "Nonsensical interpolation ratio {}", ratio);
+        return input;
+    }
+
+    std::vector<s16> output(InterpolatedSize(input.size(), ratio));
+    output.resize(Interpolate(state, input, output, ratio));
     return output;
 }
 
-void Resample(s32* output, const s32* input, s32 pitch, s32& fraction, std::size_t sample_count) {
-    const std::array<s16, 512>& lut = [pitch] {
-        if (pitch > 0xaaaa) {
-            return curve_lut0;
-        }
-        if (pitch <= 0x8000) {
-            return curve_lut1;
-        }
-        return curve_lut2;
-    }();
+namespace Scalar {
+void Resample(std::span<s32> output, std::span<const s32> input, s32 pitch, s32& fraction) {
+    const std::array<s16, 512>& lut = GetCurve(pitch);
 
     std::size_t index{};
 
-    for (std::size_t i = 0; i < sample_count; i++) {
+    for (std::size_t i = 0; i < output.size(); i++) {
         const std::size_t lut_index{(static_cast<std::size_t>(fraction) >> 8) * 4};
         const auto l0 = lut[lut_index + 0];
         const auto l1 = lut[lut_index + 1];
@@ -225,9 +284,61 @@ void Resample(s32* output, const s32* input, s32 pitch, s32& fraction, std::size
 
         output[i] = (l0 * s0 + l1 * s1 + l2 * s2 + l3 * s3) >> 15;
         fraction += pitch;
-        index += (fraction >> 15);
+        index += static_cast<std::size_t>(fraction >> 15);
         fraction &= 0x7fff;
     }
 }
+} // namespace Scalar
+
+#ifdef ARCHITECTURE_x86_64
+namespace SSE41 {
+namespace {
+// Multiplies the taps of the current phase with the input samples they apply to, then moves on to
+// the position of the next output sample
+SSE41_FUNCTION __m128i NextProducts(const PhaseTable& table, const s32* input, std::size_t& index,
+                                    s32 pitch, s32& fraction) {
+    const Phase& phase = table[static_cast<std::size_t>(fraction) >> 8];
+    const __m128i taps = _mm_load_si128(reinterpret_cast<const __m128i*>(phase.taps.data()));
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + index));
+    fraction += pitch;
+    index += static_cast<std::size_t>(fraction >> 15);
+    fraction &= 0x7fff;
+    return _mm_mullo_epi32(taps, samples);
+}
+} // Anonymous namespace
+
+bool IsSupported() {
+    return Common::GetCPUCaps().sse4_1;
+}
+
+SSE41_FUNCTION void Resample(std::span<s32> output, std::span<const s32> input, s32 pitch,
+                             s32& fraction) {
+    const PhaseTable& table = GetPhaseTable(pitch);
+    std::size_t index{};
+    std::size_t i = 0;
+    // The positions only take a few scalar operations to advance, the four taps of a phase are
+    // summed for four output samples at once
+    for (; i + 4 <= output.size(); i += 4) {
+        const __m128i p0 = NextProducts(table, input.data(), index, pitch, fraction);
+        const __m128i p1 = NextProducts(table, input.data(), index, pitch, fraction);
+        const __m128i p2 = NextProducts(table, input.data(), index, pitch, fraction);
+        const __m128i p3 = NextProducts(table, input.data(), index, pitch, fraction);
+        const __m128i sums = _mm_hadd_epi32(_mm_hadd_epi32(p0, p1), _mm_hadd_epi32(p2, p3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output.data() + i), _mm_srai_epi32(sums, 15));
+    }
+    Scalar::Resample(output.subspan(i), input.subspan(index), pitch, fraction);
+}
+} // namespace SSE41
+#endif
+
+void Resample(std::span<s32> output, std::span<const s32> input, s32 pitch, s32& fraction) {
+#ifdef ARCHITECTURE_x86_64
+    static const bool use_sse41 = SSE41::IsSupported();
+    if (use_sse41) {
+        return SSE41::Resample(output, input, pitch, fraction);
+    }
+#endif
+    return Scalar::Resample(output, input, pitch, fraction);
+}
 
 } // namespace AudioCore
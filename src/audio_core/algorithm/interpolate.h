@@ -5,6 +5,8 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <span>
 #include <vector>
 
 #include "common/common_types.h"
@@ -19,6 +21,19 @@ struct InterpolationState {
     s32 fraction{};
 };
 
+/// Returns the number of samples Interpolate may produce at most for input_size samples.
+[[nodiscard]] std::size_t InterpolatedSize(std::size_t input_size, double ratio);
+
+/// Interpolates input signal to produce output signal.
+/// @param input The signal to interpolate.
+/// @param output Receives the interpolated signal, at least InterpolatedSize() in length.
+/// @param ratio Interpolation ratio.
+///              ratio > 1.0 results in fewer output samples.
+///              ratio < 1.0 results in more output samples.
+/// @returns Number of samples written to output.
+std::size_t Interpolate(InterpolationState& state, std::span<const s16> input,
+                        std::span<s16> output, double ratio);
+
 /// Interpolates input signal to produce output signal.
 /// @param input The signal to interpolate.
 /// @param ratio Interpolation ratio.
@@ -38,7 +53,26 @@ inline std::vector<s16> Interpolate(InterpolationState& state, std::vector<s16>
     return Interpolate(state, std::move(input), ratio);
 }
 
-/// Nintendo Switchs DSP resampling algorithm. Based on a single channel
-void Resample(s32* output, const s32* input, s32 pitch, s32& fraction, std::size_t sample_count);
+/// Nintendo Switchs DSP resampling algorithm. Based on a single channel.
+/// It is a 4 tap polyphase filter, with 128 phases picked by the top bits of fraction.
+/// @param output Receives output.size() resampled samples.
+/// @param input Samples to resample, including the 3 samples after the last one reached.
+/// @param pitch Distance between two output samples in the input, in Q15.
+/// @param fraction Position between two input samples in Q15, updated for the next call.
+void Resample(std::span<s32> output, std::span<const s32> input, s32 pitch, s32& fraction);
+
+/// Portable implementation, also the reference the vectorized one is tested against.
+namespace Scalar {
+void Resample(std::span<s32> output, std::span<const s32> input, s32 pitch, s32& fraction);
+} // namespace Scalar
+
+#ifdef ARCHITECTURE_x86_64
+namespace SSE41 {
+/// Returns whether the host CPU has the instructions required by these implementations
+[[nodiscard]] bool IsSupported();
+
+void Resample(std::span<s32> output, std::span<const s32> input, s32 pitch, s32& fraction);
+} // namespace SSE41
+#endif
 
 } // namespace AudioCore
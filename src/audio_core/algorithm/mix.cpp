@@ -0,0 +1,308 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstdlib>
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#endif
+
+#include "audio_core/algorithm/mix.h"
+#include "common/common_types.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include "common/x64/cpu_detect.h"
+#endif
+
+#ifdef ARCHITECTURE_x86_64
+// Only the vectorized kernels are built for the extensions, so the rest of the renderer keeps
+// running on hosts without them
+#ifdef _MSC_VER
+#define SSE41_FUNCTION
+#define AVX2_FUNCTION
+#else
+#define SSE41_FUNCTION __attribute__((target("sse4.1")))
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace AudioCore {
+namespace {
+s32 MulQ15(s32 sample, s32 gain) {
+    return static_cast<s32>((static_cast<s64>(sample) * gain + 0x4000) >> 15);
+}
+
+// Sums and gains wrap around on overflow, like the vector lanes do
+s32 WrappingAdd(s32 a, s32 b) {
+    return static_cast<s32>(static_cast<u32>(a) + static_cast<u32>(b));
+}
+
+#ifdef ARCHITECTURE_x86_64
+s32 WrappingMul(s32 a, u32 b) {
+    return static_cast<s32>(static_cast<u32>(a) * b);
+}
+
+// The products are computed on 64 bits like the scalar code, for the even and odd lanes
+// separately. Only bits 15 to 46 of the rounded product make it into the result, so they can be
+// moved into place with logical shifts: down into the low half for the even lanes and up into the
+// high half for the odd ones, which are then blended together.
+
+SSE41_FUNCTION __m128i MulQ15(__m128i samples, __m128i gains) {
+    const __m128i round = _mm_set1_epi64x(0x4000);
+    const __m128i even = _mm_srli_epi64(_mm_add_epi64(_mm_mul_epi32(samples, gains), round), 15);
+    const __m128i odd = _mm_slli_epi64(
+        _mm_add_epi64(_mm_mul_epi32(_mm_srli_epi64(samples, 32), _mm_srli_epi64(gains, 32)), round),
+        17);
+    return _mm_blend_epi16(even, odd, 0xCC);
+}
+
+AVX2_FUNCTION __m256i MulQ15(__m256i samples, __m256i gains) {
+    const __m256i round = _mm256_set1_epi64x(0x4000);
+    const __m256i even =
+        _mm256_srli_epi64(_mm256_add_epi64(_mm256_mul_epi32(samples, gains), round), 15);
+    const __m256i odd = _mm256_slli_epi64(
+        _mm256_add_epi64(
+            _mm256_mul_epi32(_mm256_srli_epi64(samples, 32), _mm256_srli_epi64(gains, 32)), round),
+        17);
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+SSE41_FUNCTION __m128i Load128(const s32* data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+SSE41_FUNCTION void Store128(s32* data, __m128i value) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value);
+}
+
+AVX2_FUNCTION __m256i Load256(const s32* data) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+}
+
+AVX2_FUNCTION void Store256(s32* data, __m256i value) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value);
+}
+#endif
+} // Anonymous namespace
+
+namespace Scalar {
+void ApplyMix(std::span<s32> output, std::span<const s32> input, s32 gain, s32 sample_count) {
+    for (std::size_t i = 0; i < static_cast<std::size_t>(sample_count); i++) {
+        output[i] = WrappingAdd(output[i], MulQ15(input[i], gain));
+    }
+}
+
+void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta,
+               s32 sample_count) {
+    for (std::size_t i = 0; i < static_cast<std::size_t>(sample_count); i++) {
+        output[i] = MulQ15(input[i], gain);
+        gain = WrappingAdd(gain, delta);
+    }
+}
+
+void ApplyGainWithoutDelta(std::span<s32> output, std::span<const s32> input, s32 gain,
+                           s32 sample_count) {
+    for (std::size_t i = 0; i < static_cast<std::size_t>(sample_count); i++) {
+        output[i] = MulQ15(input[i], gain);
+    }
+}
+} // namespace Scalar
+
+#ifdef ARCHITECTURE_x86_64
+namespace SSE41 {
+bool IsSupported() {
+    return Common::GetCPUCaps().sse4_1;
+}
+
+SSE41_FUNCTION void ApplyMix(std::span<s32> output, std::span<const s32> input, s32 gain,
+                             s32 sample_count) {
+    const auto count = static_cast<std::size_t>(sample_count);
+    const __m128i gains = _mm_set1_epi32(gain);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i mixed = MulQ15(Load128(&input[i]), gains);
+        Store128(&output[i], _mm_add_epi32(Load128(&output[i]), mixed));
+    }
+    Scalar::ApplyMix(output.subspan(i), input.subspan(i), gain, static_cast<s32>(count - i));
+}
+
+SSE41_FUNCTION void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain,
+                              s32 delta, s32 sample_count) {
+    const auto count = static_cast<std::size_t>(sample_count);
+    __m128i gains =
+        _mm_add_epi32(_mm_set1_epi32(gain),
+                      _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(delta)));
+    const __m128i step = _mm_set1_epi32(WrappingMul(delta, 4));
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        Store128(&output[i], MulQ15(Load128(&input[i]), gains));
+        gains = _mm_add_epi32(gains, step);
+    }
+    Scalar::ApplyGain(output.subspan(i), input.subspan(i), _mm_cvtsi128_si32(gains), delta,
+                      static_cast<s32>(count - i));
+}
+
+SSE41_FUNCTION void ApplyGainWithoutDelta(std::span<s32> output, std::span<const s32> input,
+                                          s32 gain, s32 sample_count) {
+    const auto count = static_cast<std::size_t>(sample_count);
+    const __m128i gains = _mm_set1_epi32(gain);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        Store128(&output[i], MulQ15(Load128(&input[i]), gains));
+    }
+    Scalar::ApplyGainWithoutDelta(output.subspan(i), input.subspan(i), gain,
+                                  static_cast<s32>(count - i));
+}
+} // namespace SSE41
+
+namespace AVX2 {
+bool IsSupported() {
+    return Common::GetCPUCaps().avx2;
+}
+
+AVX2_FUNCTION void ApplyMix(std::span<s32> output, std::span<const s32> input, s32 gain,
+                            s32 sample_count) {
+    const auto count = static_cast<std::size_t>(sample_count);
+    const __m256i gains = _mm256_set1_epi32(gain);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i mixed = MulQ15(Load256(&input[i]), gains);
+        Store256(&output[i], _mm256_add_epi32(Load256(&output[i]), mixed));
+    }
+    Scalar::ApplyMix(output.subspan(i), input.subspan(i), gain, static_cast<s32>(count - i));
+}
+
+AVX2_FUNCTION void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain,
+                             s32 delta, s32 sample_count) {
+    const auto count = static_cast<std::size_t>(sample_count);
+    __m256i gains =
+        _mm256_add_epi32(_mm256_set1_epi32(gain),
+                         _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                            _mm256_set1_epi32(delta)));
+    const __m256i step = _mm256_set1_epi32(WrappingMul(delta, 8));
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        Store256(&output[i], MulQ15(Load256(&input[i]), gains));
+        gains = _mm256_add_epi32(gains, step);
+    }
+    Scalar::ApplyGain(output.subspan(i), input.subspan(i),
+                      _mm_cvtsi128_si32(_mm256_castsi256_si128(gains)), delta,
+                      static_cast<s32>(count - i));
+}
+
+AVX2_FUNCTION void ApplyGainWithoutDelta(std::span<s32> output, std::span<const s32> input,
+                                         s32 gain, s32 sample_count) {
+    const auto count = static_cast<std::size_t>(sample_count);
+    const __m256i gains = _mm256_set1_epi32(gain);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        Store256(&output[i], MulQ15(Load256(&input[i]), gains));
+    }
+    Scalar::ApplyGainWithoutDelta(output.subspan(i), input.subspan(i), gain,
+                                  static_cast<s32>(count - i));
+}
+} // namespace AVX2
+#endif
+
+namespace {
+enum class Backend {
+    Scalar,
+    SSE41,
+    AVX2,
+};
+
+Backend GetBackend() {
+    static const Backend backend = [] {
+#ifdef ARCHITECTURE_x86_64
+        if (AVX2::IsSupported()) {
+            return Backend::AVX2;
+        }
+        if (SSE41::IsSupported()) {
+            return Backend::SSE41;
+        }
+#endif
+        return Backend::Scalar;
+    }();
+    return backend;
+}
+} // Anonymous namespace
+
+void ApplyMix(std::span<s32> output, std::span<const s32> input, s32 gain, s32 sample_count) {
+    switch (GetBackend()) {
+#ifdef ARCHITECTURE_x86_64
+    case Backend::AVX2:
+        return AVX2::ApplyMix(output, input, gain, sample_count);
+    case Backend::SSE41:
+        return SSE41::ApplyMix(output, input, gain, sample_count);
+#endif
+    default:
+        return Scalar::ApplyMix(output, input, gain, sample_count);
+    }
+}
+
+s32 ApplyMixRamp(std::span<s32> output, std::span<const s32> input, f32 gain, f32 delta,
+                 s32 sample_count) {
+    // Not vectorized: every gain depends on the rounding of the sum before it, so the gains have
+    // to be accumulated one sample at a time to stay exact, and that chain is the bottleneck.
+    s32 x = 0;
+    for (s32 i = 0; i < sample_count; i++) {
+        x = static_cast<s32>(static_cast<f32>(input[i]) * gain);
+        output[i] += x;
+        gain += delta;
+    }
+    return x;
+}
+
+void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta,
+               s32 sample_count) {
+    switch (GetBackend()) {
+#ifdef ARCHITECTURE_x86_64
+    case Backend::AVX2:
+        return AVX2::ApplyGain(output, input, gain, delta, sample_count);
+    case Backend::SSE41:
+        return SSE41::ApplyGain(output, input, gain, delta, sample_count);
+#endif
+    default:
+        return Scalar::ApplyGain(output, input, gain, delta, sample_count);
+    }
+}
+
+void ApplyGainWithoutDelta(std::span<s32> output, std::span<const s32> input, s32 gain,
+                           s32 sample_count) {
+    switch (GetBackend()) {
+#ifdef ARCHITECTURE_x86_64
+    case Backend::AVX2:
+        return AVX2::ApplyGainWithoutDelta(output, input, gain, sample_count);
+    case Backend::SSE41:
+        return SSE41::ApplyGainWithoutDelta(output, input, gain, sample_count);
+#endif
+    default:
+        return Scalar::ApplyGainWithoutDelta(output, input, gain, sample_count);
+    }
+}
+
+s32 ApplyMixDepop(std::span<s32> output, s32 first_sample, s32 delta, s32 sample_count) {
+    const bool positive = first_sample > 0;
+    auto final_sample = std::abs(first_sample);
+    for (s32 i = 0; i < sample_count; i++) {
+        final_sample = static_cast<s32>((static_cast<s64>(final_sample) * delta) >> 15);
+        // Each sample depends on the previous one, but once it decayed to zero it stays there and
+        // the rest of the buffer is left untouched
+        if (final_sample == 0) {
+            break;
+        }
+        if (positive) {
+            output[i] += final_sample;
+        } else {
+            output[i] -= final_sample;
+        }
+    }
+    if (positive) {
+        return final_sample;
+    } else {
+        return -final_sample;
+    }
+}
+
+} // namespace AudioCore
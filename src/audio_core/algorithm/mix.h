@@ -0,0 +1,71 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+// Mixing primitives of the audio renderer. Fixed point gains are in Q15 and the products are
+// rounded to nearest. Vectorized implementations are picked at runtime when the host supports them,
+// and give bit-exact results with the scalar ones.
+
+/// Mixes input multiplied by gain into output.
+void ApplyMix(std::span<s32> output, std::span<const s32> input, s32 gain, s32 sample_count);
+
+/// Mixes input multiplied by a floating point gain increasing by delta every sample into output.
+/// @returns The last sample mixed into output.
+s32 ApplyMixRamp(std::span<s32> output, std::span<const s32> input, f32 gain, f32 delta,
+                 s32 sample_count);
+
+/// Writes input multiplied by a gain increasing by delta every sample to output.
+/// output and input may refer to the same samples.
+void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta,
+               s32 sample_count);
+
+/// Writes input multiplied by gain to output. output and input may refer to the same samples.
+void ApplyGainWithoutDelta(std::span<s32> output, std::span<const s32> input, s32 gain,
+                           s32 sample_count);
+
+/// Mixes a sample decaying by delta every sample into output, to avoid a pop when a voice stops.
+/// @returns The last sample mixed into output.
+s32 ApplyMixDepop(std::span<s32> output, s32 first_sample, s32 delta, s32 sample_count);
+
+/// Portable implementations, also the reference the vectorized ones are tested against.
+namespace Scalar {
+void ApplyMix(std::span<s32> output, std::span<const s32> input, s32 gain, s32 sample_count);
+void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta,
+               s32 sample_count);
+void ApplyGainWithoutDelta(std::span<s32> output, std::span<const s32> input, s32 gain,
+                           s32 sample_count);
+} // namespace Scalar
+
+#ifdef ARCHITECTURE_x86_64
+namespace SSE41 {
+/// Returns whether the host CPU has the instructions required by these implementations
+[[nodiscard]] bool IsSupported();
+
+void ApplyMix(std::span<s32> output, std::span<const s32> input, s32 gain, s32 sample_count);
+void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta,
+               s32 sample_count);
+void ApplyGainWithoutDelta(std::span<s32> output, std::span<const s32> input, s32 gain,
+                           s32 sample_count);
+} // namespace SSE41
+
+namespace AVX2 {
+/// Returns whether the host CPU has the instructions required by these implementations
+[[nodiscard]] bool IsSupported();
+
+void ApplyMix(std::span<s32> output, std::span<const s32> input, s32 gain, s32 sample_count);
+void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta,
+               s32 sample_count);
+void ApplyGainWithoutDelta(std::span<s32> output, std::span<const s32> input, s32 gain,
+                           s32 sample_count);
+} // namespace AVX2
+#endif
+
+} // namespace AudioCore
@@ -3,75 +3,196 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#endif
 
 #include "audio_core/codec.h"
 
 namespace AudioCore::Codec {
 
-std::vector<s16> DecodeADPCM(const u8* const data, std::size_t size, const ADPCM_Coeff& coeff,
-                             ADPCMState& state) {
-    // GC-ADPCM with scale factor and variable coefficients.
-    // Frames are 8 bytes long containing 14 samples each.
-    // Samples are 4 bits (one nibble) long.
-
-    constexpr std::size_t FRAME_LEN = 8;
-    constexpr std::size_t SAMPLES_PER_FRAME = 14;
-    static constexpr std::array<int, 16> SIGNED_NIBBLES{
-        0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
-    };
-
-    const std::size_t sample_count = (size / FRAME_LEN) * SAMPLES_PER_FRAME;
-    const std::size_t ret_size =
-        sample_count % 2 == 0 ? sample_count : sample_count + 1; // Ensure multiple of two.
-    std::vector<s16> ret(ret_size);
-
-    int yn1 = state.yn1, yn2 = state.yn2;
-
-    const std::size_t NUM_FRAMES =
-        (sample_count + (SAMPLES_PER_FRAME - 1)) / SAMPLES_PER_FRAME; // Round up.
-    for (std::size_t framei = 0; framei < NUM_FRAMES; framei++) {
-        const int frame_header = data[framei * FRAME_LEN];
-        const int scale = 1 << (frame_header & 0xF);
-        const int idx = (frame_header >> 4) & 0x7;
-
-        // Coefficients are fixed point with 11 bits fractional part.
-        const int coef1 = coeff[idx * 2 + 0];
-        const int coef2 = coeff[idx * 2 + 1];
-
-        // Decodes an audio sample. One nibble produces one sample.
-        const auto decode_sample = [&](const int nibble) -> s16 {
-            const int xn = nibble * scale;
-            // We first transform everything into 11 bit fixed point, perform the second order
-            // digital filter, then transform back.
-            // 0x400 == 0.5 in 11 bit fixed point.
-            // Filter: y[n] = x[n] + 0.5 + c1 * y[n-1] + c2 * y[n-2]
-            int val = ((xn << 11) + 0x400 + coef1 * yn1 + coef2 * yn2) >> 11;
-            // Clamp to output range.
-            val = std::clamp<s32>(val, -32768, 32767);
-            // Advance output feedback.
-            yn2 = yn1;
-            yn1 = val;
-            return static_cast<s16>(val);
-        };
-
-        std::size_t outputi = framei * SAMPLES_PER_FRAME;
-        std::size_t datai = framei * FRAME_LEN + 1;
-        for (std::size_t i = 0; i < SAMPLES_PER_FRAME && outputi < sample_count; i += 2) {
-            const s16 sample1 = decode_sample(SIGNED_NIBBLES[data[datai] >> 4]);
-            ret[outputi] = sample1;
-            outputi++;
-
-            const s16 sample2 = decode_sample(SIGNED_NIBBLES[data[datai] & 0xF]);
-            ret[outputi] = sample2;
-            outputi++;
-
-            datai++;
+namespace {
+template <typename T>
+s32 ConvertSample(T sample) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<s32>(sample * std::numeric_limits<s16>::max());
+    } else if constexpr (sizeof(T) == 1) {
+        return static_cast<s32>(sample) << 8;
+    } else if constexpr (sizeof(T) == 2) {
+        return sample;
+    } else {
+        return sample >> 16;
+    }
+}
+
+#ifdef ARCHITECTURE_x86_64
+// SSE2 is part of x86-64, so these need no runtime detection. Each of them converts the next four
+// samples of one channel out of mono or stereo input.
+
+__m128i ConvertFour16(__m128i samples, std::size_t channel_count, std::size_t channel) {
+    if (channel_count == 1) {
+        return _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+    }
+    // Every 32 bit lane holds a stereo frame, the left sample in its lower half
+    if (channel == 0) {
+        return _mm_srai_epi32(_mm_slli_epi32(samples, 16), 16);
+    }
+    return _mm_srai_epi32(samples, 16);
+}
+
+__m128i Deinterleave32(const void* input, std::size_t channel_count, std::size_t channel) {
+    const auto* const data = static_cast<const __m128i*>(input);
+    const __m128i first = _mm_loadu_si128(data);
+    if (channel_count == 1) {
+        return first;
+    }
+    const __m128 low = _mm_castsi128_ps(first);
+    const __m128 high = _mm_castsi128_ps(_mm_loadu_si128(data + 1));
+    if (channel == 0) {
+        return _mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+    return _mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+__m128i ConvertFour(const s8* input, std::size_t channel_count, std::size_t channel) {
+    __m128i bytes;
+    if (channel_count == 1) {
+        s32 word;
+        std::memcpy(&word, input, sizeof(word));
+        bytes = _mm_cvtsi32_si128(word);
+    } else {
+        bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input));
+    }
+    // Moving every sample to the upper byte of a 16 bit lane widens it to PCM16
+    return ConvertFour16(_mm_unpacklo_epi8(_mm_setzero_si128(), bytes), channel_count, channel);
+}
+
+__m128i ConvertFour(const s16* input, std::size_t channel_count, std::size_t channel) {
+    __m128i samples;
+    if (channel_count == 1) {
+        samples = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input));
+    } else {
+        samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+    }
+    return ConvertFour16(samples, channel_count, channel);
+}
+
+__m128i ConvertFour(const s32* input, std::size_t channel_count, std::size_t channel) {
+    return _mm_srai_epi32(Deinterleave32(input, channel_count, channel), 16);
+}
+
+__m128i ConvertFour(const f32* input, std::size_t channel_count, std::size_t channel) {
+    const __m128 samples = _mm_castsi128_ps(Deinterleave32(input, channel_count, channel));
+    const __m128 scale = _mm_set1_ps(static_cast<f32>(std::numeric_limits<s16>::max()));
+    return _mm_cvttps_epi32(_mm_mul_ps(samples, scale));
+}
+#endif
+
+// Sign extends the high and low nibble of a byte
+s32 HighNibble(u8 byte) {
+    return static_cast<s8>(byte) >> 4;
+}
+
+s32 LowNibble(u8 byte) {
+    return static_cast<s8>(byte << 4) >> 4;
+}
+} // Anonymous namespace
+
+template <typename T>
+void DecodePCM(std::span<s32> output, std::span<const T> input, std::size_t channel_count,
+               std::size_t channel) {
+    std::size_t i = 0;
+#ifdef ARCHITECTURE_x86_64
+    if (channel_count <= 2) {
+        for (; i + 4 <= output.size(); i += 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output.data() + i),
+                             ConvertFour(input.data() + i * channel_count, channel_count, channel));
         }
     }
+#endif
+    for (; i < output.size(); i++) {
+        output[i] = ConvertSample(input[i * channel_count + channel]);
+    }
+}
+
+template void DecodePCM<s8>(std::span<s32>, std::span<const s8>, std::size_t, std::size_t);
+template void DecodePCM<s16>(std::span<s32>, std::span<const s16>, std::size_t, std::size_t);
+template void DecodePCM<s32>(std::span<s32>, std::span<const s32>, std::size_t, std::size_t);
+template void DecodePCM<f32>(std::span<s32>, std::span<const f32>, std::size_t, std::size_t);
+
+// GC-ADPCM with scale factor and variable coefficients.
+// Frames are 8 bytes long containing 14 samples each.
+// Samples are 4 bits (one nibble) long.
+
+s16 DecodeADPCMSample(s32 nibble, u8 header, const ADPCM_Coeff& coeff, ADPCMState& state) {
+    const s32 scale = 1 << (header & 0xF);
+    const s32 idx = (header >> 4) & 0x7;
+
+    // Coefficients are fixed point with 11 bits fractional part.
+    const s32 coef1 = coeff[idx * 2 + 0];
+    const s32 coef2 = coeff[idx * 2 + 1];
+
+    const s32 xn = nibble * scale;
+    // We first transform everything into 11 bit fixed point, perform the second order
+    // digital filter, then transform back.
+    // 0x400 == 0.5 in 11 bit fixed point.
+    // Filter: y[n] = x[n] + 0.5 + c1 * y[n-1] + c2 * y[n-2]
+    const s32 val = ((xn << 11) + 0x400 + coef1 * state.yn1 + coef2 * state.yn2) >> 11;
+    // Clamp to output range and advance output feedback.
+    state.yn2 = state.yn1;
+    state.yn1 = static_cast<s16>(std::clamp<s32>(val, -32768, 32767));
+    return state.yn1;
+}
 
+template <typename T>
+void DecodeADPCMFrame(T* output, const u8* frame, const ADPCM_Coeff& coeff, ADPCMState& state) {
+    const u8 header = frame[0];
+    const s32 scale = 1 << (header & 0xF);
+    const s32 idx = (header >> 4) & 0x7;
+    const s32 coef1 = coeff[idx * 2 + 0];
+    const s32 coef2 = coeff[idx * 2 + 1];
+
+    // Scale all the nibbles of the frame upfront, leaving only the filter to run sample by sample
+    std::array<s32, ADPCM_SAMPLES_PER_FRAME> input;
+    for (std::size_t i = 0; i < ADPCM_SAMPLES_PER_FRAME / 2; i++) {
+        const u8 byte = frame[i + 1];
+        input[i * 2 + 0] = ((HighNibble(byte) * scale) << 11) + 0x400;
+        input[i * 2 + 1] = ((LowNibble(byte) * scale) << 11) + 0x400;
+    }
+
+    s32 yn1 = state.yn1;
+    s32 yn2 = state.yn2;
+    for (std::size_t i = 0; i < ADPCM_SAMPLES_PER_FRAME; i++) {
+        const s32 val = (input[i] + coef1 * yn1 + coef2 * yn2) >> 11;
+        yn2 = yn1;
+        yn1 = std::clamp<s32>(val, -32768, 32767);
+        output[i] = static_cast<T>(yn1);
+    }
     state.yn1 = static_cast<s16>(yn1);
     state.yn2 = static_cast<s16>(yn2);
+}
+
+template void DecodeADPCMFrame<s16>(s16*, const u8*, const ADPCM_Coeff&, ADPCMState&);
+template void DecodeADPCMFrame<s32>(s32*, const u8*, const ADPCM_Coeff&, ADPCMState&);
 
+std::size_t DecodeADPCM(std::span<s16> output, const u8* const data, std::size_t size,
+                        const ADPCM_Coeff& coeff, ADPCMState& state) {
+    const std::size_t num_frames = size / ADPCM_FRAME_SIZE;
+    for (std::size_t framei = 0; framei < num_frames; framei++) {
+        DecodeADPCMFrame(output.data() + framei * ADPCM_SAMPLES_PER_FRAME,
+                         data + framei * ADPCM_FRAME_SIZE, coeff, state);
+    }
+    return num_frames * ADPCM_SAMPLES_PER_FRAME;
+}
+
+std::vector<s16> DecodeADPCM(const u8* const data, std::size_t size, const ADPCM_Coeff& coeff,
+                             ADPCMState& state) {
+    std::vector<s16> ret((size / ADPCM_FRAME_SIZE) * ADPCM_SAMPLES_PER_FRAME);
+    DecodeADPCM(ret, data, size, coeff, state);
     return ret;
 }
 
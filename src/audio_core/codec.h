@@ -5,6 +5,8 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <span>
 #include <vector>
 
 #include "common/common_types.h"
@@ -31,6 +33,54 @@ struct ADPCMState {
 
 using ADPCM_Coeff = std::array<s16, 16>;
 
+/// Size in bytes of an ADPCM frame, a header byte followed by one nibble per sample
+constexpr std::size_t ADPCM_FRAME_SIZE = 8;
+constexpr std::size_t ADPCM_SAMPLES_PER_FRAME = 14;
+
+/**
+ * Converts one channel of interleaved PCM samples to the 16 bit range used by the renderer.
+ * Mono and stereo input is converted with SIMD when the host supports it.
+ * @param output Buffer receiving the converted samples, output.size() in length
+ * @param input Interleaved samples, at least output.size() * channel_count in length
+ * @param channel_count Number of channels interleaved in input
+ * @param channel Channel to convert
+ */
+template <typename T>
+void DecodePCM(std::span<s32> output, std::span<const T> input, std::size_t channel_count,
+               std::size_t channel);
+
+/**
+ * Decodes a single ADPCM sample.
+ * @param nibble Signed nibble of the sample
+ * @param header Header byte of the frame the sample belongs to
+ * @param coeff ADPCM coefficients
+ * @param state ADPCM state, this is updated with new state
+ * @return Decoded signed PCM16 sample
+ */
+s16 DecodeADPCMSample(s32 nibble, u8 header, const ADPCM_Coeff& coeff, ADPCMState& state);
+
+/**
+ * Decodes a complete ADPCM frame.
+ * @param output Buffer receiving the ADPCM_SAMPLES_PER_FRAME decoded samples
+ * @param frame Pointer to the ADPCM_FRAME_SIZE bytes of the frame
+ * @param coeff ADPCM coefficients
+ * @param state ADPCM state, this is updated with new state
+ */
+template <typename T>
+void DecodeADPCMFrame(T* output, const u8* frame, const ADPCM_Coeff& coeff, ADPCMState& state);
+
+/**
+ * @param output Buffer receiving the decoded samples, at least
+ *               (size / ADPCM_FRAME_SIZE) * ADPCM_SAMPLES_PER_FRAME in length
+ * @param data Pointer to buffer that contains ADPCM data to decode
+ * @param size Size of buffer in bytes
+ * @param coeff ADPCM coefficients
+ * @param state ADPCM state, this is updated with new state
+ * @return Number of samples written to output
+ */
+std::size_t DecodeADPCM(std::span<s16> output, const u8* data, std::size_t size,
+                        const ADPCM_Coeff& coeff, ADPCMState& state);
+
 /**
  * @param data Pointer to buffer that contains ADPCM data to decode
  * @param size Size of buffer in bytes
@@ -4,7 +4,10 @@
 
 #include <cmath>
 #include <numbers>
+#include <thread>
 #include "audio_core/algorithm/interpolate.h"
+#include "audio_core/algorithm/mix.h"
+#include "audio_core/codec.h"
 #include "audio_core/command_generator.h"
 #include "audio_core/effect_context.h"
 #include "audio_core/mix_context.h"
@@ -15,6 +18,12 @@ namespace AudioCore {
 namespace {
 constexpr std::size_t MIX_BUFFER_SIZE = 0x3f00;
 constexpr std::size_t SCALED_MIX_BUFFER_SIZE = MIX_BUFFER_SIZE << 15ULL;
+
+// Voices are processed alongside the emulated CPU and GPU threads, keep the pool small
+u32 NumVoiceWorkers() {
+    return std::clamp(std::thread::hardware_concurrency() / 2, 1U, 4U);
+}
+
 using DelayLineTimes = std::array<f32, AudioCommon::I3DL2REVERB_DELAY_LINE_COUNT>;
 
 constexpr DelayLineTimes FDN_MIN_DELAY_LINE_TIMES{5.0f, 6.0f, 13.0f, 14.0f};
@@ -30,60 +39,6 @@ constexpr std::array<f32, AudioCommon::I3DL2REVERB_TAPS> EARLY_GAIN{
     0.24712f, 0.45945f, 0.45021f, 0.64196f, 0.54879f, 0.92925f, 0.38270f,
     0.72867f, 0.69794f, 0.5464f,  0.24563f, 0.45214f, 0.44042f};
 
-template <std::size_t N>
-void ApplyMix(std::span<s32> output, std::span<const s32> input, s32 gain, s32 sample_count) {
-    for (std::size_t i = 0; i < static_cast<std::size_t>(sample_count); i += N) {
-        for (std::size_t j = 0; j < N; j++) {
-            output[i + j] +=
-                static_cast<s32>((static_cast<s64>(input[i + j]) * gain + 0x4000) >> 15);
-        }
-    }
-}
-
-s32 ApplyMixRamp(std::span<s32> output, std::span<const s32> input, float gain, float delta,
-                 s32 sample_count) {
-    s32 x = 0;
-    for (s32 i = 0; i < sample_count; i++) {
-        x = static_cast<s32>(static_cast<float>(input[i]) * gain);
-        output[i] += x;
-        gain += delta;
-    }
-    return x;
-}
-
-void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta,
-               s32 sample_count) {
-    for (s32 i = 0; i < sample_count; i++) {
-        output[i] = static_cast<s32>((static_cast<s64>(input[i]) * gain + 0x4000) >> 15);
-        gain += delta;
-    }
-}
-
-void ApplyGainWithoutDelta(std::span<s32> output, std::span<const s32> input, s32 gain,
-                           s32 sample_count) {
-    for (s32 i = 0; i < sample_count; i++) {
-        output[i] = static_cast<s32>((static_cast<s64>(input[i]) * gain + 0x4000) >> 15);
-    }
-}
-
-s32 ApplyMixDepop(std::span<s32> output, s32 first_sample, s32 delta, s32 sample_count) {
-    const bool positive = first_sample > 0;
-    auto final_sample = std::abs(first_sample);
-    for (s32 i = 0; i < sample_count; i++) {
-        final_sample = static_cast<s32>((static_cast<s64>(final_sample) * delta) >> 15);
-        if (positive) {
-            output[i] += final_sample;
-        } else {
-            output[i] -= final_sample;
-        }
-    }
-    if (positive) {
-        return final_sample;
-    } else {
-        return -final_sample;
-    }
-}
-
 float Pow10(float x) {
     if (x >= 0.0f) {
         return 1.0f;
@@ -242,14 +197,14 @@ CommandGenerator::CommandGenerator(AudioCommon::AudioRendererParameter& worker_p
       splitter_context(splitter_context_), effect_context(effect_context_), memory(memory_),
       mix_buffer((worker_params.mix_buffer_count + AudioCommon::MAX_CHANNEL_COUNT) *
                  worker_params.sample_count),
-      sample_buffer(MIX_BUFFER_SIZE),
       depop_buffer((worker_params.mix_buffer_count + AudioCommon::MAX_CHANNEL_COUNT) *
-                   worker_params.sample_count) {}
+                   worker_params.sample_count),
+      voice_scratch(MakeVoiceScratch()),
+      voice_workers(NumVoiceWorkers(), "yuzu:AudioVoice", MakeVoiceScratch) {}
 CommandGenerator::~CommandGenerator() = default;
 
 void CommandGenerator::ClearMixBuffers() {
     std::fill(mix_buffer.begin(), mix_buffer.end(), 0);
-    std::fill(sample_buffer.begin(), sample_buffer.end(), 0);
     // std::fill(depop_buffer.begin(), depop_buffer.end(), 0);
 }
 
@@ -258,6 +213,7 @@ void CommandGenerator::GenerateVoiceCommands() {
         LOG_DEBUG(Audio, "(DSP_TRACE) GenerateVoiceCommands");
     }
     // Grab all our voices
+    active_voices.clear();
     const auto voice_count = voice_context.GetVoiceCount();
     for (std::size_t i = 0; i < voice_count; i++) {
         auto& voice_info = voice_context.GetSortedInfo(i);
@@ -267,74 +223,121 @@ void CommandGenerator::GenerateVoiceCommands() {
         }
 
         // Queue our voice
-        GenerateVoiceCommand(voice_info);
+        active_voices.push_back(&voice_info);
+    }
+
+    const std::size_t buffers_size = AudioCommon::MAX_CHANNEL_COUNT * worker_params.sample_count;
+    if (voice_buffers.size() < active_voices.size() * buffers_size) {
+        voice_buffers.resize(active_voices.size() * buffers_size);
+    }
+
+    // Decoding, resampling and filtering a voice only touches the state of that voice, so the
+    // voices are processed in parallel, each into its own buffers
+    if (active_voices.size() == 1) {
+        ProcessVoice(*active_voices[0], voice_scratch, GetVoiceBuffers(0));
+    } else {
+        for (std::size_t i = 0; i < active_voices.size(); i++) {
+            voice_workers.QueueWork([this, i](VoiceScratch* scratch) {
+                ProcessVoice(*active_voices[i], *scratch, GetVoiceBuffers(i));
+            });
+        }
+        voice_workers.WaitForRequests();
+    }
+
+    // Mixing follows the sorted order of the voices, regardless of how the work was scheduled
+    for (std::size_t i = 0; i < active_voices.size(); i++) {
+        GenerateVoiceMixCommands(*active_voices[i], GetVoiceBuffers(i));
     }
+
     // Update our splitters
     splitter_context.UpdateInternalState();
 }
 
-void CommandGenerator::GenerateVoiceCommand(ServerVoiceInfo& voice_info) {
+void CommandGenerator::ProcessVoice(ServerVoiceInfo& voice_info, VoiceScratch& scratch,
+                                    std::span<s32> buffers) {
     auto& in_params = voice_info.GetInParams();
     const auto channel_count = in_params.channel_count;
+    std::fill(buffers.begin(), buffers.end(), 0);
 
     for (s32 channel = 0; channel < channel_count; channel++) {
         const auto resource_id = in_params.voice_channel_resource_id[channel];
         auto& dsp_state = voice_context.GetDspSharedState(resource_id);
-        auto& channel_resource = voice_context.GetChannelResource(resource_id);
+        const auto output =
+            buffers.subspan(channel * worker_params.sample_count, worker_params.sample_count);
+
+        // Depopping writes to shared state, it is done while mixing
+        if (in_params.should_depop) {
+            continue;
+        }
 
         // Decode our samples for our channel
-        GenerateDataSourceCommand(voice_info, dsp_state, channel);
+        GenerateDataSourceCommand(voice_info, dsp_state, channel, scratch, output);
 
-        if (in_params.should_depop) {
-            in_params.last_volume = 0.0f;
-        } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER ||
-                   in_params.mix_id != AudioCommon::NO_MIX) {
+        if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER ||
+            in_params.mix_id != AudioCommon::NO_MIX) {
             // Apply a biquad filter if needed
             GenerateBiquadFilterCommandForVoice(voice_info, dsp_state,
                                                 worker_params.mix_buffer_count, channel);
             // Base voice volume ramping
             GenerateVolumeRampCommand(in_params.last_volume, in_params.volume, channel,
-                                      in_params.node_id);
+                                      in_params.node_id, output);
             in_params.last_volume = in_params.volume;
 
-            if (in_params.mix_id != AudioCommon::NO_MIX) {
-                // If we're using a mix id
-                auto& mix_info = mix_context.GetInfo(in_params.mix_id);
-                const auto& dest_mix_params = mix_info.GetInParams();
+            // Update biquad filter enabled states
+            for (std::size_t i = 0; i < AudioCommon::MAX_BIQUAD_FILTERS; i++) {
+                in_params.was_biquad_filter_enabled[i] = in_params.biquad_filter[i].enabled;
+            }
+        }
+    }
+}
 
-                // Voice Mixing
-                GenerateVoiceMixCommand(
-                    channel_resource.GetCurrentMixVolume(), channel_resource.GetLastMixVolume(),
-                    dsp_state, dest_mix_params.buffer_offset, dest_mix_params.buffer_count,
-                    worker_params.mix_buffer_count + channel, in_params.node_id);
+void CommandGenerator::GenerateVoiceMixCommands(ServerVoiceInfo& voice_info,
+                                                std::span<const s32> buffers) {
+    auto& in_params = voice_info.GetInParams();
+    const auto channel_count = in_params.channel_count;
 
-                // Update last mix volumes
-                channel_resource.UpdateLastMixVolumes();
-            } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER) {
-                s32 base = channel;
-                while (auto* destination_data =
-                           GetDestinationData(in_params.splitter_info_id, base)) {
-                    base += channel_count;
+    for (s32 channel = 0; channel < channel_count; channel++) {
+        const auto resource_id = in_params.voice_channel_resource_id[channel];
+        auto& dsp_state = voice_context.GetDspSharedState(resource_id);
+        auto& channel_resource = voice_context.GetChannelResource(resource_id);
+        const auto input =
+            buffers.subspan(channel * worker_params.sample_count, worker_params.sample_count);
 
-                    if (!destination_data->IsConfigured()) {
-                        continue;
-                    }
-                    if (destination_data->GetMixId() >= static_cast<int>(mix_context.GetCount())) {
-                        continue;
-                    }
+        if (in_params.should_depop) {
+            GenerateVoiceDepopPrepareCommand(voice_info, dsp_state);
+            in_params.last_volume = 0.0f;
+        } else if (in_params.mix_id != AudioCommon::NO_MIX) {
+            // If we're using a mix id
+            auto& mix_info = mix_context.GetInfo(in_params.mix_id);
+            const auto& dest_mix_params = mix_info.GetInParams();
+
+            // Voice Mixing
+            GenerateVoiceMixCommand(
+                channel_resource.GetCurrentMixVolume(), channel_resource.GetLastMixVolume(),
+                dsp_state, dest_mix_params.buffer_offset, dest_mix_params.buffer_count, input,
+                worker_params.mix_buffer_count + channel, in_params.node_id);
 
-                    const auto& mix_info = mix_context.GetInfo(destination_data->GetMixId());
-                    const auto& dest_mix_params = mix_info.GetInParams();
-                    GenerateVoiceMixCommand(
-                        destination_data->CurrentMixVolumes(), destination_data->LastMixVolumes(),
-                        dsp_state, dest_mix_params.buffer_offset, dest_mix_params.buffer_count,
-                        worker_params.mix_buffer_count + channel, in_params.node_id);
-                    destination_data->MarkDirty();
+            // Update last mix volumes
+            channel_resource.UpdateLastMixVolumes();
+        } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER) {
+            s32 base = channel;
+            while (auto* destination_data = GetDestinationData(in_params.splitter_info_id, base)) {
+                base += channel_count;
+
+                if (!destination_data->IsConfigured()) {
+                    continue;
                 }
-            }
-            // Update biquad filter enabled states
-            for (std::size_t i = 0; i < AudioCommon::MAX_BIQUAD_FILTERS; i++) {
-                in_params.was_biquad_filter_enabled[i] = in_params.biquad_filter[i].enabled;
+                if (destination_data->GetMixId() >= static_cast<int>(mix_context.GetCount())) {
+                    continue;
+                }
+
+                const auto& mix_info = mix_context.GetInfo(destination_data->GetMixId());
+                const auto& dest_mix_params = mix_info.GetInParams();
+                GenerateVoiceMixCommand(
+                    destination_data->CurrentMixVolumes(), destination_data->LastMixVolumes(),
+                    dsp_state, dest_mix_params.buffer_offset, dest_mix_params.buffer_count, input,
+                    worker_params.mix_buffer_count + channel, in_params.node_id);
+                destination_data->MarkDirty();
             }
         }
     }
@@ -379,50 +382,49 @@ void CommandGenerator::PostCommand() {
     dumping_frame = false;
 }
 
-void CommandGenerator::GenerateDataSourceCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
-                                                 s32 channel) {
+void CommandGenerator::GenerateVoiceDepopPrepareCommand(ServerVoiceInfo& voice_info,
+                                                        VoiceState& dsp_state) {
     const auto& in_params = voice_info.GetInParams();
-    const auto depop = in_params.should_depop;
-
-    if (depop) {
-        if (in_params.mix_id != AudioCommon::NO_MIX) {
-            auto& mix_info = mix_context.GetInfo(in_params.mix_id);
+    if (in_params.mix_id != AudioCommon::NO_MIX) {
+        auto& mix_info = mix_context.GetInfo(in_params.mix_id);
+        const auto& mix_in = mix_info.GetInParams();
+        GenerateDepopPrepareCommand(dsp_state, mix_in.buffer_count, mix_in.buffer_offset);
+    } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER) {
+        s32 index{};
+        while (const auto* destination = GetDestinationData(in_params.splitter_info_id, index++)) {
+            if (!destination->IsConfigured()) {
+                continue;
+            }
+            auto& mix_info = mix_context.GetInfo(destination->GetMixId());
             const auto& mix_in = mix_info.GetInParams();
             GenerateDepopPrepareCommand(dsp_state, mix_in.buffer_count, mix_in.buffer_offset);
-        } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER) {
-            s32 index{};
-            while (const auto* destination =
-                       GetDestinationData(in_params.splitter_info_id, index++)) {
-                if (!destination->IsConfigured()) {
-                    continue;
-                }
-                auto& mix_info = mix_context.GetInfo(destination->GetMixId());
-                const auto& mix_in = mix_info.GetInParams();
-                GenerateDepopPrepareCommand(dsp_state, mix_in.buffer_count, mix_in.buffer_offset);
-            }
-        }
-    } else {
-        switch (in_params.sample_format) {
-        case SampleFormat::Pcm8:
-        case SampleFormat::Pcm16:
-        case SampleFormat::Pcm32:
-        case SampleFormat::PcmFloat:
-            DecodeFromWaveBuffers(voice_info, GetChannelMixBuffer(channel), dsp_state, channel,
-                                  worker_params.sample_rate, worker_params.sample_count,
-                                  in_params.node_id);
-            break;
-        case SampleFormat::Adpcm:
-            ASSERT(channel == 0 && in_params.channel_count == 1);
-            DecodeFromWaveBuffers(voice_info, GetChannelMixBuffer(0), dsp_state, 0,
-                                  worker_params.sample_rate, worker_params.sample_count,
-                                  in_params.node_id);
-            break;
-        default:
-            UNREACHABLE_MSG("Unimplemented sample format={}", in_params.sample_format);
         }
     }
 }
 
+void CommandGenerator::GenerateDataSourceCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
+                                                 s32 channel, VoiceScratch& scratch,
+                                                 std::span<s32> output) {
+    const auto& in_params = voice_info.GetInParams();
+    switch (in_params.sample_format) {
+    case SampleFormat::Pcm8:
+    case SampleFormat::Pcm16:
+    case SampleFormat::Pcm32:
+    case SampleFormat::PcmFloat:
+        DecodeFromWaveBuffers(voice_info, scratch, output, dsp_state, channel,
+                              worker_params.sample_rate, worker_params.sample_count,
+                              in_params.node_id);
+        break;
+    case SampleFormat::Adpcm:
+        ASSERT(channel == 0 && in_params.channel_count == 1);
+        DecodeFromWaveBuffers(voice_info, scratch, output, dsp_state, 0, worker_params.sample_rate,
+                              worker_params.sample_count, in_params.node_id);
+        break;
+    default:
+        UNREACHABLE_MSG("Unimplemented sample format={}", in_params.sample_format);
+    }
+}
+
 void CommandGenerator::GenerateBiquadFilterCommandForVoice(ServerVoiceInfo& voice_info,
                                                            VoiceState& dsp_state,
                                                            [[maybe_unused]] s32 mix_buffer_count,
@@ -609,7 +611,7 @@ void CommandGenerator::GenerateBiquadFilterEffectCommand(s32 mix_buffer_offset,
         if (params.input[i] != params.output[i]) {
             std::span<const s32> input = GetMixBuffer(mix_buffer_offset + params.input[i]);
             std::span<s32> output = GetMixBuffer(mix_buffer_offset + params.output[i]);
-            ApplyMix<1>(output, input, 32768, worker_params.sample_count);
+            ApplyMix(output, input, 32768, worker_params.sample_count);
         }
     }
 }
@@ -861,7 +863,8 @@ void CommandGenerator::UpdateI3dl2Reverb(I3dl2ReverbParams& info, I3dl2ReverbSta
 }
 
 void CommandGenerator::GenerateVolumeRampCommand(float last_volume, float current_volume,
-                                                 s32 channel, s32 node_id) {
+                                                 s32 channel, s32 node_id,
+                                                 std::span<s32> buffer) {
     const auto last = static_cast<s32>(last_volume * 32768.0f);
     const auto current = static_cast<s32>(current_volume * 32768.0f);
     const auto delta = static_cast<s32>((static_cast<float>(current) - static_cast<float>(last)) /
@@ -875,14 +878,14 @@ void CommandGenerator::GenerateVolumeRampCommand(float last_volume, float curren
                   last_volume, current_volume);
     }
     // Apply generic gain on samples
-    ApplyGain(GetChannelMixBuffer(channel), GetChannelMixBuffer(channel), last, delta,
-              worker_params.sample_count);
+    ApplyGain(buffer, buffer, last, delta, worker_params.sample_count);
 }
 
 void CommandGenerator::GenerateVoiceMixCommand(const MixVolumeBuffer& mix_volumes,
                                                const MixVolumeBuffer& last_mix_volumes,
                                                VoiceState& dsp_state, s32 mix_buffer_offset,
-                                               s32 mix_buffer_count, s32 voice_index, s32 node_id) {
+                                               s32 mix_buffer_count, std::span<const s32> input,
+                                               s32 voice_index, s32 node_id) {
     // Loop all our mix buffers
     for (s32 i = 0; i < mix_buffer_count; i++) {
         if (last_mix_volumes[i] != 0.0f || mix_volumes[i] != 0.0f) {
@@ -898,8 +901,8 @@ void CommandGenerator::GenerateVoiceMixCommand(const MixVolumeBuffer& mix_volume
             }
 
             dsp_state.previous_samples[i] =
-                ApplyMixRamp(GetMixBuffer(mix_buffer_offset + i), GetMixBuffer(voice_index),
-                             last_mix_volumes[i], delta, worker_params.sample_count);
+                ApplyMixRamp(GetMixBuffer(mix_buffer_offset + i), input, last_mix_volumes[i],
+                             delta, worker_params.sample_count);
         } else {
             dsp_state.previous_samples[i] = 0;
         }
@@ -975,14 +978,7 @@ void CommandGenerator::GenerateMixCommand(std::size_t output_offset, std::size_t
     std::span<const s32> input = GetMixBuffer(input_offset);
 
     const s32 gain = static_cast<s32>(volume * 32768.0f);
-    // Mix with loop unrolling
-    if (worker_params.sample_count % 4 == 0) {
-        ApplyMix<4>(output, input, gain, worker_params.sample_count);
-    } else if (worker_params.sample_count % 2 == 0) {
-        ApplyMix<2>(output, input, gain, worker_params.sample_count);
-    } else {
-        ApplyMix<1>(output, input, gain, worker_params.sample_count);
-    }
+    ApplyMix(output, input, gain, worker_params.sample_count);
 }
 
 void CommandGenerator::GenerateFinalMixCommand() {
@@ -1012,10 +1008,21 @@ void CommandGenerator::GenerateFinalMixCommand() {
     }
 }
 
+std::span<const u8> CommandGenerator::ReadWaveData(VoiceScratch& scratch, VAddr address,
+                                                   std::size_t size) {
+    auto& wave_data = scratch.wave_data;
+    if (wave_data.size() < size) {
+        wave_data.resize(size);
+    }
+    memory.ReadBlock(address, wave_data.data(), size);
+    return std::span<const u8>(wave_data.data(), size);
+}
+
 template <typename T>
-s32 CommandGenerator::DecodePcm(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
-                                s32 sample_start_offset, s32 sample_end_offset, s32 sample_count,
-                                s32 channel, std::size_t mix_offset) {
+s32 CommandGenerator::DecodePcm(ServerVoiceInfo& voice_info, VoiceScratch& scratch,
+                                VoiceState& dsp_state, s32 sample_start_offset,
+                                s32 sample_end_offset, s32 sample_count, s32 channel,
+                                std::size_t mix_offset) {
     const auto& in_params = voice_info.GetInParams();
     const auto& wave_buffer = in_params.wave_buffer[dsp_state.wave_buffer_index];
     if (wave_buffer.buffer_address == 0) {
@@ -1032,41 +1039,24 @@ s32 CommandGenerator::DecodePcm(ServerVoiceInfo& voice_info, VoiceState& dsp_sta
         ((dsp_state.offset + sample_start_offset) * in_params.channel_count) * sizeof(T);
     const auto buffer_pos = wave_buffer.buffer_address + start_offset;
     const auto samples_processed = std::min(sample_count, samples_remaining);
-
-    const auto channel_count = in_params.channel_count;
-    std::vector<T> buffer(samples_processed * channel_count);
-    memory.ReadBlock(buffer_pos, buffer.data(), buffer.size() * sizeof(T));
-
-    if constexpr (std::is_floating_point_v<T>) {
-        for (std::size_t i = 0; i < static_cast<std::size_t>(samples_processed); i++) {
-            sample_buffer[mix_offset + i] = static_cast<s32>(buffer[i * channel_count + channel] *
-                                                             std::numeric_limits<s16>::max());
-        }
-    } else if constexpr (sizeof(T) == 1) {
-        for (std::size_t i = 0; i < static_cast<std::size_t>(samples_processed); i++) {
-            sample_buffer[mix_offset + i] =
-                static_cast<s32>(static_cast<f32>(buffer[i * channel_count + channel] /
-                                                  std::numeric_limits<s8>::max()) *
-                                 std::numeric_limits<s16>::max());
-        }
-    } else if constexpr (sizeof(T) == 2) {
-        for (std::size_t i = 0; i < static_cast<std::size_t>(samples_processed); i++) {
-            sample_buffer[mix_offset + i] = buffer[i * channel_count + channel];
-        }
-    } else {
-        for (std::size_t i = 0; i < static_cast<std::size_t>(samples_processed); i++) {
-            sample_buffer[mix_offset + i] =
-                static_cast<s32>(static_cast<f32>(buffer[i * channel_count + channel] /
-                                                  std::numeric_limits<s32>::max()) *
-                                 std::numeric_limits<s16>::max());
-        }
+    if (samples_processed <= 0) {
+        return 0;
     }
 
+    const auto channel_count = static_cast<std::size_t>(in_params.channel_count);
+    const auto size = static_cast<std::size_t>(samples_processed) * channel_count * sizeof(T);
+    const auto buffer = ReadWaveData(scratch, buffer_pos, size);
+    Codec::DecodePCM<T>(
+        std::span<s32>(scratch.sample_buffer).subspan(mix_offset, samples_processed),
+        std::span<const T>(reinterpret_cast<const T*>(buffer.data()), buffer.size() / sizeof(T)),
+        channel_count, static_cast<std::size_t>(channel));
+
     return samples_processed;
 }
 
-s32 CommandGenerator::DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
-                                  s32 sample_start_offset, s32 sample_end_offset, s32 sample_count,
+s32 CommandGenerator::DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceScratch& scratch,
+                                  VoiceState& dsp_state, s32 sample_start_offset,
+                                  s32 sample_end_offset, s32 sample_count,
                                   [[maybe_unused]] s32 channel, std::size_t mix_offset) {
     const auto& in_params = voice_info.GetInParams();
     const auto& wave_buffer = in_params.wave_buffer[dsp_state.wave_buffer_index];
@@ -1084,79 +1074,57 @@ s32 CommandGenerator::DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_s
         0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
     };
 
-    constexpr std::size_t FRAME_LEN = 8;
-    constexpr std::size_t NIBBLES_PER_SAMPLE = 16;
-    constexpr std::size_t SAMPLES_PER_FRAME = 14;
+    constexpr std::size_t FRAME_LEN = Codec::ADPCM_FRAME_SIZE;
+    constexpr std::size_t NIBBLES_PER_FRAME = FRAME_LEN * 2;
+    constexpr std::size_t SAMPLES_PER_FRAME = Codec::ADPCM_SAMPLES_PER_FRAME;
 
-    auto frame_header = dsp_state.context.header;
-    s32 idx = (frame_header >> 4) & 0xf;
-    s32 scale = frame_header & 0xf;
-    s16 yn1 = dsp_state.context.yn1;
-    s16 yn2 = dsp_state.context.yn2;
+    auto frame_header = static_cast<u8>(dsp_state.context.header);
+    Codec::ADPCMState state{dsp_state.context.yn1, dsp_state.context.yn2};
 
     Codec::ADPCM_Coeff coeffs;
     memory.ReadBlock(in_params.additional_params_address, coeffs.data(),
                      sizeof(Codec::ADPCM_Coeff));
 
-    s32 coef1 = coeffs[idx * 2];
-    s32 coef2 = coeffs[idx * 2 + 1];
-
     const auto samples_remaining = (sample_end_offset - sample_start_offset) - dsp_state.offset;
     const auto samples_processed = std::min(sample_count, samples_remaining);
+    if (samples_processed <= 0) {
+        return 0;
+    }
     const auto sample_pos = dsp_state.offset + sample_start_offset;
 
     const auto samples_remaining_in_frame = sample_pos % SAMPLES_PER_FRAME;
-    auto position_in_frame = ((sample_pos / SAMPLES_PER_FRAME) * NIBBLES_PER_SAMPLE) +
+    auto position_in_frame = ((sample_pos / SAMPLES_PER_FRAME) * NIBBLES_PER_FRAME) +
                              samples_remaining_in_frame + (samples_remaining_in_frame != 0 ? 2 : 0);
 
-    const auto decode_sample = [&](const int nibble) -> s16 {
-        const int xn = nibble * (1 << scale);
-        // We first transform everything into 11 bit fixed point, perform the second order
-        // digital filter, then transform back.
-        // 0x400 == 0.5 in 11 bit fixed point.
-        // Filter: y[n] = x[n] + 0.5 + c1 * y[n-1] + c2 * y[n-2]
-        int val = ((xn << 11) + 0x400 + coef1 * yn1 + coef2 * yn2) >> 11;
-        // Clamp to output range.
-        val = std::clamp<s32>(val, -32768, 32767);
-        // Advance output feedback.
-        yn2 = yn1;
-        yn1 = static_cast<s16>(val);
-        return yn1;
-    };
-
+    // Every frame the samples touch, plus one for starting partway through a frame
+    const std::size_t frame_count =
+        (static_cast<std::size_t>(samples_processed) + SAMPLES_PER_FRAME - 1) / SAMPLES_PER_FRAME +
+        1;
+    const auto buffer = ReadWaveData(scratch, wave_buffer.buffer_address + (position_in_frame / 2),
+                                     frame_count * FRAME_LEN);
+    auto& sample_buffer = scratch.sample_buffer;
     std::size_t buffer_offset{};
-    std::vector<u8> buffer(
-        std::max((samples_processed / FRAME_LEN) * SAMPLES_PER_FRAME, FRAME_LEN));
-    memory.ReadBlock(wave_buffer.buffer_address + (position_in_frame / 2), buffer.data(),
-                     buffer.size());
     std::size_t cur_mix_offset = mix_offset;
 
     auto remaining_samples = samples_processed;
     while (remaining_samples > 0) {
-        if (position_in_frame % NIBBLES_PER_SAMPLE == 0) {
-            // Read header
-            frame_header = buffer[buffer_offset++];
-            idx = (frame_header >> 4) & 0xf;
-            scale = frame_header & 0xf;
-            coef1 = coeffs[idx * 2];
-            coef2 = coeffs[idx * 2 + 1];
-            position_in_frame += 2;
+        if (position_in_frame % NIBBLES_PER_FRAME == 0) {
+            frame_header = buffer[buffer_offset];
 
             // Decode entire frame
             if (remaining_samples >= static_cast<int>(SAMPLES_PER_FRAME)) {
-                for (std::size_t i = 0; i < SAMPLES_PER_FRAME / 2; i++) {
-                    // Sample 1
-                    const s32 s0 = SIGNED_NIBBLES[buffer[buffer_offset] >> 4];
-                    const s32 s1 = SIGNED_NIBBLES[buffer[buffer_offset++] & 0xf];
-                    const s16 sample_1 = decode_sample(s0);
-                    const s16 sample_2 = decode_sample(s1);
-                    sample_buffer[cur_mix_offset++] = sample_1;
-                    sample_buffer[cur_mix_offset++] = sample_2;
-                }
+                Codec::DecodeADPCMFrame(sample_buffer.data() + cur_mix_offset,
+                                        buffer.data() + buffer_offset, coeffs, state);
+                buffer_offset += FRAME_LEN;
+                cur_mix_offset += SAMPLES_PER_FRAME;
                 remaining_samples -= static_cast<int>(SAMPLES_PER_FRAME);
-                position_in_frame += SAMPLES_PER_FRAME;
+                position_in_frame += NIBBLES_PER_FRAME;
                 continue;
             }
+
+            // Skip the header
+            buffer_offset++;
+            position_in_frame += 2;
         }
         // Decode mid frame
         s32 current_nibble = buffer[buffer_offset];
@@ -1166,14 +1134,14 @@ s32 CommandGenerator::DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_s
         } else {
             current_nibble >>= 4;
         }
-        const s16 sample = decode_sample(SIGNED_NIBBLES[current_nibble]);
-        sample_buffer[cur_mix_offset++] = sample;
+        sample_buffer[cur_mix_offset++] =
+            Codec::DecodeADPCMSample(SIGNED_NIBBLES[current_nibble], frame_header, coeffs, state);
         remaining_samples--;
     }
 
     dsp_state.context.header = frame_header;
-    dsp_state.context.yn1 = yn1;
-    dsp_state.context.yn2 = yn2;
+    dsp_state.context.yn1 = state.yn1;
+    dsp_state.context.yn2 = state.yn2;
 
     return samples_processed;
 }
@@ -1196,6 +1164,18 @@ std::size_t CommandGenerator::GetTotalMixBufferCount() const {
     return worker_params.mix_buffer_count + AudioCommon::MAX_CHANNEL_COUNT;
 }
 
+std::span<s32> CommandGenerator::GetVoiceBuffers(std::size_t voice) {
+    const std::size_t size = AudioCommon::MAX_CHANNEL_COUNT * worker_params.sample_count;
+    return std::span<s32>(voice_buffers).subspan(voice * size, size);
+}
+
+CommandGenerator::VoiceScratch CommandGenerator::MakeVoiceScratch() {
+    return VoiceScratch{
+        .sample_buffer = std::vector<s32>(MIX_BUFFER_SIZE),
+        .wave_data = {},
+    };
+}
+
 std::span<s32> CommandGenerator::GetChannelMixBuffer(s32 channel) {
     return GetMixBuffer(worker_params.mix_buffer_count + channel);
 }
@@ -1204,11 +1184,12 @@ std::span<const s32> CommandGenerator::GetChannelMixBuffer(s32 channel) const {
     return GetMixBuffer(worker_params.mix_buffer_count + channel);
 }
 
-void CommandGenerator::DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, std::span<s32> output,
-                                             VoiceState& dsp_state, s32 channel,
-                                             s32 target_sample_rate, s32 sample_count,
+void CommandGenerator::DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, VoiceScratch& scratch,
+                                             std::span<s32> output, VoiceState& dsp_state,
+                                             s32 channel, s32 target_sample_rate, s32 sample_count,
                                              s32 node_id) {
     const auto& in_params = voice_info.GetInParams();
+    auto& sample_buffer = scratch.sample_buffer;
     if (dumping_frame) {
         LOG_DEBUG(Audio,
                   "(DSP_TRACE) DecodeFromWaveBuffers, node_id={}, channel={}, "
@@ -1277,28 +1258,33 @@ void CommandGenerator::DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, std::s
             switch (in_params.sample_format) {
             case SampleFormat::Pcm8:
                 samples_decoded =
-                    DecodePcm<s8>(voice_info, dsp_state, samples_offset_start, samples_offset_end,
-                                  samples_to_read - samples_read, channel, temp_mix_offset);
+                    DecodePcm<s8>(voice_info, scratch, dsp_state, samples_offset_start,
+                                  samples_offset_end, samples_to_read - samples_read, channel,
+                                  temp_mix_offset);
                 break;
             case SampleFormat::Pcm16:
                 samples_decoded =
-                    DecodePcm<s16>(voice_info, dsp_state, samples_offset_start, samples_offset_end,
-                                   samples_to_read - samples_read, channel, temp_mix_offset);
+                    DecodePcm<s16>(voice_info, scratch, dsp_state, samples_offset_start,
+                                   samples_offset_end, samples_to_read - samples_read, channel,
+                                   temp_mix_offset);
                 break;
             case SampleFormat::Pcm32:
                 samples_decoded =
-                    DecodePcm<s32>(voice_info, dsp_state, samples_offset_start, samples_offset_end,
-                                   samples_to_read - samples_read, channel, temp_mix_offset);
+                    DecodePcm<s32>(voice_info, scratch, dsp_state, samples_offset_start,
+                                   samples_offset_end, samples_to_read - samples_read, channel,
+                                   temp_mix_offset);
                 break;
             case SampleFormat::PcmFloat:
                 samples_decoded =
-                    DecodePcm<f32>(voice_info, dsp_state, samples_offset_start, samples_offset_end,
-                                   samples_to_read - samples_read, channel, temp_mix_offset);
+                    DecodePcm<f32>(voice_info, scratch, dsp_state, samples_offset_start,
+                                   samples_offset_end, samples_to_read - samples_read, channel,
+                                   temp_mix_offset);
                 break;
             case SampleFormat::Adpcm:
                 samples_decoded =
-                    DecodeAdpcm(voice_info, dsp_state, samples_offset_start, samples_offset_end,
-                                samples_to_read - samples_read, channel, temp_mix_offset);
+                    DecodeAdpcm(voice_info, scratch, dsp_state, samples_offset_start,
+                                samples_offset_end, samples_to_read - samples_read, channel,
+                                temp_mix_offset);
                 break;
             default:
                 UNREACHABLE_MSG("Unimplemented sample format={}", in_params.sample_format);
@@ -1343,8 +1329,8 @@ void CommandGenerator::DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, std::s
             std::fill(sample_buffer.begin() + temp_mix_offset,
                       sample_buffer.begin() + temp_mix_offset + (samples_to_read - samples_read),
                       0);
-            AudioCore::Resample(output.data() + samples_output, sample_buffer.data(), resample_rate,
-                                dsp_state.fraction, samples_to_output);
+            AudioCore::Resample(output.subspan(samples_output, samples_to_output), sample_buffer,
+                                resample_rate, dsp_state.fraction);
             // Resample
             for (std::size_t i = 0; i < AudioCommon::MAX_SAMPLE_HISTORY; i++) {
                 dsp_state.sample_history[i] = sample_buffer[samples_to_read + i];
@@ -6,9 +6,11 @@
 
 #include <array>
 #include <span>
+#include <vector>
 #include "audio_core/common.h"
 #include "audio_core/voice_context.h"
 #include "common/common_types.h"
+#include "common/thread_worker.h"
 
 namespace Core::Memory {
 class Memory;
@@ -36,7 +38,6 @@ public:
 
     void ClearMixBuffers();
     void GenerateVoiceCommands();
-    void GenerateVoiceCommand(ServerVoiceInfo& voice_info);
     void GenerateSubMixCommands();
     void GenerateFinalMixCommands();
     void PreCommand();
@@ -51,15 +52,33 @@ public:
     [[nodiscard]] std::size_t GetTotalMixBufferCount() const;
 
 private:
-    void GenerateDataSourceCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32 channel);
+    /// Scratch memory for decoding a voice, each thread processing voices has its own.
+    struct VoiceScratch {
+        std::vector<s32> sample_buffer;
+        std::vector<u8> wave_data;
+    };
+
+    [[nodiscard]] static VoiceScratch MakeVoiceScratch();
+
+    /// Decodes, resamples and filters every channel of a voice into buffers. This only touches the
+    /// state of the voice, so voices may be processed concurrently.
+    void ProcessVoice(ServerVoiceInfo& voice_info, VoiceScratch& scratch, std::span<s32> buffers);
+    /// Mixes the channels of a processed voice into its destination mix buffers.
+    void GenerateVoiceMixCommands(ServerVoiceInfo& voice_info, std::span<const s32> buffers);
+    /// Returns the buffers of all the channels of the voice at index in active_voices.
+    [[nodiscard]] std::span<s32> GetVoiceBuffers(std::size_t voice);
+
+    void GenerateVoiceDepopPrepareCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state);
+    void GenerateDataSourceCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32 channel,
+                                   VoiceScratch& scratch, std::span<s32> output);
     void GenerateBiquadFilterCommandForVoice(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
                                              s32 mix_buffer_count, s32 channel);
     void GenerateVolumeRampCommand(float last_volume, float current_volume, s32 channel,
-                                   s32 node_id);
+                                   s32 node_id, std::span<s32> buffer);
     void GenerateVoiceMixCommand(const MixVolumeBuffer& mix_volumes,
                                  const MixVolumeBuffer& last_mix_volumes, VoiceState& dsp_state,
-                                 s32 mix_buffer_offset, s32 mix_buffer_count, s32 voice_index,
-                                 s32 node_id);
+                                 s32 mix_buffer_offset, s32 mix_buffer_count,
+                                 std::span<const s32> input, s32 voice_index, s32 node_id);
     void GenerateSubMixCommand(ServerMixInfo& mix_info);
     void GenerateMixCommands(ServerMixInfo& mix_info);
     void GenerateMixCommand(std::size_t output_offset, std::size_t input_offset, float volume,
@@ -88,14 +107,18 @@ private:
                                std::vector<u8>& work_buffer);
     void UpdateI3dl2Reverb(I3dl2ReverbParams& info, I3dl2ReverbState& state, bool should_clear);
     // DSP Code
+    /// Reads wave data from guest memory into a scratch buffer reused across calls.
+    std::span<const u8> ReadWaveData(VoiceScratch& scratch, VAddr address, std::size_t size);
     template <typename T>
-    s32 DecodePcm(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32 sample_start_offset,
-                  s32 sample_end_offset, s32 sample_count, s32 channel, std::size_t mix_offset);
-    s32 DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32 sample_start_offset,
-                    s32 sample_end_offset, s32 sample_count, s32 channel, std::size_t mix_offset);
-    void DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, std::span<s32> output,
-                               VoiceState& dsp_state, s32 channel, s32 target_sample_rate,
-                               s32 sample_count, s32 node_id);
+    s32 DecodePcm(ServerVoiceInfo& voice_info, VoiceScratch& scratch, VoiceState& dsp_state,
+                  s32 sample_start_offset, s32 sample_end_offset, s32 sample_count, s32 channel,
+                  std::size_t mix_offset);
+    s32 DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceScratch& scratch, VoiceState& dsp_state,
+                    s32 sample_start_offset, s32 sample_end_offset, s32 sample_count, s32 channel,
+                    std::size_t mix_offset);
+    void DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, VoiceScratch& scratch,
+                               std::span<s32> output, VoiceState& dsp_state, s32 channel,
+                               s32 target_sample_rate, s32 sample_count, s32 node_id);
 
     AudioCommon::AudioRendererParameter& worker_params;
     VoiceContext& voice_context;
@@ -104,8 +127,14 @@ private:
     EffectContext& effect_context;
     Core::Memory::Memory& memory;
     std::vector<s32> mix_buffer{};
-    std::vector<s32> sample_buffer{};
     std::vector<s32> depop_buffer{};
     bool dumping_frame{false};
+    /// Voices to process this frame, in their sorted order
+    std::vector<ServerVoiceInfo*> active_voices;
+    /// MAX_CHANNEL_COUNT buffers of sample_count samples for each active voice
+    std::vector<s32> voice_buffers;
+    /// Used when a single voice is active, which is not worth dispatching to the workers
+    VoiceScratch voice_scratch;
+    Common::StatefulThreadWorker<VoiceScratch> voice_workers;
 };
 } // namespace AudioCore
@@ -6,11 +6,11 @@
 #include <atomic>
 #include <cstring>
 #include "audio_core/cubeb_sink.h"
+#include "audio_core/sink_ring_buffer.h"
 #include "audio_core/stream.h"
 #include "audio_core/time_stretch.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
-#include "common/ring_buffer.h"
 #include "common/settings.h"
 
 #ifdef _WIN32
@@ -23,8 +23,8 @@ class CubebSinkStream final : public SinkStream {
 public:
     CubebSinkStream(cubeb* ctx_, u32 sample_rate, u32 num_channels_, cubeb_devid output_device,
                     const std::string& name)
-        : ctx{ctx_}, num_channels{std::min(num_channels_, 6u)}, time_stretch{sample_rate,
-                                                                             num_channels} {
+        : ctx{ctx_}, num_channels{std::min(num_channels_, 6u)}, queue{num_channels},
+          time_stretch{sample_rate, num_channels} {
 
         cubeb_stream_params params{};
         params.rate = sample_rate;
@@ -75,35 +75,7 @@ public:
     }
 
     void EnqueueSamples(u32 source_num_channels, const std::vector<s16>& samples) override {
-        if (source_num_channels > num_channels) {
-            // Downsample 6 channels to 2
-            ASSERT_MSG(source_num_channels == 6, "Channel count must be 6");
-
-            std::vector<s16> buf;
-            buf.reserve(samples.size() * num_channels / source_num_channels);
-            for (std::size_t i = 0; i < samples.size(); i += source_num_channels) {
-                // Downmixing implementation taken from the ATSC standard
-                const s16 left{samples[i + 0]};
-                const s16 right{samples[i + 1]};
-                const s16 center{samples[i + 2]};
-                const s16 surround_left{samples[i + 4]};
-                const s16 surround_right{samples[i + 5]};
-                // Not used in the ATSC reference implementation
-                [[maybe_unused]] const s16 low_frequency_effects{samples[i + 3]};
-
-                constexpr s32 clev{707}; // center mixing level coefficient
-                constexpr s32 slev{707}; // surround mixing level coefficient
-
-                buf.push_back(static_cast<s16>(left + (clev * center / 1000) +
-                                               (slev * surround_left / 1000)));
-                buf.push_back(static_cast<s16>(right + (clev * center / 1000) +
-                                               (slev * surround_right / 1000)));
-            }
-            queue.Push(buf);
-            return;
-        }
-
-        queue.Push(samples);
+        queue.Push(source_num_channels, samples);
     }
 
     std::size_t SamplesInQueue(u32 channel_count) const override {
@@ -128,8 +100,7 @@ private:
     cubeb_stream* stream_backend{};
     u32 num_channels{};
 
-    Common::RingBuffer<s16, 0x10000> queue;
-    std::array<s16, 2> last_frame{};
+    SinkRingBuffer queue;
     std::atomic<bool> should_flush{};
     TimeStretcher time_stretch;
 
@@ -197,15 +168,14 @@ long CubebSinkStream::DataCallback([[maybe_unused]] cubeb_stream* stream, void*
                                    [[maybe_unused]] const void* input_buffer, void* output_buffer,
                                    long num_frames) {
     auto* impl = static_cast<CubebSinkStream*>(user_data);
-    auto* buffer = static_cast<u8*>(output_buffer);
+    auto* buffer = static_cast<s16*>(output_buffer);
 
     if (!impl) {
         return {};
     }
 
     const std::size_t num_channels = impl->GetNumChannels();
-    const std::size_t samples_to_write = num_channels * num_frames;
-    std::size_t samples_written;
+    const std::size_t samples_to_write = num_channels * static_cast<std::size_t>(num_frames);
 
     /*
     if (Settings::values.enable_audio_stretching.GetValue()) {
@@ -223,17 +193,7 @@ long CubebSinkStream::DataCallback([[maybe_unused]] cubeb_stream* stream, void*
     } else {
         samples_written = impl->queue.Pop(buffer, samples_to_write);
     }*/
-    samples_written = impl->queue.Pop(buffer, samples_to_write);
-
-    if (samples_written >= num_channels) {
-        std::memcpy(&impl->last_frame[0], buffer + (samples_written - num_channels) * sizeof(s16),
-                    num_channels * sizeof(s16));
-    }
-
-    // Fill the rest of the frames with last_frame
-    for (std::size_t i = samples_written; i < samples_to_write; i += num_channels) {
-        std::memcpy(buffer + i * sizeof(s16), &impl->last_frame[0], num_channels * sizeof(s16));
-    }
+    impl->queue.Pop(std::span<s16>(buffer, samples_to_write));
 
     return num_frames;
 }
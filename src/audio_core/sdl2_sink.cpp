@@ -6,6 +6,7 @@
 #include <atomic>
 #include <cstring>
 #include "audio_core/sdl2_sink.h"
+#include "audio_core/sink_ring_buffer.h"
 #include "audio_core/stream.h"
 #include "audio_core/time_stretch.h"
 #include "common/assert.h"
@@ -27,14 +28,16 @@ namespace AudioCore {
 class SDLSinkStream final : public SinkStream {
 public:
     SDLSinkStream(u32 sample_rate, u32 num_channels_, const std::string& output_device)
-        : num_channels{std::min(num_channels_, 6u)}, time_stretch{sample_rate, num_channels} {
+        : num_channels{std::min(num_channels_, 6u)}, queue{num_channels},
+          time_stretch{sample_rate, num_channels} {
 
         SDL_AudioSpec spec;
         spec.freq = sample_rate;
         spec.channels = static_cast<u8>(num_channels);
         spec.format = AUDIO_S16SYS;
         spec.samples = 4096;
-        spec.callback = nullptr;
+        spec.callback = &SDLSinkStream::DataCallback;
+        spec.userdata = this;
 
         SDL_AudioSpec obtained;
         if (output_device.empty()) {
@@ -60,48 +63,14 @@ public:
     }
 
     void EnqueueSamples(u32 source_num_channels, const std::vector<s16>& samples) override {
-        if (source_num_channels > num_channels) {
-            // Downsample 6 channels to 2
-            ASSERT_MSG(source_num_channels == 6, "Channel count must be 6");
-
-            std::vector<s16> buf;
-            buf.reserve(samples.size() * num_channels / source_num_channels);
-            for (std::size_t i = 0; i < samples.size(); i += source_num_channels) {
-                // Downmixing implementation taken from the ATSC standard
-                const s16 left{samples[i + 0]};
-                const s16 right{samples[i + 1]};
-                const s16 center{samples[i + 2]};
-                const s16 surround_left{samples[i + 4]};
-                const s16 surround_right{samples[i + 5]};
-                // Not used in the ATSC reference implementation
-                [[maybe_unused]] const s16 low_frequency_effects{samples[i + 3]};
-
-                constexpr s32 clev{707}; // center mixing level coefficient
-                constexpr s32 slev{707}; // surround mixing level coefficient
-
-                buf.push_back(static_cast<s16>(left + (clev * center / 1000) +
-                                               (slev * surround_left / 1000)));
-                buf.push_back(static_cast<s16>(right + (clev * center / 1000) +
-                                               (slev * surround_right / 1000)));
-            }
-            int ret = SDL_QueueAudio(dev, static_cast<const void*>(buf.data()),
-                                     static_cast<u32>(buf.size() * sizeof(s16)));
-            if (ret < 0)
-                LOG_WARNING(Audio_Sink, "Could not queue audio buffer: {}", SDL_GetError());
-            return;
-        }
-
-        int ret = SDL_QueueAudio(dev, static_cast<const void*>(samples.data()),
-                                 static_cast<u32>(samples.size() * sizeof(s16)));
-        if (ret < 0)
-            LOG_WARNING(Audio_Sink, "Could not queue audio buffer: {}", SDL_GetError());
+        queue.Push(source_num_channels, samples);
     }
 
     std::size_t SamplesInQueue(u32 channel_count) const override {
         if (dev == 0)
             return 0;
 
-        return SDL_GetQueuedAudioSize(dev) / (channel_count * sizeof(s16));
+        return queue.Size() / channel_count;
     }
 
     void Flush() override {
@@ -115,10 +84,20 @@ public:
 private:
     SDL_AudioDeviceID dev = 0;
     u32 num_channels{};
+    SinkRingBuffer queue;
     std::atomic<bool> should_flush{};
     TimeStretcher time_stretch;
+
+    static void DataCallback(void* user_data, Uint8* stream, int len);
 };
 
+void SDLSinkStream::DataCallback(void* user_data, Uint8* stream, int len) {
+    auto* impl = static_cast<SDLSinkStream*>(user_data);
+    // The device was opened without allowing format changes, so SDL always asks for PCM16 frames
+    impl->queue.Pop(std::span<s16>(reinterpret_cast<s16*>(stream),
+                                   static_cast<std::size_t>(len) / sizeof(s16)));
+}
+
 SDLSink::SDLSink(std::string_view target_device_name) {
     if (!SDL_WasInit(SDL_INIT_AUDIO)) {
         if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
@@ -0,0 +1,79 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+
+#include "audio_core/sink_ring_buffer.h"
+#include "common/assert.h"
+
+namespace AudioCore {
+
+namespace {
+// Frames downmixed at a time on the stack before being queued
+constexpr std::size_t DOWNMIX_CHUNK_FRAMES = 256;
+} // Anonymous namespace
+
+SinkRingBuffer::SinkRingBuffer(u32 num_channels_) : num_channels{num_channels_} {
+    ASSERT(num_channels > 0 && num_channels <= last_frame.size());
+}
+
+void SinkRingBuffer::Push(u32 source_num_channels, std::span<const s16> samples) {
+    // Only queue whole frames, so that the channels of the output never get out of step
+    const std::size_t free_frames = (queue.Capacity() - queue.Size()) / num_channels;
+
+    if (source_num_channels <= num_channels) {
+        queue.Push(samples.data(), std::min(samples.size(), free_frames * num_channels));
+        return;
+    }
+
+    // Downsample 6 channels to 2
+    ASSERT_MSG(source_num_channels == 6 && num_channels == 2, "Channel count must be 6");
+
+    const std::size_t num_frames = std::min(samples.size() / source_num_channels, free_frames);
+    std::array<s16, DOWNMIX_CHUNK_FRAMES * 2> buffer;
+    for (std::size_t frame = 0; frame < num_frames; frame += DOWNMIX_CHUNK_FRAMES) {
+        const std::size_t chunk_frames = std::min(DOWNMIX_CHUNK_FRAMES, num_frames - frame);
+        for (std::size_t i = 0; i < chunk_frames; i++) {
+            const s16* const in = samples.data() + (frame + i) * source_num_channels;
+            // Downmixing implementation taken from the ATSC standard
+            const s16 left{in[0]};
+            const s16 right{in[1]};
+            const s16 center{in[2]};
+            const s16 surround_left{in[4]};
+            const s16 surround_right{in[5]};
+            // Not used in the ATSC reference implementation
+            [[maybe_unused]] const s16 low_frequency_effects{in[3]};
+
+            constexpr s32 clev{707}; // center mixing level coefficient
+            constexpr s32 slev{707}; // surround mixing level coefficient
+
+            buffer[i * 2 + 0] = static_cast<s16>(left + (clev * center / 1000) +
+                                                 (slev * surround_left / 1000));
+            buffer[i * 2 + 1] = static_cast<s16>(right + (clev * center / 1000) +
+                                                 (slev * surround_right / 1000));
+        }
+        queue.Push(buffer.data(), chunk_frames * 2);
+    }
+}
+
+void SinkRingBuffer::Pop(std::span<s16> output) {
+    const std::size_t samples_written = queue.Pop(output.data(), output.size());
+
+    if (samples_written >= num_channels) {
+        std::memcpy(last_frame.data(), output.data() + samples_written - num_channels,
+                    num_channels * sizeof(s16));
+    }
+
+    // Fill the rest of the frames with last_frame
+    for (std::size_t i = samples_written; i + num_channels <= output.size(); i += num_channels) {
+        std::memcpy(output.data() + i, last_frame.data(), num_channels * sizeof(s16));
+    }
+}
+
+std::size_t SinkRingBuffer::Size() const {
+    return queue.Size();
+}
+
+} // namespace AudioCore
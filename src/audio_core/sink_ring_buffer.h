@@ -0,0 +1,50 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include "common/common_types.h"
+#include "common/ring_buffer.h"
+
+namespace AudioCore {
+
+/**
+ * Queue of interleaved PCM16 samples between a sink stream and the host audio callback. It is
+ * lock-free for a single producer and a single consumer, and never allocates once constructed, so
+ * it is safe to use from a real-time audio thread.
+ */
+class SinkRingBuffer {
+public:
+    explicit SinkRingBuffer(u32 num_channels_);
+
+    /**
+     * Queues samples, downmixing them when they have more channels than the output. Frames that do
+     * not fit in the queue are dropped.
+     * @param source_num_channels Number of channels interleaved in samples.
+     * @param samples Samples in interleaved PCM16 format.
+     */
+    void Push(u32 source_num_channels, std::span<const s16> samples);
+
+    /**
+     * Fills output with queued frames. When the queue runs dry, the rest of output repeats the last
+     * frame played to avoid a pop. Only to be called from the consumer thread.
+     * @param output Buffer with space for a whole number of frames.
+     */
+    void Pop(std::span<s16> output);
+
+    /// Returns the number of queued samples
+    [[nodiscard]] std::size_t Size() const;
+
+private:
+    u32 num_channels;
+    Common::RingBuffer<s16, 0x10000> queue;
+    /// Owned by the consumer
+    std::array<s16, 6> last_frame{};
+};
+
+} // namespace AudioCore
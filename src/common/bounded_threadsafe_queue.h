@@ -0,0 +1,134 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Common {
+
+/// Fixed capacity, single reader, single writer queue.
+/// Unlike SPSCQueue, no memory is allocated when elements are pushed. Elements are constructed in
+/// place by the writer and only become visible to the reader once they are published, which allows
+/// the writer to publish a batch of elements with a single atomic store.
+/// Both sides block through C++20 atomic waits when the queue is empty or full.
+/// @tparam T         Element type, must be default constructible and move assignable
+/// @tparam capacity  Number of slots in the queue
+template <typename T, std::size_t capacity>
+class BoundedSPSCQueue {
+    static_assert(std::is_default_constructible_v<T>);
+    static_assert(std::is_move_assignable_v<T>);
+    static_assert(capacity < std::numeric_limits<std::size_t>::max() / 2);
+    static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::atomic_size_t::is_always_lock_free);
+
+public:
+    /// Stages an element without making it visible to the reader.
+    /// Blocks while the queue is full.
+    template <typename Arg>
+    void Stage(Arg&& t) {
+        const std::size_t write_index = m_staged_index;
+        std::size_t read_index = m_read_index.load(std::memory_order_acquire);
+        while (write_index - read_index == capacity) {
+            // Make sure the reader can make progress before sleeping on a full queue
+            Publish();
+            m_read_index.wait(read_index, std::memory_order_acquire);
+            read_index = m_read_index.load(std::memory_order_acquire);
+        }
+        m_data[write_index % capacity] = std::forward<Arg>(t);
+        m_staged_index = write_index + 1;
+    }
+
+    /// Makes all staged elements visible to the reader
+    void Publish() {
+        if (m_write_index.load(std::memory_order_relaxed) == m_staged_index) {
+            return;
+        }
+        m_write_index.store(m_staged_index, std::memory_order_release);
+        m_write_index.notify_one();
+    }
+
+    /// Pushes and publishes a single element
+    template <typename Arg>
+    void Push(Arg&& t) {
+        Stage(std::forward<Arg>(t));
+        Publish();
+    }
+
+    /// Pops an element if one has been published
+    /// @returns True when an element has been popped
+    bool TryPop(T& t) {
+        const std::size_t read_index = m_read_index.load(std::memory_order_relaxed);
+        if (read_index == m_cached_write_index) {
+            m_cached_write_index = m_write_index.load(std::memory_order_acquire);
+            if (read_index == m_cached_write_index) {
+                return false;
+            }
+        }
+        t = std::move(m_data[read_index % capacity]);
+        m_read_index.store(read_index + 1, std::memory_order_release);
+        m_read_index.notify_one();
+        return true;
+    }
+
+    /// Blocks until at least one element has been published
+    void Wait() {
+        const std::size_t read_index = m_read_index.load(std::memory_order_relaxed);
+        if (read_index != m_cached_write_index) {
+            return;
+        }
+        m_write_index.wait(read_index, std::memory_order_acquire);
+        m_cached_write_index = m_write_index.load(std::memory_order_acquire);
+    }
+
+    /// Blocks until an element has been published and pops it
+    T PopWait() {
+        T t;
+        while (!TryPop(t)) {
+            Wait();
+        }
+        return t;
+    }
+
+    /// @returns Number of published elements that have not been popped yet
+    [[nodiscard]] std::size_t Size() const {
+        return m_write_index.load(std::memory_order_acquire) -
+               m_read_index.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool Empty() const {
+        return Size() == 0;
+    }
+
+    /// @returns Maximum number of elements in the queue
+    [[nodiscard]] constexpr std::size_t Capacity() const {
+        return capacity;
+    }
+
+private:
+    // Reader and writer owned indices live on separate cache lines to avoid false-sharing.
+    // TODO: Remove this ifdef whenever clang and GCC support
+    //       std::hardware_destructive_interference_size.
+#if defined(_MSC_VER) && _MSC_VER >= 1911
+    alignas(std::hardware_destructive_interference_size) std::atomic_size_t m_read_index{0};
+    std::size_t m_cached_write_index{0}; ///< Reader-local copy of the write index
+    alignas(std::hardware_destructive_interference_size) std::atomic_size_t m_write_index{0};
+    std::size_t m_staged_index{0}; ///< Writer-local index including unpublished elements
+#else
+    alignas(128) std::atomic_size_t m_read_index{0};
+    std::size_t m_cached_write_index{0}; ///< Reader-local copy of the write index
+    alignas(128) std::atomic_size_t m_write_index{0};
+    std::size_t m_staged_index{0}; ///< Writer-local index including unpublished elements
+#endif
+
+    std::array<T, capacity> m_data;
+};
+
+} // namespace Common
@@ -0,0 +1,23 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <thread>
+
+#include "common/parallel_for.h"
+
+namespace Common {
+
+std::size_t NumParallelForWorkers() {
+    static const std::size_t num_workers =
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 2) - 1;
+    return num_workers;
+}
+
+ThreadWorker& ParallelForWorkers() {
+    static ThreadWorker workers(NumParallelForWorkers(), "yuzu:ParallelFor");
+    return workers;
+}
+
+} // namespace Common
@@ -0,0 +1,96 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+#include "common/thread_worker.h"
+
+namespace Common {
+
+/// Returns the worker pool shared by all ParallelFor calls, one thread less than host cores
+[[nodiscard]] ThreadWorker& ParallelForWorkers();
+
+/// Returns the number of threads in ParallelForWorkers
+[[nodiscard]] std::size_t NumParallelForWorkers();
+
+/**
+ * Calls func(index) for every index in [0, count), spreading the calls over the shared worker
+ * pool. The calling thread takes part in the work, and the function returns once all of the
+ * calls have finished. The first exception thrown by func is rethrown to the caller, indices that
+ * were not started yet are skipped.
+ *
+ * Meant for short bursts of independent CPU bound work, such as decompressing the segments of an
+ * executable at load time. func must be safe to call concurrently for different indices.
+ * The caller never waits for a worker to become available, so nested calls can't deadlock.
+ */
+template <typename Func>
+void ParallelFor(std::size_t count, Func&& func) {
+    if (count <= 1) {
+        if (count == 1) {
+            func(std::size_t{0});
+        }
+        return;
+    }
+
+    // Tasks may only be picked up by the pool after all of the work is done, so the state they
+    // use is shared with them. Those tasks find no index left and never touch func.
+    struct State {
+        std::atomic<std::size_t> next_index{0};
+        std::size_t count{};
+        std::remove_reference_t<Func>* func{};
+
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::size_t active_threads{};
+        std::exception_ptr exception;
+
+        void Run() {
+            {
+                std::scoped_lock lock{mutex};
+                ++active_threads;
+            }
+            for (std::size_t index = next_index++; index < count; index = next_index++) {
+                try {
+                    (*func)(index);
+                } catch (...) {
+                    std::scoped_lock lock{mutex};
+                    if (!exception) {
+                        exception = std::current_exception();
+                    }
+                    next_index = count;
+                }
+            }
+            std::scoped_lock lock{mutex};
+            if (--active_threads == 0) {
+                finished.notify_all();
+            }
+        }
+    };
+    const auto state = std::make_shared<State>();
+    state->count = count;
+    state->func = &func;
+
+    const std::size_t num_tasks = std::min(NumParallelForWorkers(), count - 1);
+    for (std::size_t task = 0; task < num_tasks; ++task) {
+        ParallelForWorkers().QueueWork([state] { state->Run(); });
+    }
+    state->Run();
+
+    std::unique_lock lock{state->mutex};
+    state->finished.wait(lock, [&state] { return state->active_threads == 0; });
+    if (state->exception) {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+} // namespace Common
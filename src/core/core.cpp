@@ -26,6 +26,7 @@
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/sdmc_factory.h"
 #include "core/file_sys/vfs_concat.h"
+#include "core/file_sys/vfs_mapped.h"
 #include "core/file_sys/vfs_real.h"
 #include "core/hardware_interrupt_manager.h"
 #include "core/hle/kernel/k_client_port.h"
@@ -126,6 +127,12 @@ FileSys::VirtualFile GetGameFileFromPath(const FileSys::VirtualFilesystem& vfs,
         return vfs->OpenFile(path + "/main", FileSys::Mode::Read);
     }
 
+    // Game images are only ever read, map them so the layers on top can slice them without copies
+    if (auto mapped = FileSys::MappedVfsFile::Open(
+            path, vfs->OpenDirectory(dir_name, FileSys::Mode::Read))) {
+        return mapped;
+    }
+
     return vfs->OpenFile(path, FileSys::Mode::Read);
 }
 
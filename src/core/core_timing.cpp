@@ -25,6 +25,9 @@ struct CoreTiming::Event {
     u64 fifo_order;
     std::uintptr_t user_data;
     std::weak_ptr<EventType> type;
+    const EventType* type_key;
+    std::size_t heap_index;
+    std::size_t key_index;
 
     // Sort by time, unless the times are the same, in which case sort by
     // the order added to the queue
@@ -112,9 +115,7 @@ void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
         std::scoped_lock scope{basic_lock};
         const u64 timeout = static_cast<u64>((GetGlobalTimeNs() + ns_into_future).count());
 
-        event_queue.emplace_back(Event{timeout, event_fifo_id++, user_data, event_type});
-
-        std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+        PushEvent(Event{timeout, event_fifo_id++, user_data, event_type, event_type.get(), 0, 0});
     }
     event.Set();
 }
@@ -122,14 +123,18 @@ void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
 void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type,
                                  std::uintptr_t user_data) {
     std::scoped_lock scope{basic_lock};
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get() && e.user_data == user_data;
-    });
-
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+    const auto it = events_by_key.find({event_type.get(), user_data});
+    if (it == events_by_key.end()) {
+        return;
+    }
+    // Walk backwards, erasing an event moves the last slot of the list into its position.
+    // The list itself is only erased together with its last event, which ends the loop.
+    // Events of a destroyed type may share its address, skip them as they are never executed.
+    const std::vector<u32>& slots = it->second;
+    for (std::size_t i = slots.size(); i-- > 0;) {
+        if (!event_pool[slots[i]].type.expired()) {
+            EraseEvent(slots[i]);
+        }
     }
 }
 
@@ -140,7 +145,7 @@ void CoreTiming::AddTicks(u64 ticks_to_add) {
 
 void CoreTiming::Idle() {
     if (!event_queue.empty()) {
-        const u64 next_event_time = event_queue.front().time;
+        const u64 next_event_time = event_pool[event_queue.front()].time;
         const u64 next_ticks = nsToCycles(std::chrono::nanoseconds(next_event_time)) + 10U;
         if (next_ticks > ticks) {
             ticks = next_ticks;
@@ -169,31 +174,134 @@ u64 CoreTiming::GetClockTicks() const {
 }
 
 void CoreTiming::ClearPendingEvents() {
+    event_pool.clear();
+    free_slots.clear();
     event_queue.clear();
+    events_by_key.clear();
 }
 
 void CoreTiming::RemoveEvent(const std::shared_ptr<EventType>& event_type) {
     std::scoped_lock lock{basic_lock};
+    // Events of a type may use any user data, gather them before erasing invalidates the index
+    std::vector<u32> slots;
+    for (const auto& [key, key_slots] : events_by_key) {
+        if (key.first != event_type.get()) {
+            continue;
+        }
+        for (const u32 slot : key_slots) {
+            if (!event_pool[slot].type.expired()) {
+                slots.push_back(slot);
+            }
+        }
+    }
+    for (const u32 slot : slots) {
+        EraseEvent(slot);
+    }
+}
 
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get();
-    });
+void CoreTiming::PushEvent(Event&& evt) {
+    u32 slot;
+    if (free_slots.empty()) {
+        slot = static_cast<u32>(event_pool.size());
+        event_pool.push_back(std::move(evt));
+    } else {
+        slot = free_slots.back();
+        free_slots.pop_back();
+        event_pool[slot] = std::move(evt);
+    }
+    std::vector<u32>& key_slots =
+        events_by_key[{event_pool[slot].type_key, event_pool[slot].user_data}];
+    event_pool[slot].key_index = key_slots.size();
+    key_slots.push_back(slot);
+
+    const std::size_t heap_index = event_queue.size();
+    event_pool[slot].heap_index = heap_index;
+    event_queue.push_back(slot);
+    SiftUp(heap_index);
+}
 
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+void CoreTiming::EraseEvent(u32 slot) {
+    Event& evt = event_pool[slot];
+
+    // Move the last slot of the key into the erased position
+    const auto key_it = events_by_key.find({evt.type_key, evt.user_data});
+    std::vector<u32>& key_slots = key_it->second;
+    const u32 last_key_slot = key_slots.back();
+    key_slots[evt.key_index] = last_key_slot;
+    event_pool[last_key_slot].key_index = evt.key_index;
+    key_slots.pop_back();
+    if (key_slots.empty()) {
+        events_by_key.erase(key_it);
     }
+
+    // Replace the erased entry with the last one in the heap and fix its position
+    const std::size_t heap_index = evt.heap_index;
+    const u32 last_slot = event_queue.back();
+    event_queue.pop_back();
+    if (last_slot != slot) {
+        event_queue[heap_index] = last_slot;
+        event_pool[last_slot].heap_index = heap_index;
+        if (heap_index > 0 && FiresBefore(last_slot, event_queue[(heap_index - 1) / 2])) {
+            SiftUp(heap_index);
+        } else {
+            SiftDown(heap_index);
+        }
+    }
+    // Release the type reference now instead of waiting for the slot to be reused
+    evt.type.reset();
+    free_slots.push_back(slot);
+}
+
+void CoreTiming::SiftUp(std::size_t heap_index) {
+    const u32 slot = event_queue[heap_index];
+    while (heap_index > 0) {
+        const std::size_t parent = (heap_index - 1) / 2;
+        if (!FiresBefore(slot, event_queue[parent])) {
+            break;
+        }
+        event_queue[heap_index] = event_queue[parent];
+        event_pool[event_queue[heap_index]].heap_index = heap_index;
+        heap_index = parent;
+    }
+    event_queue[heap_index] = slot;
+    event_pool[slot].heap_index = heap_index;
+}
+
+void CoreTiming::SiftDown(std::size_t heap_index) {
+    const u32 slot = event_queue[heap_index];
+    const std::size_t size = event_queue.size();
+    while (true) {
+        std::size_t child = heap_index * 2 + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && FiresBefore(event_queue[child + 1], event_queue[child])) {
+            ++child;
+        }
+        if (!FiresBefore(event_queue[child], slot)) {
+            break;
+        }
+        event_queue[heap_index] = event_queue[child];
+        event_pool[event_queue[heap_index]].heap_index = heap_index;
+        heap_index = child;
+    }
+    event_queue[heap_index] = slot;
+    event_pool[slot].heap_index = heap_index;
+}
+
+bool CoreTiming::FiresBefore(u32 lhs, u32 rhs) const {
+    return event_pool[lhs] < event_pool[rhs];
 }
 
 std::optional<s64> CoreTiming::Advance() {
     std::scoped_lock lock{advance_lock, basic_lock};
     global_timer = GetGlobalTimeNs().count();
 
-    while (!event_queue.empty() && event_queue.front().time <= global_timer) {
-        Event evt = std::move(event_queue.front());
-        std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-        event_queue.pop_back();
+    while (!event_queue.empty() && event_pool[event_queue.front()].time <= global_timer) {
+        const u32 slot = event_queue.front();
+        // Erasing only needs the bookkeeping fields, which are left intact by the move
+        const Event evt = std::move(event_pool[slot]);
+        EraseEvent(slot);
         basic_lock.unlock();
 
         if (const auto event_type{evt.type.lock()}) {
@@ -206,7 +314,7 @@ std::optional<s64> CoreTiming::Advance() {
     }
 
     if (!event_queue.empty()) {
-        const s64 next_time = event_queue.front().time - global_timer;
+        const s64 next_time = event_pool[event_queue.front()].time - global_timer;
         return next_time;
     } else {
         return std::nullopt;
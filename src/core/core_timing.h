@@ -12,9 +12,12 @@
 #include <optional>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/hash.h"
 #include "common/spin_lock.h"
 #include "common/thread.h"
 #include "common/wall_clock.h"
@@ -133,6 +136,22 @@ private:
     /// Clear all pending events. This should ONLY be done on exit.
     void ClearPendingEvents();
 
+    /// Adds an event to the queue. basic_lock must be held.
+    void PushEvent(Event&& evt);
+
+    /// Removes the event stored in the given pool slot from the queue. basic_lock must be held.
+    /// Erases the key of the event from events_by_key when it was the last one using it.
+    void EraseEvent(u32 slot);
+
+    /// Restores the heap invariant by moving an entry towards the root
+    void SiftUp(std::size_t heap_index);
+
+    /// Restores the heap invariant by moving an entry towards the leaves
+    void SiftDown(std::size_t heap_index);
+
+    /// Returns true when the event in slot lhs fires before the event in slot rhs
+    bool FiresBefore(u32 lhs, u32 rhs) const;
+
     static void ThreadEntry(CoreTiming& instance);
     void ThreadLoop();
 
@@ -140,11 +159,18 @@ private:
 
     u64 global_timer = 0;
 
-    // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-    // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-    // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't
-    // accomodated by the standard adaptor class.
-    std::vector<Event> event_queue;
+    // Pending events are stored in a pool of slots that is reused as events fire.
+    // The queue is an indexed min-heap of slots, each event knows its position in the heap so
+    // arbitrary events can be erased in logarithmic time without rebuilding the heap.
+    // Slots are also indexed by event type and user data, this is how UnscheduleEvent finds its
+    // events without scanning the whole queue, even when many events share a type. Events know
+    // their position in that list too, so it is updated in constant time. Keys without events
+    // are erased.
+    using EventKey = std::pair<const EventType*, std::uintptr_t>;
+    std::vector<Event> event_pool;
+    std::vector<u32> free_slots;
+    std::vector<u32> event_queue;
+    std::unordered_map<EventKey, std::vector<u32>, Common::PairHash> events_by_key;
     u64 event_fifo_id = 0;
 
     std::shared_ptr<EventType> ev_lost;
@@ -0,0 +1,244 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <utility>
+
+#include <immintrin.h>
+
+#include "common/common_types.h"
+#include "common/x64/cpu_detect.h"
+#include "core/crypto/aes_ni.h"
+
+// Only the functions touching the AES instructions are built for them, so the rest of the
+// emulator keeps running on hosts without AES-NI
+#ifdef _MSC_VER
+#define AESNI_FUNCTION
+#else
+#define AESNI_FUNCTION __attribute__((target("aes,ssse3")))
+#endif
+
+namespace Core::Crypto::AESNI {
+namespace {
+constexpr std::size_t BLOCK_SIZE = 16;
+constexpr std::size_t NUM_ROUND_KEYS = 11;
+
+/// Number of independent blocks in flight, enough to hide the latency of the AES instructions
+constexpr std::size_t PIPELINE_WIDTH = 8;
+
+struct RoundKeys {
+    __m128i& operator[](std::size_t index) {
+        return keys[index];
+    }
+    const __m128i& operator[](std::size_t index) const {
+        return keys[index];
+    }
+
+    __m128i keys[NUM_ROUND_KEYS];
+};
+
+AESNI_FUNCTION __m128i Load(const u8* data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+AESNI_FUNCTION void Store(u8* data, __m128i value) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value);
+}
+
+AESNI_FUNCTION RoundKeys LoadRoundKeys(const std::array<u8, NUM_ROUND_KEYS * BLOCK_SIZE>& keys) {
+    RoundKeys round_keys;
+    for (std::size_t i = 0; i < NUM_ROUND_KEYS; ++i) {
+        round_keys[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(&keys[i * BLOCK_SIZE]));
+    }
+    return round_keys;
+}
+
+template <int rcon>
+AESNI_FUNCTION __m128i ExpandRound(__m128i key) {
+    const __m128i assist = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(key, rcon), 0xFF);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+// Blocks are unrolled through index sequences so they stay in registers across the rounds
+template <std::size_t... I>
+AESNI_FUNCTION void EncryptBlocks(const RoundKeys& keys, __m128i* blocks,
+                                  std::index_sequence<I...>) {
+    ((blocks[I] = _mm_xor_si128(blocks[I], keys[0])), ...);
+    for (std::size_t round = 1; round < NUM_ROUND_KEYS - 1; ++round) {
+        ((blocks[I] = _mm_aesenc_si128(blocks[I], keys[round])), ...);
+    }
+    ((blocks[I] = _mm_aesenclast_si128(blocks[I], keys[NUM_ROUND_KEYS - 1])), ...);
+}
+
+template <std::size_t... I>
+AESNI_FUNCTION void DecryptBlocks(const RoundKeys& keys, __m128i* blocks,
+                                  std::index_sequence<I...>) {
+    ((blocks[I] = _mm_xor_si128(blocks[I], keys[0])), ...);
+    for (std::size_t round = 1; round < NUM_ROUND_KEYS - 1; ++round) {
+        ((blocks[I] = _mm_aesdec_si128(blocks[I], keys[round])), ...);
+    }
+    ((blocks[I] = _mm_aesdeclast_si128(blocks[I], keys[NUM_ROUND_KEYS - 1])), ...);
+}
+
+template <std::size_t N>
+AESNI_FUNCTION void EncryptBlocks(const RoundKeys& keys, __m128i* blocks) {
+    EncryptBlocks(keys, blocks, std::make_index_sequence<N>{});
+}
+
+template <std::size_t N>
+AESNI_FUNCTION void DecryptBlocks(const RoundKeys& keys, __m128i* blocks) {
+    DecryptBlocks(keys, blocks, std::make_index_sequence<N>{});
+}
+
+/// 128-bit big endian counter kept in host order
+struct Counter {
+    u64 high;
+    u64 low;
+
+    AESNI_FUNCTION __m128i Next() {
+        const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m128i value = _mm_set_epi64x(static_cast<s64>(high), static_cast<s64>(low));
+        if (++low == 0) {
+            ++high;
+        }
+        return _mm_shuffle_epi8(value, reverse);
+    }
+};
+
+u64 LoadBigEndian(const u8* data) {
+    u64 value = 0;
+    for (std::size_t i = 0; i < sizeof(u64); ++i) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+void StoreBigEndian(u8* data, u64 value) {
+    for (std::size_t i = sizeof(u64); i-- > 0;) {
+        data[i] = static_cast<u8>(value);
+        value >>= 8;
+    }
+}
+
+/// Multiplies an XTS tweak by the primitive element of GF(2^128)
+AESNI_FUNCTION __m128i MultiplyByAlpha(__m128i tweak) {
+    // Carry the top bit of each 32-bit lane into the next one, the top bit of the whole value is
+    // reduced with the field polynomial
+    const __m128i carries = _mm_shuffle_epi32(_mm_srai_epi32(tweak, 31), _MM_SHUFFLE(2, 1, 0, 3));
+    const __m128i reduction = _mm_and_si128(carries, _mm_set_epi32(1, 1, 1, 0x87));
+    return _mm_xor_si128(_mm_slli_epi32(tweak, 1), reduction);
+}
+
+template <std::size_t N>
+AESNI_FUNCTION void XTSBlocks(const RoundKeys& keys, __m128i& tweak, const u8* src, u8* dest,
+                              bool decrypt) {
+    __m128i tweaks[N];
+    __m128i blocks[N];
+    for (std::size_t i = 0; i < N; ++i) {
+        tweaks[i] = tweak;
+        blocks[i] = _mm_xor_si128(Load(src + i * BLOCK_SIZE), tweak);
+        tweak = MultiplyByAlpha(tweak);
+    }
+    if (decrypt) {
+        DecryptBlocks<N>(keys, blocks);
+    } else {
+        EncryptBlocks<N>(keys, blocks);
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        Store(dest + i * BLOCK_SIZE, _mm_xor_si128(blocks[i], tweaks[i]));
+    }
+}
+} // Anonymous namespace
+
+bool IsSupported() {
+    const auto& caps = Common::GetCPUCaps();
+    return caps.aes && caps.ssse3;
+}
+
+AESNI_FUNCTION void ExpandKey(const u8* key, KeySchedule& schedule) {
+    RoundKeys keys;
+    keys[0] = Load(key);
+    keys[1] = ExpandRound<0x01>(keys[0]);
+    keys[2] = ExpandRound<0x02>(keys[1]);
+    keys[3] = ExpandRound<0x04>(keys[2]);
+    keys[4] = ExpandRound<0x08>(keys[3]);
+    keys[5] = ExpandRound<0x10>(keys[4]);
+    keys[6] = ExpandRound<0x20>(keys[5]);
+    keys[7] = ExpandRound<0x40>(keys[6]);
+    keys[8] = ExpandRound<0x80>(keys[7]);
+    keys[9] = ExpandRound<0x1B>(keys[8]);
+    keys[10] = ExpandRound<0x36>(keys[9]);
+
+    // The equivalent inverse cipher runs the encryption keys backwards, with InvMixColumns
+    // applied to all but the first and last
+    for (std::size_t i = 0; i < NUM_ROUND_KEYS; ++i) {
+        const __m128i key_for_round = keys[NUM_ROUND_KEYS - 1 - i];
+        const bool is_edge = i == 0 || i == NUM_ROUND_KEYS - 1;
+        Store(&schedule.encrypt[i * BLOCK_SIZE], keys[i]);
+        Store(&schedule.decrypt[i * BLOCK_SIZE],
+              is_edge ? key_for_round : _mm_aesimc_si128(key_for_round));
+    }
+}
+
+AESNI_FUNCTION void CTRTranscode(const KeySchedule& key, std::array<u8, 16>& counter,
+                                 const u8* src, u8* dest, std::size_t size) {
+    const RoundKeys keys = LoadRoundKeys(key.encrypt);
+    Counter ctr{LoadBigEndian(counter.data()), LoadBigEndian(counter.data() + sizeof(u64))};
+
+    for (; size >= PIPELINE_WIDTH * BLOCK_SIZE; size -= PIPELINE_WIDTH * BLOCK_SIZE) {
+        __m128i blocks[PIPELINE_WIDTH];
+        for (__m128i& block : blocks) {
+            block = ctr.Next();
+        }
+        EncryptBlocks<PIPELINE_WIDTH>(keys, blocks);
+        for (std::size_t i = 0; i < PIPELINE_WIDTH; ++i) {
+            Store(dest + i * BLOCK_SIZE, _mm_xor_si128(blocks[i], Load(src + i * BLOCK_SIZE)));
+        }
+        src += PIPELINE_WIDTH * BLOCK_SIZE;
+        dest += PIPELINE_WIDTH * BLOCK_SIZE;
+    }
+    for (; size >= BLOCK_SIZE; size -= BLOCK_SIZE) {
+        __m128i block = ctr.Next();
+        EncryptBlocks<1>(keys, &block);
+        Store(dest, _mm_xor_si128(block, Load(src)));
+        src += BLOCK_SIZE;
+        dest += BLOCK_SIZE;
+    }
+    if (size != 0) {
+        __m128i block = ctr.Next();
+        EncryptBlocks<1>(keys, &block);
+        alignas(16) std::array<u8, BLOCK_SIZE> keystream;
+        Store(keystream.data(), block);
+        for (std::size_t i = 0; i < size; ++i) {
+            dest[i] = static_cast<u8>(src[i] ^ keystream[i]);
+        }
+    }
+
+    StoreBigEndian(counter.data(), ctr.high);
+    StoreBigEndian(counter.data() + sizeof(u64), ctr.low);
+}
+
+AESNI_FUNCTION void XTSTranscode(const KeySchedule& data_key, const KeySchedule& tweak_key,
+                                 const std::array<u8, 16>& tweak, const u8* src, u8* dest,
+                                 std::size_t size, bool decrypt) {
+    const RoundKeys keys = LoadRoundKeys(decrypt ? data_key.decrypt : data_key.encrypt);
+
+    __m128i current_tweak = Load(tweak.data());
+    EncryptBlocks<1>(LoadRoundKeys(tweak_key.encrypt), &current_tweak);
+
+    for (; size >= PIPELINE_WIDTH * BLOCK_SIZE; size -= PIPELINE_WIDTH * BLOCK_SIZE) {
+        XTSBlocks<PIPELINE_WIDTH>(keys, current_tweak, src, dest, decrypt);
+        src += PIPELINE_WIDTH * BLOCK_SIZE;
+        dest += PIPELINE_WIDTH * BLOCK_SIZE;
+    }
+    for (; size >= BLOCK_SIZE; size -= BLOCK_SIZE) {
+        XTSBlocks<1>(keys, current_tweak, src, dest, decrypt);
+        src += BLOCK_SIZE;
+        dest += BLOCK_SIZE;
+    }
+}
+
+} // namespace Core::Crypto::AESNI
@@ -0,0 +1,45 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "common/common_types.h"
+
+// AES-128 implementation on top of the x86 AES instructions, used by AESCipher for the bulk CTR
+// and XTS transcoding of content when the host supports it.
+namespace Core::Crypto::AESNI {
+
+/// Expanded AES-128 round keys
+struct KeySchedule {
+    alignas(16) std::array<u8, 11 * 16> encrypt;
+    alignas(16) std::array<u8, 11 * 16> decrypt;
+};
+
+/// Returns whether the host CPU has the instructions required by this backend
+[[nodiscard]] bool IsSupported();
+
+/// Expands a 16 byte AES-128 key into its encryption and decryption round keys
+void ExpandKey(const u8* key, KeySchedule& schedule);
+
+/**
+ * Encrypts or decrypts size bytes in CTR mode. src and dest may alias.
+ * The big endian counter is advanced by the number of blocks touched, including a trailing
+ * partial block, matching the behaviour of mbedtls when the cipher is reset between calls.
+ */
+void CTRTranscode(const KeySchedule& key, std::array<u8, 16>& counter, const u8* src, u8* dest,
+                  std::size_t size);
+
+/**
+ * Encrypts or decrypts a single XTS data unit of size bytes, which must be a multiple of the block
+ * size. src and dest may alias.
+ * @param tweak Unencrypted tweak of the data unit, as passed to mbedtls as the IV
+ */
+void XTSTranscode(const KeySchedule& data_key, const KeySchedule& tweak_key,
+                  const std::array<u8, 16>& tweak, const u8* src, u8* dest, std::size_t size,
+                  bool decrypt);
+
+} // namespace Core::Crypto::AESNI
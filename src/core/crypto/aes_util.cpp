@@ -2,13 +2,19 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
+#ifdef ARCHITECTURE_x86_64
+#include "core/crypto/aes_ni.h"
+#endif
+
 namespace Core::Crypto {
 namespace {
 using NintendoTweak = std::array<u8, 16>;
@@ -37,6 +43,15 @@ static_assert(static_cast<std::size_t>(Mode::XTS) ==
 struct CipherContext {
     mbedtls_cipher_context_t encryption_context;
     mbedtls_cipher_context_t decryption_context;
+
+#ifdef ARCHITECTURE_x86_64
+    // AES-NI state, replaces mbedtls for CTR and XTS content transcoding when the host supports it
+    bool use_aesni = false;
+    Mode mode{};
+    AESNI::KeySchedule data_key{};
+    AESNI::KeySchedule tweak_key{};
+    std::array<u8, 16> iv{};
+#endif
 };
 
 template <typename Key, std::size_t KeySize>
@@ -58,6 +73,20 @@ Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
     ASSERT(
         !mbedtls_cipher_setkey(&ctx->decryption_context, key.data(), KeySize * 8, MBEDTLS_DECRYPT));
     //"Failed to set key on mbedtls ciphers.");
+
+#ifdef ARCHITECTURE_x86_64
+    if (AESNI::IsSupported()) {
+        ctx->mode = mode;
+        if (mode == Mode::CTR && KeySize == 0x10) {
+            AESNI::ExpandKey(key.data(), ctx->data_key);
+            ctx->use_aesni = true;
+        } else if (mode == Mode::XTS && KeySize == 0x20) {
+            AESNI::ExpandKey(key.data(), ctx->data_key);
+            AESNI::ExpandKey(key.data() + 0x10, ctx->tweak_key);
+            ctx->use_aesni = true;
+        }
+    }
+#endif
 }
 
 template <typename Key, std::size_t KeySize>
@@ -68,6 +97,21 @@ AESCipher<Key, KeySize>::~AESCipher() {
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* dest, Op op) const {
+#ifdef ARCHITECTURE_x86_64
+    if (ctx->use_aesni) {
+        if (ctx->mode == Mode::CTR) {
+            AESNI::CTRTranscode(ctx->data_key, ctx->iv, src, dest, size);
+            return;
+        }
+        // Partial blocks need ciphertext stealing, leave those to mbedtls
+        if (size != 0 && size % 0x10 == 0) {
+            AESNI::XTSTranscode(ctx->data_key, ctx->tweak_key, ctx->iv, src, dest, size,
+                                op == Op::Decrypt);
+            return;
+        }
+    }
+#endif
+
     auto* const context = op == Op::Encrypt ? &ctx->encryption_context : &ctx->decryption_context;
 
     mbedtls_cipher_reset(context);
@@ -112,6 +156,16 @@ void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8*
                                            std::size_t sector_id, std::size_t sector_size, Op op) {
     ASSERT_MSG(size % sector_size == 0, "XTS decryption size must be a multiple of sector size.");
 
+#ifdef ARCHITECTURE_x86_64
+    if (ctx->use_aesni && ctx->mode == Mode::XTS && sector_size % 0x10 == 0) {
+        for (std::size_t i = 0; i < size; i += sector_size) {
+            AESNI::XTSTranscode(ctx->data_key, ctx->tweak_key, CalculateNintendoTweak(sector_id++),
+                                src + i, dest + i, sector_size, op == Op::Decrypt);
+        }
+        return;
+    }
+#endif
+
     for (std::size_t i = 0; i < size; i += sector_size) {
         SetIV(CalculateNintendoTweak(sector_id++));
         Transcode(src + i, sector_size, dest + i, op);
@@ -120,6 +174,9 @@ void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8*
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::SetIV(std::span<const u8> data) {
+#ifdef ARCHITECTURE_x86_64
+    std::memcpy(ctx->iv.data(), data.data(), std::min(data.size(), ctx->iv.size()));
+#endif
     ASSERT_MSG((mbedtls_cipher_set_iv(&ctx->encryption_context, data.data(), data.size()) ||
                 mbedtls_cipher_set_iv(&ctx->decryption_context, data.data(), data.size())) == 0,
                "Failed to set IV on mbedtls ciphers.");
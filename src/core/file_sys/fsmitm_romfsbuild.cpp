@@ -23,12 +23,14 @@
  */
 
 #include <cstring>
+#include <map>
 #include <string_view>
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "core/file_sys/fsmitm_romfsbuild.h"
 #include "core/file_sys/ips_layer.h"
 #include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_lazy.h"
 #include "core/file_sys/vfs_vector.h"
 
 namespace FileSys {
@@ -126,70 +128,98 @@ static u64 romfs_get_hash_table_count(u64 num_entries) {
     return count;
 }
 
-void RomFSBuildContext::VisitDirectory(VirtualDir root_romfs, VirtualDir ext_dir,
+void RomFSBuildContext::VisitDirectory(const std::vector<VirtualDir>& dirs, VirtualDir ext_dir,
                                        std::shared_ptr<RomFSBuildDirectoryContext> parent) {
-    std::vector<std::shared_ptr<RomFSBuildDirectoryContext>> child_dirs;
+    struct ChildDirectory {
+        std::shared_ptr<RomFSBuildDirectoryContext> context;
+        std::vector<VirtualDir> dirs;
+        VirtualDir ext_dir;
+    };
+    std::vector<ChildDirectory> child_dirs;
+
+    // An entry of a layer hides the ones with the same name in the layers after it, except for
+    // directories which are merged with the directories of the same name below them.
+    std::map<std::string, std::size_t, std::less<>> file_layers;
+    std::map<std::string, std::vector<VirtualDir>, std::less<>> subdir_layers;
+    for (std::size_t i = 0; i < dirs.size(); ++i) {
+        for (const auto& [name, type] : dirs[i]->GetEntries()) {
+            if (type == VfsEntryType::Directory) {
+                if (file_layers.contains(name)) {
+                    continue;
+                }
+                if (auto subdir = dirs[i]->GetSubdirectory(name)) {
+                    subdir_layers[name].push_back(std::move(subdir));
+                }
+            } else if (!subdir_layers.contains(name)) {
+                file_layers.try_emplace(name, i);
+            }
+        }
+    }
 
-    VirtualDir dir;
+    for (auto& [name, subdirs] : subdir_layers) {
+        const auto child = std::make_shared<RomFSBuildDirectoryContext>();
+        // Set child's path.
+        child->cur_path_ofs = parent->path_len + 1;
+        child->path_len = child->cur_path_ofs + static_cast<u32>(name.size());
+        child->path = parent->path + "/" + name;
 
-    if (parent->path_len == 0) {
-        dir = root_romfs;
-    } else {
-        dir = root_romfs->GetDirectoryRelative(parent->path);
-    }
+        if (ext_dir != nullptr && ext_dir->GetFile(name + ".stub") != nullptr) {
+            continue;
+        }
 
-    const auto entries = dir->GetEntries();
+        // Sanity check on path_len
+        ASSERT(child->path_len < FS_MAX_PATH);
 
-    for (const auto& kv : entries) {
-        if (kv.second == VfsEntryType::Directory) {
-            const auto child = std::make_shared<RomFSBuildDirectoryContext>();
-            // Set child's path.
-            child->cur_path_ofs = parent->path_len + 1;
-            child->path_len = child->cur_path_ofs + static_cast<u32>(kv.first.size());
-            child->path = parent->path + "/" + kv.first;
+        if (AddDirectory(parent, child)) {
+            child_dirs.push_back({
+                .context = child,
+                .dirs = std::move(subdirs),
+                .ext_dir = ext_dir != nullptr ? ext_dir->GetSubdirectory(name) : nullptr,
+            });
+        }
+    }
 
-            if (ext_dir != nullptr && ext_dir->GetFileRelative(child->path + ".stub") != nullptr) {
-                continue;
-            }
+    for (const auto& [name, layer] : file_layers) {
+        const auto child = std::make_shared<RomFSBuildFileContext>();
+        // Set child's path.
+        child->cur_path_ofs = parent->path_len + 1;
+        child->path_len = child->cur_path_ofs + static_cast<u32>(name.size());
+        child->path = parent->path + "/" + name;
 
-            // Sanity check on path_len
-            ASSERT(child->path_len < FS_MAX_PATH);
+        if (ext_dir != nullptr && ext_dir->GetFile(name + ".stub") != nullptr) {
+            continue;
+        }
 
-            if (AddDirectory(parent, child)) {
-                child_dirs.push_back(child);
-            }
-        } else {
-            const auto child = std::make_shared<RomFSBuildFileContext>();
-            // Set child's path.
-            child->cur_path_ofs = parent->path_len + 1;
-            child->path_len = child->cur_path_ofs + static_cast<u32>(kv.first.size());
-            child->path = parent->path + "/" + kv.first;
+        // Sanity check on path_len
+        ASSERT(child->path_len < FS_MAX_PATH);
 
-            if (ext_dir != nullptr && ext_dir->GetFileRelative(child->path + ".stub") != nullptr) {
+        const VirtualDir& dir = dirs[layer];
+        const auto ips = ext_dir != nullptr ? ext_dir->GetFile(name + ".ips") : nullptr;
+        if (ips != nullptr) {
+            // The size of a patched file is only known once the patch is applied
+            child->source = dir->GetFile(name);
+            if (child->source == nullptr) {
                 continue;
             }
-
-            // Sanity check on path_len
-            ASSERT(child->path_len < FS_MAX_PATH);
-
-            child->source = root_romfs->GetFileRelative(child->path);
-
-            if (ext_dir != nullptr) {
-                if (const auto ips = ext_dir->GetFileRelative(child->path + ".ips")) {
-                    if (auto patched = PatchIPS(child->source, ips)) {
-                        child->source = std::move(patched);
-                    }
-                }
+            if (auto patched = PatchIPS(child->source, ips)) {
+                child->source = std::move(patched);
             }
-
             child->size = child->source->GetSize();
-
-            AddFile(parent, child);
+        } else {
+            const auto size = dir->GetFileSize(name);
+            if (!size) {
+                continue;
+            }
+            child->size = *size;
+            child->source = std::make_shared<LazyVfsFile>(
+                [dir, file_name = name] { return dir->GetFile(file_name); }, name, *size);
         }
+
+        AddFile(parent, child);
     }
 
-    for (auto& child : child_dirs) {
-        this->VisitDirectory(root_romfs, ext_dir, child);
+    for (const auto& child : child_dirs) {
+        this->VisitDirectory(child.dirs, child.ext_dir, child.context);
     }
 }
 
@@ -229,17 +259,33 @@ bool RomFSBuildContext::AddFile(std::shared_ptr<RomFSBuildDirectoryContext> pare
 }
 
 RomFSBuildContext::RomFSBuildContext(VirtualDir base_, VirtualDir ext_)
-    : base(std::move(base_)), ext(std::move(ext_)) {
+    : RomFSBuildContext(std::vector<VirtualDir>{std::move(base_)}, std::move(ext_)) {}
+
+RomFSBuildContext::RomFSBuildContext(std::vector<VirtualDir> layers_, VirtualDir ext_)
+    : layers(std::move(layers_)), ext(std::move(ext_)) {
     root = std::make_shared<RomFSBuildDirectoryContext>();
     root->path = "\0";
     directories.emplace(root->path, root);
     num_dirs = 1;
     dir_table_size = 0x18;
 
-    VisitDirectory(base, ext, root);
+    VisitDirectory(layers, ext, root);
 }
 
-RomFSBuildContext::~RomFSBuildContext() = default;
+RomFSBuildContext::~RomFSBuildContext() {
+    // The contexts point to their parents as well as their children, break those cycles so that
+    // they and the sources they hold are freed with the context.
+    for (const auto& [path, dir_ctx] : directories) {
+        dir_ctx->parent.reset();
+        dir_ctx->child.reset();
+        dir_ctx->sibling.reset();
+        dir_ctx->file.reset();
+    }
+    for (const auto& [path, file_ctx] : files) {
+        file_ctx->parent.reset();
+        file_ctx->sibling.reset();
+    }
+}
 
 std::multimap<u64, VirtualFile> RomFSBuildContext::Build() {
     const u64 dir_hash_table_entry_count = romfs_get_hash_table_count(num_dirs);
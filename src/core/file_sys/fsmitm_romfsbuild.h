@@ -27,6 +27,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include "common/common_types.h"
 #include "core/file_sys/vfs.h"
 
@@ -40,13 +41,16 @@ struct RomFSFileEntry;
 class RomFSBuildContext {
 public:
     explicit RomFSBuildContext(VirtualDir base, VirtualDir ext = nullptr);
+    // Merges the layers, with the first one taking priority over the ones after it. Only the
+    // names and sizes of the files are read here, their contents are opened on first access.
+    explicit RomFSBuildContext(std::vector<VirtualDir> layers, VirtualDir ext = nullptr);
     ~RomFSBuildContext();
 
     // This finalizes the context.
     std::multimap<u64, VirtualFile> Build();
 
 private:
-    VirtualDir base;
+    std::vector<VirtualDir> layers;
     VirtualDir ext;
     std::shared_ptr<RomFSBuildDirectoryContext> root;
     std::map<std::string, std::shared_ptr<RomFSBuildDirectoryContext>, std::less<>> directories;
@@ -59,7 +63,7 @@ private:
     u64 file_hash_table_size = 0;
     u64 file_partition_size = 0;
 
-    void VisitDirectory(VirtualDir filesys, VirtualDir ext_dir,
+    void VisitDirectory(const std::vector<VirtualDir>& dirs, VirtualDir ext_dir,
                         std::shared_ptr<RomFSBuildDirectoryContext> parent);
 
     bool AddDirectory(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
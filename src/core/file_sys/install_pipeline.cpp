@@ -0,0 +1,212 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <mbedtls/sha256.h>
+
+#include "common/bounded_threadsafe_queue.h"
+#include "common/logging/log.h"
+#include "core/file_sys/install_pipeline.h"
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+namespace {
+// Number of blocks in flight between the stages
+constexpr std::size_t NUM_BUFFERS = 8;
+
+// Leaves room for the end marker on top of every buffer being queued
+constexpr std::size_t QUEUE_CAPACITY = 16;
+static_assert(QUEUE_CAPACITY > NUM_BUFFERS);
+
+struct Block {
+    std::size_t job{};
+    std::size_t offset{};
+    std::size_t size{};
+    std::size_t buffer{};
+    // Whether this is the last block of its job
+    bool last{};
+    // Marks the end of the stream, no other fields are valid
+    bool end{};
+    // Result of the verification of the job, only meaningful on its last block
+    bool verified{true};
+};
+
+using BlockQueue = Common::BoundedSPSCQueue<Block, QUEUE_CAPACITY>;
+
+class SHA256Context {
+public:
+    SHA256Context() {
+        mbedtls_sha256_init(&context);
+    }
+
+    ~SHA256Context() {
+        mbedtls_sha256_free(&context);
+    }
+
+    SHA256Context(const SHA256Context&) = delete;
+    SHA256Context& operator=(const SHA256Context&) = delete;
+
+    void Start() {
+        mbedtls_sha256_starts_ret(&context, 0);
+    }
+
+    void Update(const u8* data, std::size_t size) {
+        mbedtls_sha256_update_ret(&context, data, size);
+    }
+
+    std::array<u8, 0x20> Finish() {
+        std::array<u8, 0x20> hash{};
+        mbedtls_sha256_finish_ret(&context, hash.data());
+        return hash;
+    }
+
+private:
+    mbedtls_sha256_context context;
+};
+} // Anonymous namespace
+
+bool InstallFiles(std::span<const InstallJob> jobs, std::size_t block_size,
+                  const InstallProgressCallback& progress) {
+    std::vector<std::size_t> sizes;
+    sizes.reserve(jobs.size());
+    for (const InstallJob& job : jobs) {
+        if (job.source == nullptr || job.destination == nullptr || !job.source->IsReadable() ||
+            !job.destination->IsWritable()) {
+            return false;
+        }
+        sizes.push_back(job.source->GetSize());
+    }
+    if (jobs.empty()) {
+        return true;
+    }
+
+    const std::size_t buffer_size =
+        std::min(block_size, *std::max_element(sizes.begin(), sizes.end()));
+    std::array<std::vector<u8>, NUM_BUFFERS> buffers;
+
+    // Buffers go around from the reader to the verifier, the writer and back to the reader
+    BlockQueue free_buffers;
+    BlockQueue to_verify;
+    BlockQueue to_write;
+    for (std::size_t i = 0; i < NUM_BUFFERS; ++i) {
+        buffers[i].resize(buffer_size);
+        free_buffers.Push(Block{.buffer = i});
+    }
+
+    // Set by any stage on failure, tells the reader to stop producing blocks
+    std::atomic<bool> failed{false};
+
+    // Without any hash to check, the reader hands its blocks straight to the writer
+    const bool verify = std::any_of(jobs.begin(), jobs.end(), [](const InstallJob& job) {
+        return job.expected_hash.has_value();
+    });
+    BlockQueue& reader_output = verify ? to_verify : to_write;
+
+    std::jthread reader([&] {
+        const auto read_job = [&](std::size_t job_index) {
+            const InstallJob& job = jobs[job_index];
+            std::size_t offset = 0;
+            do {
+                Block block = free_buffers.PopWait();
+                if (failed) {
+                    return false;
+                }
+                block.job = job_index;
+                block.offset = offset;
+                block.size = std::min(block_size, sizes[job_index] - offset);
+                block.last = offset + block.size == sizes[job_index];
+                if (job.source->Read(buffers[block.buffer].data(), block.size, offset) !=
+                    block.size) {
+                    LOG_ERROR(Loader, "Failed to read from {}", job.source->GetName());
+                    failed = true;
+                    return false;
+                }
+                reader_output.Push(block);
+                offset += block.size;
+            } while (offset < sizes[job_index]);
+            return true;
+        };
+        for (std::size_t i = 0; i < jobs.size(); ++i) {
+            if (!read_job(i)) {
+                break;
+            }
+        }
+        reader_output.Push(Block{.end = true});
+    });
+
+    std::jthread verifier;
+    if (verify) {
+        verifier = std::jthread([&] {
+            SHA256Context context;
+            while (true) {
+                Block block = to_verify.PopWait();
+                if (block.end) {
+                    to_write.Push(block);
+                    break;
+                }
+                const InstallJob& job = jobs[block.job];
+                if (job.expected_hash) {
+                    if (block.offset == 0) {
+                        context.Start();
+                    }
+                    context.Update(buffers[block.buffer].data(), block.size);
+                    if (block.last) {
+                        block.verified = context.Finish() == *job.expected_hash;
+                    }
+                }
+                to_write.Push(block);
+            }
+        });
+    }
+
+    // The writer keeps draining the blocks after a failure, so that the other stages never stall
+    bool success = true;
+    while (true) {
+        const Block block = to_write.PopWait();
+        if (block.end) {
+            break;
+        }
+        if (success) {
+            const InstallJob& job = jobs[block.job];
+            if (block.offset == 0 && !job.destination->Resize(sizes[block.job])) {
+                LOG_ERROR(Loader, "Failed to resize {}", job.destination->GetName());
+                success = false;
+            } else if (job.destination->Write(buffers[block.buffer].data(), block.size,
+                                              block.offset) != block.size) {
+                LOG_ERROR(Loader, "Failed to write to {}", job.destination->GetName());
+                success = false;
+            } else if (!block.verified) {
+                LOG_ERROR(Loader, "Hash mismatch for {}, the file is corrupted",
+                          job.source->GetName());
+                success = false;
+            } else if (progress && !progress(block.size)) {
+                success = false;
+            }
+            if (!success) {
+                failed = true;
+            }
+        }
+        free_buffers.Push(Block{.buffer = block.buffer});
+    }
+
+    reader.join();
+    if (verifier.joinable()) {
+        verifier.join();
+    }
+    if (!success || failed) {
+        // Partially copied files are unusable, like on a cancelled raw copy leave them empty
+        for (const InstallJob& job : jobs) {
+            job.destination->Resize(0);
+        }
+        return false;
+    }
+    return true;
+}
+
+} // namespace FileSys
@@ -0,0 +1,38 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <span>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs_types.h"
+
+namespace FileSys {
+
+// Called with the number of bytes written since the last call. Returning false cancels the copy.
+using InstallProgressCallback = std::function<bool(std::size_t)>;
+
+struct InstallJob {
+    VirtualFile source;
+    VirtualFile destination;
+    // When set, the SHA-256 of the source must match it for the copy to succeed
+    std::optional<std::array<u8, 0x20>> expected_hash;
+};
+
+// Copies a batch of files through a pipeline of a read, a verification and a write stage, each
+// running on its own thread. The reader moves on to the next files while the previous ones are
+// still being verified and written, so several files are in flight at once. All the sources are
+// read from a single thread, which allows them to share an underlying file that is not safe to
+// access concurrently. The verification stage is skipped when no job has an expected hash.
+// Returns false if any read, write or verification failed, or if the copy was cancelled. All the
+// destinations are truncated to zero bytes in that case.
+bool InstallFiles(std::span<const InstallJob> jobs, std::size_t block_size,
+                  const InstallProgressCallback& progress = {});
+
+} // namespace FileSys
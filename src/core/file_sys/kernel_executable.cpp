@@ -2,8 +2,11 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <atomic>
 #include <cstring>
+#include <vector>
 
+#include "common/parallel_for.h"
 #include "common/string_util.h"
 #include "core/file_sys/kernel_executable.h"
 #include "core/file_sys/vfs_offset.h"
@@ -98,6 +101,8 @@ KIP::KIP(const VirtualFile& file) : status(Loader::ResultStatus::Success) {
         return;
     }
 
+    // Sections are read one after another, only the decompression is spread over the host cores
+    std::vector<std::size_t> compressed_sections;
     u64 offset = sizeof(KIPHeader);
     for (std::size_t i = 0; i < header.sections.size(); ++i) {
         auto compressed = file->ReadBytes(header.sections[i].compressed_size, offset);
@@ -105,15 +110,22 @@ KIP::KIP(const VirtualFile& file) : status(Loader::ResultStatus::Success) {
 
         if (header.sections[i].compressed_size == 0 && header.sections[i].decompressed_size != 0) {
             decompressed_sections[i] = std::vector<u8>(header.sections[i].decompressed_size);
-        } else if (header.sections[i].compressed_size == header.sections[i].decompressed_size) {
-            decompressed_sections[i] = std::move(compressed);
         } else {
-            decompressed_sections[i] = compressed;
-            if (!DecompressBLZ(decompressed_sections[i])) {
-                status = Loader::ResultStatus::ErrorBLZDecompressionFailed;
-                return;
+            if (header.sections[i].compressed_size != header.sections[i].decompressed_size) {
+                compressed_sections.push_back(i);
             }
+            decompressed_sections[i] = std::move(compressed);
+        }
+    }
+
+    std::atomic<bool> success{true};
+    Common::ParallelFor(compressed_sections.size(), [&](std::size_t index) {
+        if (!DecompressBLZ(decompressed_sections[compressed_sections[index]])) {
+            success = false;
         }
+    });
+    if (!success) {
+        status = Loader::ResultStatus::ErrorBLZDecompressionFailed;
     }
 }
 
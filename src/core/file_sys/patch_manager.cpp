@@ -390,14 +390,11 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
 
     layers.push_back(std::move(extracted));
 
-    auto layered = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers));
-    if (layered == nullptr) {
-        return;
-    }
-
     auto layered_ext = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers_ext));
 
-    auto packed = CreateRomFS(std::move(layered), std::move(layered_ext));
+    // The layers are merged while building the RomFS, which only reads the directory listings and
+    // file sizes of the mods upfront and leaves opening their files to the first access.
+    auto packed = CreateLayeredRomFS(std::move(layers), std::move(layered_ext));
     if (packed == nullptr) {
         return;
     }
@@ -3,10 +3,14 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstring>
+#include <map>
 #include <random>
 #include <regex>
+#include <string_view>
 #include <mbedtls/sha256.h>
 #include "common/assert.h"
+#include "common/common_funcs.h"
 #include "common/fs/path_util.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
@@ -18,6 +22,7 @@
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/submission_package.h"
 #include "core/file_sys/vfs_concat.h"
+#include "core/file_sys/vfs_vector.h"
 #include "core/loader/loader.h"
 
 namespace FileSys {
@@ -25,6 +30,28 @@ namespace FileSys {
 // The size of blocks to use when vfs raw copying into nand.
 constexpr size_t VFS_RC_LARGE_COPY_BLOCK = 0x400000;
 
+// Layout of the index of parsed NCAs kept in the yuzu_meta directory of each cache.
+constexpr std::string_view INDEX_FILE_NAME = "cnmt_index.bin";
+constexpr std::string_view INDEX_TEMP_FILE_NAME = "cnmt_index.bin.tmp";
+constexpr u32 INDEX_MAGIC = Common::MakeMagic('R', 'C', 'I', 'X');
+constexpr u32 INDEX_VERSION = 1;
+
+struct IndexHeader {
+    u32 magic;
+    u32 version;
+    u32 num_entries;
+};
+static_assert(sizeof(IndexHeader) == 0xC, "IndexHeader has incorrect size.");
+
+// Followed by cnmt_size bytes of raw CNMT
+struct IndexRecord {
+    NcaID nca_id;
+    u64 size;
+    u64 title_id;
+    u64 cnmt_size;
+};
+static_assert(sizeof(IndexRecord) == 0x28, "IndexRecord has incorrect size.");
+
 std::string ContentProviderEntry::DebugInfo() const {
     return fmt::format("title_id={:016X}, content_type={:02X}", title_id, static_cast<u8>(type));
 }
@@ -410,27 +437,160 @@ std::vector<NcaID> RegisteredCache::AccumulateFiles() const {
 }
 
 void RegisteredCache::ProcessFiles(const std::vector<NcaID>& ids) {
+    std::map<NcaID, IndexEntry> new_index;
+    bool index_changed = false;
+
     for (const auto& id : ids) {
         const auto file = GetFileAtID(id);
 
         if (file == nullptr)
             continue;
-        const auto nca = std::make_shared<NCA>(parser(file, id), nullptr, 0);
-        if (nca->GetStatus() != Loader::ResultStatus::Success ||
-            nca->GetType() != NCAContentType::Meta) {
+
+        // NcaIDs are derived from the contents, so an NCA of the same size is still the same one
+        const auto size = file->GetSize();
+        auto entry_iter = new_index.find(id);
+        if (entry_iter == new_index.end()) {
+            const auto old_iter = index.find(id);
+            if (old_iter != index.end() && old_iter->second.size == size) {
+                entry_iter = new_index.insert(index.extract(old_iter)).position;
+            } else {
+                const auto nca = std::make_shared<NCA>(parser(file, id), nullptr, 0);
+                if (nca->GetStatus() != Loader::ResultStatus::Success) {
+                    // Not indexed, as this may be fixed by adding keys later on
+                    continue;
+                }
+
+                IndexEntry entry{.size = size, .title_id = nca->GetTitleId(), .cnmt = {}};
+                if (nca->GetType() == NCAContentType::Meta) {
+                    const auto section0 = nca->GetSubdirectories()[0];
+
+                    for (const auto& section0_file : section0->GetFiles()) {
+                        if (section0_file->GetExtension() != "cnmt")
+                            continue;
+
+                        entry.cnmt = section0_file->ReadAllBytes();
+                        break;
+                    }
+                }
+
+                entry_iter = new_index.insert_or_assign(id, std::move(entry)).first;
+                index_changed = true;
+            }
+        }
+
+        const auto& entry = entry_iter->second;
+        if (entry.cnmt.empty()) {
             continue;
         }
 
-        const auto section0 = nca->GetSubdirectories()[0];
+        meta.insert_or_assign(entry.title_id,
+                              CNMT(std::make_shared<VectorVfsFile>(entry.cnmt, "cnmt")));
+        meta_id.insert_or_assign(entry.title_id, id);
+    }
 
-        for (const auto& section0_file : section0->GetFiles()) {
-            if (section0_file->GetExtension() != "cnmt")
-                continue;
+    // Whatever is left over was removed from the cache
+    index_changed |= !index.empty();
+    index = std::move(new_index);
+    if (index_changed) {
+        SaveIndex();
+    }
+}
 
-            meta.insert_or_assign(nca->GetTitleId(), CNMT(section0_file));
-            meta_id.insert_or_assign(nca->GetTitleId(), id);
+void RegisteredCache::LoadIndex() {
+    index.clear();
+
+    const auto meta_dir = dir->GetSubdirectory("yuzu_meta");
+    if (meta_dir == nullptr) {
+        return;
+    }
+    const auto file = meta_dir->GetFile(INDEX_FILE_NAME);
+    if (file == nullptr) {
+        return;
+    }
+
+    const auto data = file->ReadAllBytes();
+    std::size_t offset = 0;
+    const auto read = [&data, &offset](void* out, std::size_t size) {
+        if (data.size() - offset < size) {
+            return false;
+        }
+        std::memcpy(out, data.data() + offset, size);
+        offset += size;
+        return true;
+    };
+
+    IndexHeader header{};
+    if (!read(&header, sizeof(header)) || header.magic != INDEX_MAGIC ||
+        header.version != INDEX_VERSION) {
+        LOG_INFO(Loader, "Discarding outdated registered cache index");
+        return;
+    }
+
+    for (u32 i = 0; i < header.num_entries; ++i) {
+        IndexRecord record{};
+        if (!read(&record, sizeof(record))) {
+            break;
+        }
+        // Check the size before allocating, a corrupted record must not request a huge buffer
+        if (record.cnmt_size > data.size() - offset) {
             break;
         }
+        IndexEntry entry{.size = record.size, .title_id = record.title_id, .cnmt = {}};
+        entry.cnmt.resize(record.cnmt_size);
+        read(entry.cnmt.data(), entry.cnmt.size());
+        index.insert_or_assign(record.nca_id, std::move(entry));
+    }
+
+    if (index.size() != header.num_entries) {
+        LOG_ERROR(Loader, "Registered cache index is corrupted, discarding it");
+        index.clear();
+    }
+}
+
+void RegisteredCache::SaveIndex() const {
+    std::vector<u8> data(sizeof(IndexHeader));
+    const IndexHeader header{
+        .magic = INDEX_MAGIC,
+        .version = INDEX_VERSION,
+        .num_entries = static_cast<u32>(index.size()),
+    };
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    for (const auto& [id, entry] : index) {
+        const IndexRecord record{
+            .nca_id = id,
+            .size = entry.size,
+            .title_id = entry.title_id,
+            .cnmt_size = entry.cnmt.size(),
+        };
+        const auto offset = data.size();
+        data.resize(offset + sizeof(record) + entry.cnmt.size());
+        std::memcpy(data.data() + offset, &record, sizeof(record));
+        std::memcpy(data.data() + offset + sizeof(record), entry.cnmt.data(), entry.cnmt.size());
+    }
+
+    // The index is only an optimization, read-only caches simply go without it
+    const auto meta_dir = dir->CreateDirectoryRelative("yuzu_meta");
+    if (meta_dir == nullptr) {
+        return;
+    }
+
+    // Write to a temporary file first, so that a crash never leaves a truncated index behind.
+    // At worst the index is missing afterwards, which only costs a full parse on the next scan.
+    meta_dir->DeleteFile(INDEX_TEMP_FILE_NAME);
+    const auto out = meta_dir->CreateFile(INDEX_TEMP_FILE_NAME);
+    if (out == nullptr || !out->Resize(data.size()) || out->WriteBytes(data) != data.size()) {
+        LOG_WARNING(Loader, "Failed to write registered cache index");
+        meta_dir->DeleteFile(INDEX_TEMP_FILE_NAME);
+        return;
+    }
+    if (meta_dir->GetFile(INDEX_FILE_NAME) != nullptr && !meta_dir->DeleteFile(INDEX_FILE_NAME)) {
+        LOG_WARNING(Loader, "Failed to replace registered cache index");
+        meta_dir->DeleteFile(INDEX_TEMP_FILE_NAME);
+        return;
+    }
+    if (!out->Rename(INDEX_FILE_NAME)) {
+        LOG_WARNING(Loader, "Failed to replace registered cache index");
     }
 }
 
@@ -455,6 +615,10 @@ void RegisteredCache::Refresh() {
         return;
     }
 
+    meta_id.clear();
+    meta.clear();
+    yuzu_meta.clear();
+
     const auto ids = AccumulateFiles();
     ProcessFiles(ids);
     AccumulateYuzuMeta();
@@ -462,6 +626,9 @@ void RegisteredCache::Refresh() {
 
 RegisteredCache::RegisteredCache(VirtualDir dir_, ContentProviderParsingFunction parsing_function)
     : dir(std::move(dir_)), parser(std::move(parsing_function)) {
+    if (dir != nullptr) {
+        LoadIndex();
+    }
     Refresh();
 }
 
@@ -556,12 +723,15 @@ static std::shared_ptr<NCA> GetNCAFromNSPForID(const NSP& nsp, const NcaID& id)
 }
 
 InstallResult RegisteredCache::InstallEntry(const XCI& xci, bool overwrite_if_exists,
-                                            const VfsCopyFunction& copy) {
-    return InstallEntry(*xci.GetSecurePartitionNSP(), overwrite_if_exists, copy);
+                                            const InstallProgressCallback& progress,
+                                            bool verify_hashes) {
+    return InstallEntry(*xci.GetSecurePartitionNSP(), overwrite_if_exists, progress,
+                        verify_hashes);
 }
 
 InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_exists,
-                                            const VfsCopyFunction& copy) {
+                                            const InstallProgressCallback& progress,
+                                            bool verify_hashes) {
     const auto ncas = nsp.GetNCAsCollapsed();
     const auto meta_iter = std::find_if(ncas.begin(), ncas.end(), [](const auto& nca) {
         return nca->GetType() == NCAContentType::Meta;
@@ -604,26 +774,50 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
 
     const auto result = RemoveExistingEntry(title_id);
 
-    // Install Metadata File
-    const auto res = RawInstallNCA(**meta_iter, copy, overwrite_if_exists, meta_id_data);
+    // Create the files of the metadata NCA and of all the other NCAs up front, so that they can
+    // all be copied in a single pipeline
+    std::vector<InstallJob> jobs;
+    std::vector<NcaID> queued_ids;
+
+    // A failed or cancelled install must not leave partial NCAs behind in the cache
+    const auto abort_install = [this, &jobs, &queued_ids](InstallResult error) {
+        jobs.clear();
+        DeleteNCAFiles(queued_ids);
+        return error;
+    };
+
+    VirtualFile meta_out;
+    const auto res = CreateNCAFile(**meta_iter, overwrite_if_exists, meta_id_data, meta_out);
     if (res != InstallResult::Success) {
         return res;
     }
+    jobs.push_back({(*meta_iter)->GetBaseFile(), std::move(meta_out), std::nullopt});
+    queued_ids.push_back(meta_id_data);
 
-    // Install all the other NCAs
     for (const auto& record : cnmt.GetContentRecords()) {
         // Ignore DeltaFragments, they are not useful to us
         if (record.type == ContentRecordType::DeltaFragment) {
             continue;
         }
+        if (std::find(queued_ids.begin(), queued_ids.end(), record.nca_id) != queued_ids.end()) {
+            continue;
+        }
         const auto nca = GetNCAFromNSPForID(nsp, record.nca_id);
         if (nca == nullptr) {
-            return InstallResult::ErrorCopyFailed;
+            return abort_install(InstallResult::ErrorCopyFailed);
         }
-        const auto res2 = RawInstallNCA(*nca, copy, overwrite_if_exists, record.nca_id);
+        VirtualFile out;
+        const auto res2 = CreateNCAFile(*nca, overwrite_if_exists, record.nca_id, out);
         if (res2 != InstallResult::Success) {
-            return res2;
+            return abort_install(res2);
         }
+        jobs.push_back({nca->GetBaseFile(), std::move(out),
+                        verify_hashes ? std::make_optional(record.hash) : std::nullopt});
+        queued_ids.push_back(record.nca_id);
+    }
+
+    if (!InstallFiles(jobs, VFS_RC_LARGE_COPY_BLOCK, progress)) {
+        return abort_install(InstallResult::ErrorCopyFailed);
     }
 
     Refresh();
@@ -715,6 +909,28 @@ bool RegisteredCache::RemoveExistingEntry(u64 title_id) const {
 InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFunction& copy,
                                              bool overwrite_if_exists,
                                              std::optional<NcaID> override_id) {
+    VirtualFile out;
+    const auto res = CreateNCAFile(nca, overwrite_if_exists, override_id, out);
+    if (res != InstallResult::Success) {
+        return res;
+    }
+    return copy(nca.GetBaseFile(), out, VFS_RC_LARGE_COPY_BLOCK) ? InstallResult::Success
+                                                                 : InstallResult::ErrorCopyFailed;
+}
+
+void RegisteredCache::DeleteNCAFiles(const std::vector<NcaID>& ids) const {
+    for (const auto& id : ids) {
+        const auto path = GetRelativePathFromNcaID(id, false, true, false);
+        const auto nca_dir = dir->GetDirectoryRelative(Common::FS::GetParentPath(path));
+        if (nca_dir == nullptr || !nca_dir->DeleteFile(Common::FS::GetFilename(path))) {
+            LOG_ERROR(Loader, "Failed to delete partially installed NCA at {}", path);
+        }
+    }
+}
+
+InstallResult RegisteredCache::CreateNCAFile(const NCA& nca, bool overwrite_if_exists,
+                                             std::optional<NcaID> override_id,
+                                             VirtualFile& out_file) {
     const auto in = nca.GetBaseFile();
     Core::Crypto::SHA256Hash hash{};
 
@@ -745,12 +961,11 @@ InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFuncti
         c_dir->DeleteFile(Common::FS::GetFilename(path));
     }
 
-    auto out = dir->CreateFileRelative(path);
-    if (out == nullptr) {
+    out_file = dir->CreateFileRelative(path);
+    if (out_file == nullptr) {
         return InstallResult::ErrorCopyFailed;
     }
-    return copy(in, out, VFS_RC_LARGE_COPY_BLOCK) ? InstallResult::Success
-                                                  : InstallResult::ErrorCopyFailed;
+    return InstallResult::Success;
 }
 
 bool RegisteredCache::RawInstallYuzuMeta(const CNMT& cnmt) {
@@ -6,12 +6,14 @@
 
 #include <array>
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 #include <boost/container/flat_map.hpp>
 #include "common/common_types.h"
 #include "core/crypto/key_manager.h"
+#include "core/file_sys/install_pipeline.h"
 #include "core/file_sys/vfs.h"
 
 namespace FileSys {
@@ -157,11 +159,14 @@ public:
         std::optional<u64> title_id = {}) const override;
 
     // Raw copies all the ncas from the xci/nsp to the csache. Does some quick checks to make sure
-    // there is a meta NCA and all of them are accessible.
+    // there is a meta NCA and all of them are accessible. The NCAs are streamed through an
+    // InstallFiles pipeline, and checked against the hashes in the CNMT if verify_hashes is set.
     InstallResult InstallEntry(const XCI& xci, bool overwrite_if_exists = false,
-                               const VfsCopyFunction& copy = &VfsRawCopy);
+                               const InstallProgressCallback& progress = {},
+                               bool verify_hashes = false);
     InstallResult InstallEntry(const NSP& nsp, bool overwrite_if_exists = false,
-                               const VfsCopyFunction& copy = &VfsRawCopy);
+                               const InstallProgressCallback& progress = {},
+                               bool verify_hashes = false);
 
     // Due to the fact that we must use Meta-type NCAs to determine the existance of files, this
     // poses quite a challenge. Instead of creating a new meta NCA for this file, yuzu will create a
@@ -186,11 +191,27 @@ private:
     VirtualFile OpenFileOrDirectoryConcat(const VirtualDir& open_dir, std::string_view path) const;
     InstallResult RawInstallNCA(const NCA& nca, const VfsCopyFunction& copy,
                                 bool overwrite_if_exists, std::optional<NcaID> override_id = {});
+    InstallResult CreateNCAFile(const NCA& nca, bool overwrite_if_exists,
+                                std::optional<NcaID> override_id, VirtualFile& out_file);
+    void DeleteNCAFiles(const std::vector<NcaID>& ids) const;
     bool RawInstallYuzuMeta(const CNMT& cnmt);
+    void LoadIndex();
+    void SaveIndex() const;
+
+    // What parsing an NCA of the cache found out, so that it only has to be done once
+    struct IndexEntry {
+        u64 size{};
+        u64 title_id{};
+        // Raw CNMT of a meta NCA, empty for all other NCAs
+        std::vector<u8> cnmt;
+    };
 
     VirtualDir dir;
     ContentProviderParsingFunction parser;
 
+    // maps NcaID -> parsed NCA, persisted in yuzu_meta so unchanged NCAs are not parsed again
+    std::map<NcaID, IndexEntry> index;
+
     // maps tid -> NcaID of meta
     std::map<u64, NcaID> meta_id;
     // maps tid -> meta
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <memory>
 
 #include "common/common_types.h"
@@ -144,4 +145,13 @@ VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext) {
     return ConcatenatedVfsFile::MakeConcatenatedFile(0, ctx.Build(), dir->GetName());
 }
 
+VirtualFile CreateLayeredRomFS(std::vector<VirtualDir> layers, VirtualDir ext) {
+    if (layers.empty() || std::find(layers.begin(), layers.end(), nullptr) != layers.end())
+        return nullptr;
+
+    auto name = layers.front()->GetName();
+    RomFSBuildContext ctx{std::move(layers), std::move(ext)};
+    return ConcatenatedVfsFile::MakeConcatenatedFile(0, ctx.Build(), std::move(name));
+}
+
 } // namespace FileSys
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <vector>
 #include "core/file_sys/vfs.h"
 
 namespace FileSys {
@@ -23,4 +24,9 @@ VirtualDir ExtractRomFS(VirtualFile file,
 // Returns nullptr on failure
 VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext = nullptr);
 
+// Converts a stack of VFS filesystems into a RomFS binary, the first one taking priority over the
+// ones after it. Files are only opened once their contents are read from the RomFS.
+// Returns nullptr on failure
+VirtualFile CreateLayeredRomFS(std::vector<VirtualDir> layers, VirtualDir ext = nullptr);
+
 } // namespace FileSys
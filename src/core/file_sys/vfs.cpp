@@ -162,6 +162,10 @@ std::string VfsFile::GetExtension() const {
     return std::string(Common::FS::GetExtensionFromFilename(GetName()));
 }
 
+std::span<const u8> VfsFile::GetView(std::size_t offset, std::size_t length) const {
+    return {};
+}
+
 VfsDirectory::~VfsDirectory() = default;
 
 std::optional<u8> VfsFile::ReadByte(std::size_t offset) const {
@@ -273,6 +277,14 @@ VirtualFile VfsDirectory::GetFile(std::string_view name) const {
     return iter == files.end() ? nullptr : *iter;
 }
 
+std::optional<std::size_t> VfsDirectory::GetFileSize(std::string_view name) const {
+    const auto file = GetFile(name);
+    if (file == nullptr) {
+        return std::nullopt;
+    }
+    return file->GetSize();
+}
+
 VirtualDir VfsDirectory::GetSubdirectory(std::string_view name) const {
     const auto& subs = GetSubdirectories();
     const auto iter = std::find_if(subs.begin(), subs.end(),
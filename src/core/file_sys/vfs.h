@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -105,6 +106,12 @@ public:
     // into file. Returns number of bytes successfully written.
     virtual std::size_t Write(const u8* data, std::size_t length, std::size_t offset = 0) = 0;
 
+    // Returns a view of the length bytes of the file starting at offset, when that range lives in
+    // contiguous host memory that stays valid while the file is alive and unmodified. Returns an
+    // empty span when the range is out of bounds or not backed by such memory, in which case Read
+    // must be used instead.
+    virtual std::span<const u8> GetView(std::size_t offset, std::size_t length) const;
+
     // Reads exactly one byte at the offset provided, returning std::nullopt on error.
     virtual std::optional<u8> ReadByte(std::size_t offset = 0) const;
     // Reads size bytes starting at offset in file into a vector.
@@ -198,6 +205,9 @@ public:
     // Returns the file with filename matching name. Returns nullptr if directory dosen't have a
     // file with name.
     virtual VirtualFile GetFile(std::string_view name) const;
+    // Returns the size of the file with filename matching name, without opening it where the
+    // implementation allows. Returns nullopt if directory dosen't have a file with name.
+    virtual std::optional<std::size_t> GetFileSize(std::string_view name) const;
 
     // Returns a vector containing all of the subdirectories in this directory.
     virtual std::vector<VirtualDir> GetSubdirectories() const = 0;
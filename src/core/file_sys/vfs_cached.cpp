@@ -0,0 +1,298 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/thread_worker.h"
+#include "core/file_sys/vfs_cached.h"
+
+namespace FileSys {
+
+namespace {
+/// Number of back to back reads needed to consider an access pattern sequential
+constexpr u32 SEQUENTIAL_THRESHOLD = 2;
+
+Common::ThreadWorker& ReadAheadWorker() {
+    static Common::ThreadWorker worker(1, "yuzu:VfsReadAhead");
+    return worker;
+}
+
+std::size_t CopyFromBlock(const std::vector<u8>& block, std::size_t block_offset, u8* data,
+                          std::size_t length) {
+    if (block_offset >= block.size()) {
+        return 0;
+    }
+    const std::size_t copy_size = std::min(length, block.size() - block_offset);
+    std::memcpy(data, block.data() + block_offset, copy_size);
+    return copy_size;
+}
+} // Anonymous namespace
+
+struct CachedVfsFile::Cache {
+    struct Block {
+        std::vector<u8> data;
+        std::list<std::size_t>::iterator lru_entry;
+    };
+
+    Cache(VirtualFile base_, std::size_t block_size_, std::size_t max_blocks_,
+          std::size_t read_ahead_blocks_)
+        : base{std::move(base_)}, block_size{block_size_},
+          max_blocks{std::max(max_blocks_, read_ahead_blocks_ + 1)},
+          read_ahead_blocks{read_ahead_blocks_}, file_size{base->GetSize()} {}
+
+    /// Reads a whole block from the wrapped file
+    std::vector<u8> LoadBlock(std::size_t index, u64& read_generation) {
+        std::scoped_lock base_lock{base_mutex};
+        std::size_t size = 0;
+        {
+            std::scoped_lock lock{mutex};
+            read_generation = generation;
+            const std::size_t block_start = index * block_size;
+            if (block_start < file_size) {
+                size = std::min(block_size, file_size - block_start);
+            }
+        }
+        std::vector<u8> block(size);
+        block.resize(base->Read(block.data(), size, index * block_size));
+        return block;
+    }
+
+    /// Inserts a loaded block, dropping it if the file was written after it was read.
+    /// The caller must hold the cache mutex.
+    void Insert(std::size_t index, std::vector<u8>&& data, u64 read_generation) {
+        if (data.empty() || read_generation != generation || blocks.contains(index)) {
+            return;
+        }
+        while (blocks.size() >= max_blocks) {
+            blocks.erase(lru.back());
+            lru.pop_back();
+        }
+        lru.push_front(index);
+        blocks.emplace(index, Block{std::move(data), lru.begin()});
+    }
+
+    /// Drops the cached blocks at or after first, up to last.
+    /// The caller must hold the cache mutex.
+    void Invalidate(std::size_t first, std::size_t last) {
+        ++generation;
+        for (auto it = blocks.begin(); it != blocks.end();) {
+            if (it->first >= first && it->first <= last) {
+                lru.erase(it->second.lru_entry);
+                it = blocks.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    /// Copies data out of the block at index, loading it from the wrapped file on a miss
+    std::size_t ReadFromBlock(std::size_t index, std::size_t block_offset, u8* data,
+                              std::size_t length) {
+        {
+            std::scoped_lock lock{mutex};
+            if (const auto it = blocks.find(index); it != blocks.end()) {
+                lru.splice(lru.begin(), lru, it->second.lru_entry);
+                return CopyFromBlock(it->second.data, block_offset, data, length);
+            }
+        }
+        u64 read_generation{};
+        std::vector<u8> block = LoadBlock(index, read_generation);
+        const std::size_t copy_size = CopyFromBlock(block, block_offset, data, length);
+
+        std::scoped_lock lock{mutex};
+        Insert(index, std::move(block), read_generation);
+        return copy_size;
+    }
+
+    /// Updates the access pattern with a read, queueing a read-ahead when it is sequential
+    static void TrackAccess(const std::shared_ptr<Cache>& cache, std::size_t offset,
+                            std::size_t length) {
+        std::size_t first{};
+        std::size_t last{};
+        {
+            std::scoped_lock lock{cache->mutex};
+            if (offset == cache->next_sequential_offset) {
+                ++cache->sequential_streak;
+            } else {
+                cache->sequential_streak = 0;
+                cache->read_ahead_end = 0;
+            }
+            cache->next_sequential_offset = offset + length;
+
+            if (cache->read_ahead_blocks == 0 || cache->read_ahead_pending ||
+                cache->sequential_streak < SEQUENTIAL_THRESHOLD) {
+                return;
+            }
+            // Refill the window once half of it has been consumed
+            const std::size_t next_block = (offset + length) / cache->block_size;
+            if (cache->read_ahead_end > next_block + cache->read_ahead_blocks / 2) {
+                return;
+            }
+            const std::size_t num_blocks =
+                (cache->file_size + cache->block_size - 1) / cache->block_size;
+            first = std::max(next_block, cache->read_ahead_end);
+            last = std::min(next_block + cache->read_ahead_blocks, num_blocks);
+            if (first >= last) {
+                return;
+            }
+            cache->read_ahead_pending = true;
+            cache->read_ahead_end = last;
+        }
+        ReadAheadWorker().QueueWork([weak_cache = std::weak_ptr{cache}, first, last] {
+            if (const std::shared_ptr<Cache> locked_cache = weak_cache.lock()) {
+                locked_cache->ReadAhead(first, last);
+            }
+        });
+    }
+
+    void ReadAhead(std::size_t first, std::size_t last) {
+        for (std::size_t index = first; index < last; ++index) {
+            {
+                std::scoped_lock lock{mutex};
+                if (blocks.contains(index)) {
+                    continue;
+                }
+            }
+            u64 read_generation{};
+            std::vector<u8> block = LoadBlock(index, read_generation);
+            if (block.empty()) {
+                break;
+            }
+            std::scoped_lock lock{mutex};
+            Insert(index, std::move(block), read_generation);
+        }
+        std::scoped_lock lock{mutex};
+        read_ahead_pending = false;
+    }
+
+    const VirtualFile base;
+    const std::size_t block_size;
+    const std::size_t max_blocks;
+    const std::size_t read_ahead_blocks;
+
+    /// Serializes accesses to the wrapped file, always acquired before the cache mutex
+    std::mutex base_mutex;
+
+    std::mutex mutex;
+    std::unordered_map<std::size_t, Block> blocks;
+    std::list<std::size_t> lru;
+    std::size_t file_size{};
+    u64 generation{};
+
+    std::size_t next_sequential_offset{};
+    u32 sequential_streak{};
+    std::size_t read_ahead_end{};
+    bool read_ahead_pending{};
+};
+
+CachedVfsFile::CachedVfsFile(VirtualFile base, std::size_t block_size, std::size_t max_blocks,
+                             std::size_t read_ahead_blocks)
+    : cache{std::make_shared<Cache>(std::move(base), block_size, max_blocks, read_ahead_blocks)} {}
+
+CachedVfsFile::~CachedVfsFile() = default;
+
+std::string CachedVfsFile::GetName() const {
+    return cache->base->GetName();
+}
+
+std::size_t CachedVfsFile::GetSize() const {
+    std::scoped_lock lock{cache->mutex};
+    return cache->file_size;
+}
+
+bool CachedVfsFile::Resize(std::size_t new_size) {
+    std::scoped_lock base_lock{cache->base_mutex};
+    const bool result = cache->base->Resize(new_size);
+
+    std::scoped_lock lock{cache->mutex};
+    const std::size_t first_changed = std::min(new_size, cache->file_size) / cache->block_size;
+    cache->Invalidate(first_changed, std::numeric_limits<std::size_t>::max());
+    cache->file_size = cache->base->GetSize();
+    return result;
+}
+
+VirtualDir CachedVfsFile::GetContainingDirectory() const {
+    return cache->base->GetContainingDirectory();
+}
+
+bool CachedVfsFile::IsWritable() const {
+    return cache->base->IsWritable();
+}
+
+bool CachedVfsFile::IsReadable() const {
+    return cache->base->IsReadable();
+}
+
+std::size_t CachedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    const std::size_t file_size = GetSize();
+    if (offset >= file_size) {
+        return 0;
+    }
+    length = std::min(length, file_size - offset);
+
+    if (const auto view = cache->base->GetView(offset, length); !view.empty()) {
+        std::memcpy(data, view.data(), view.size());
+        return view.size();
+    }
+
+    // Large reads would only thrash the cache, hand them to the wrapped file as they are
+    if (length > cache->block_size * std::max<std::size_t>(cache->read_ahead_blocks, 1)) {
+        std::scoped_lock base_lock{cache->base_mutex};
+        return cache->base->Read(data, length, offset);
+    }
+
+    std::size_t read = 0;
+    while (read < length) {
+        const std::size_t current_offset = offset + read;
+        const std::size_t copied =
+            cache->ReadFromBlock(current_offset / cache->block_size,
+                                 current_offset % cache->block_size, data + read, length - read);
+        if (copied == 0) {
+            break;
+        }
+        read += copied;
+    }
+    Cache::TrackAccess(cache, offset, read);
+    return read;
+}
+
+std::size_t CachedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    std::scoped_lock base_lock{cache->base_mutex};
+    const std::size_t written = cache->base->Write(data, length, offset);
+
+    std::scoped_lock lock{cache->mutex};
+    if (written != 0) {
+        cache->Invalidate(offset / cache->block_size, (offset + written - 1) / cache->block_size);
+    }
+    // Growing the file also changes the contents of the previously last block
+    const std::size_t new_size = cache->base->GetSize();
+    if (new_size != cache->file_size) {
+        cache->Invalidate(std::min(new_size, cache->file_size) / cache->block_size,
+                          std::numeric_limits<std::size_t>::max());
+        cache->file_size = new_size;
+    }
+    return written;
+}
+
+std::span<const u8> CachedVfsFile::GetView(std::size_t offset, std::size_t length) const {
+    return cache->base->GetView(offset, length);
+}
+
+bool CachedVfsFile::Rename(std::string_view name) {
+    std::scoped_lock base_lock{cache->base_mutex};
+    return cache->base->Rename(name);
+}
+
+std::string CachedVfsFile::GetFullPath() const {
+    return cache->base->GetFullPath();
+}
+
+} // namespace FileSys
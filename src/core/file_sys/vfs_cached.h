@@ -0,0 +1,49 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+// An implementation of VfsFile that wraps around another VfsFile and keeps the most recently read
+// blocks of it in an LRU cache. Sequential reads are detected and the blocks following them are
+// read ahead on a background thread. Reads spanning more than the read-ahead window bypass the
+// cache, writes go through to the wrapped file and drop the cached blocks they overlap.
+// Accesses to the wrapped file are serialized, so it may be shared between threads. Files that
+// are already backed by host memory are read straight from their view instead.
+class CachedVfsFile : public VfsFile {
+public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 0x4000;
+    static constexpr std::size_t DEFAULT_MAX_BLOCKS = 256;
+    static constexpr std::size_t DEFAULT_READ_AHEAD_BLOCKS = 16;
+
+    explicit CachedVfsFile(VirtualFile base, std::size_t block_size = DEFAULT_BLOCK_SIZE,
+                           std::size_t max_blocks = DEFAULT_MAX_BLOCKS,
+                           std::size_t read_ahead_blocks = DEFAULT_READ_AHEAD_BLOCKS);
+    ~CachedVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    std::span<const u8> GetView(std::size_t offset, std::size_t length) const override;
+    bool Rename(std::string_view name) override;
+    std::string GetFullPath() const override;
+
+private:
+    struct Cache;
+
+    std::shared_ptr<Cache> cache;
+};
+
+} // namespace FileSys
@@ -136,6 +136,22 @@ std::size_t ConcatenatedVfsFile::Write(const u8* data, std::size_t length, std::
     return 0;
 }
 
+std::span<const u8> ConcatenatedVfsFile::GetView(std::size_t offset, std::size_t length) const {
+    // Only ranges within a single file are contiguous
+    auto entry = files.upper_bound(offset);
+    if (entry == files.begin()) {
+        return {};
+    }
+    --entry;
+
+    const std::size_t entry_offset = offset - entry->first;
+    const std::size_t entry_size = entry->second->GetSize();
+    if (entry_offset > entry_size || length > entry_size - entry_offset) {
+        return {};
+    }
+    return entry->second->GetView(entry_offset, length);
+}
+
 bool ConcatenatedVfsFile::Rename(std::string_view new_name) {
     return false;
 }
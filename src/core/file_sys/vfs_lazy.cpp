@@ -0,0 +1,84 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <utility>
+
+#include "common/logging/log.h"
+#include "core/file_sys/vfs_lazy.h"
+
+namespace FileSys {
+
+LazyVfsFile::LazyVfsFile(Opener opener_, std::string name_, std::size_t size_)
+    : opener(std::move(opener_)), name(std::move(name_)), size(size_) {}
+
+LazyVfsFile::~LazyVfsFile() = default;
+
+const VirtualFile& LazyVfsFile::Resolve() const {
+    std::call_once(opened, [this] {
+        file = opener();
+        if (file == nullptr) {
+            LOG_ERROR(Service_FS, "Failed to open {}", name);
+        }
+        // Drop whatever the opener captured, it is not needed anymore
+        opener = nullptr;
+    });
+    return file;
+}
+
+std::string LazyVfsFile::GetName() const {
+    return name;
+}
+
+std::size_t LazyVfsFile::GetSize() const {
+    return size;
+}
+
+bool LazyVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+VirtualDir LazyVfsFile::GetContainingDirectory() const {
+    return nullptr;
+}
+
+bool LazyVfsFile::IsWritable() const {
+    return false;
+}
+
+bool LazyVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t LazyVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (offset >= size) {
+        return 0;
+    }
+    const auto& backing = Resolve();
+    if (backing == nullptr) {
+        return 0;
+    }
+    return backing->Read(data, std::min(length, size - offset), offset);
+}
+
+std::size_t LazyVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return 0;
+}
+
+std::span<const u8> LazyVfsFile::GetView(std::size_t offset, std::size_t length) const {
+    if (offset > size || length > size - offset) {
+        return {};
+    }
+    const auto& backing = Resolve();
+    if (backing == nullptr) {
+        return {};
+    }
+    return backing->GetView(offset, length);
+}
+
+bool LazyVfsFile::Rename(std::string_view new_name) {
+    return false;
+}
+
+} // namespace FileSys
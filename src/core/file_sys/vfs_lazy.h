@@ -0,0 +1,47 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+// A read-only implementation of VfsFile that only opens the file it stands for on the first access
+// to its contents. The name and size are known upfront, so it can be laid out in a container
+// without touching the underlying file. If the file cannot be opened, reads return no data.
+class LazyVfsFile : public VfsFile {
+public:
+    using Opener = std::function<VirtualFile()>;
+
+    explicit LazyVfsFile(Opener opener_, std::string name_, std::size_t size_);
+    ~LazyVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    std::span<const u8> GetView(std::size_t offset, std::size_t length) const override;
+    bool Rename(std::string_view new_name) override;
+
+private:
+    const VirtualFile& Resolve() const;
+
+    mutable Opener opener;
+    mutable std::once_flag opened;
+    mutable VirtualFile file;
+    std::string name;
+    std::size_t size;
+};
+
+} // namespace FileSys
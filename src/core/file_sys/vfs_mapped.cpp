@@ -0,0 +1,160 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#ifdef _WIN32
+#include <windows.h>
+#include "common/string_util.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/file_sys/vfs_mapped.h"
+
+namespace FileSys {
+
+struct MappedVfsFile::Mapping {
+    Mapping() = default;
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    ~Mapping() {
+        if (data == nullptr) {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+#else
+        munmap(const_cast<u8*>(data), size);
+#endif
+    }
+
+    const u8* data{};
+    std::size_t size{};
+};
+
+std::shared_ptr<MappedVfsFile> MappedVfsFile::Open(const std::string& path, VirtualDir parent) {
+    auto mapping = std::make_unique<Mapping>();
+
+#ifdef _WIN32
+    const HANDLE file =
+        CreateFileW(Common::UTF8ToUTF16W(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) ||
+        static_cast<u64>(file_size.QuadPart) > static_cast<u64>(SIZE_MAX)) {
+        CloseHandle(file);
+        return nullptr;
+    }
+    mapping->size = static_cast<std::size_t>(file_size.QuadPart);
+    if (mapping->size != 0) {
+        // The view keeps the file and the mapping object alive, the handles can be closed here
+        const HANDLE file_mapping =
+            CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (file_mapping != nullptr) {
+            mapping->data =
+                static_cast<const u8*>(MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(file_mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return nullptr;
+    }
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+        close(fd);
+        return nullptr;
+    }
+    mapping->size = static_cast<std::size_t>(file_stat.st_size);
+    if (mapping->size != 0) {
+        void* const data = mmap(nullptr, mapping->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            mapping->data = static_cast<const u8*>(data);
+        }
+    }
+    close(fd);
+#endif
+
+    if (mapping->size != 0 && mapping->data == nullptr) {
+        LOG_WARNING(Service_FS, "Failed to map file at path '{}'", path);
+        return nullptr;
+    }
+    return std::shared_ptr<MappedVfsFile>(
+        new MappedVfsFile(path, std::move(mapping), std::move(parent)));
+}
+
+MappedVfsFile::MappedVfsFile(std::string path_, std::unique_ptr<Mapping> mapping_,
+                             VirtualDir parent_)
+    : path{std::move(path_)}, mapping{std::move(mapping_)}, parent{std::move(parent_)} {}
+
+MappedVfsFile::~MappedVfsFile() = default;
+
+std::string MappedVfsFile::GetName() const {
+    const std::string_view name = Common::FS::GetFilename(path);
+    return std::string(name.empty() ? path : name);
+}
+
+std::size_t MappedVfsFile::GetSize() const {
+    return mapping->size;
+}
+
+bool MappedVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+VirtualDir MappedVfsFile::GetContainingDirectory() const {
+    return parent;
+}
+
+bool MappedVfsFile::IsWritable() const {
+    return false;
+}
+
+bool MappedVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t MappedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (offset >= mapping->size) {
+        return 0;
+    }
+    const std::size_t read_size = std::min(length, mapping->size - offset);
+    std::memcpy(data, mapping->data + offset, read_size);
+    return read_size;
+}
+
+std::size_t MappedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return 0;
+}
+
+std::span<const u8> MappedVfsFile::GetView(std::size_t offset, std::size_t length) const {
+    if (offset > mapping->size || length > mapping->size - offset) {
+        return {};
+    }
+    return {mapping->data + offset, length};
+}
+
+bool MappedVfsFile::Rename(std::string_view name) {
+    return false;
+}
+
+std::string MappedVfsFile::GetFullPath() const {
+    return path;
+}
+
+} // namespace FileSys
@@ -0,0 +1,47 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+// A read-only implementation of VfsFile backed by a memory mapping of a file on the user's
+// computer. Reads are plain copies out of the mapping and GetView hands out pointers into it, so
+// layers that only slice the file (offset, concatenated, vector) never copy or issue syscalls.
+class MappedVfsFile : public VfsFile {
+public:
+    // Maps the file at path, returning nullptr if it cannot be opened or mapped.
+    static std::shared_ptr<MappedVfsFile> Open(const std::string& path, VirtualDir parent = nullptr);
+
+    ~MappedVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    std::span<const u8> GetView(std::size_t offset, std::size_t length) const override;
+    bool Rename(std::string_view name) override;
+    std::string GetFullPath() const override;
+
+private:
+    struct Mapping;
+
+    MappedVfsFile(std::string path, std::unique_ptr<Mapping> mapping, VirtualDir parent);
+
+    std::string path;
+    std::unique_ptr<Mapping> mapping;
+    VirtualDir parent;
+};
+
+} // namespace FileSys
@@ -57,6 +57,13 @@ std::size_t OffsetVfsFile::Write(const u8* data, std::size_t length, std::size_t
     return file->Write(data, TrimToFit(length, r_offset), offset + r_offset);
 }
 
+std::span<const u8> OffsetVfsFile::GetView(std::size_t r_offset, std::size_t length) const {
+    if (r_offset > size || length > size - r_offset) {
+        return {};
+    }
+    return file->GetView(offset + r_offset, length);
+}
+
 std::optional<u8> OffsetVfsFile::ReadByte(std::size_t r_offset) const {
     if (r_offset >= size) {
         return std::nullopt;
@@ -92,6 +99,10 @@ std::size_t OffsetVfsFile::GetOffset() const {
     return offset;
 }
 
+VirtualFile OffsetVfsFile::GetWrappedFile() const {
+    return file;
+}
+
 std::size_t OffsetVfsFile::TrimToFit(std::size_t r_size, std::size_t r_offset) const {
     return std::clamp(r_size, std::size_t{0}, size - r_offset);
 }
@@ -29,6 +29,7 @@ public:
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    std::span<const u8> GetView(std::size_t offset, std::size_t length) const override;
     std::optional<u8> ReadByte(std::size_t offset) const override;
     std::vector<u8> ReadBytes(std::size_t size, std::size_t offset) const override;
     std::vector<u8> ReadAllBytes() const override;
@@ -39,6 +40,9 @@ public:
 
     std::size_t GetOffset() const;
 
+    /// Returns the file this one is a window into.
+    VirtualFile GetWrappedFile() const;
+
 private:
     std::size_t TrimToFit(std::size_t r_size, std::size_t r_offset) const;
 
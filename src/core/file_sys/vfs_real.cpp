@@ -66,6 +66,7 @@ VfsEntryType RealVfsFilesystem::GetEntryType(std::string_view path_) const {
 
 VirtualFile RealVfsFilesystem::OpenFile(std::string_view path_, Mode perms) {
     const auto path = FS::SanitizePath(path_, FS::DirectorySeparator::PlatformDefault);
+    std::scoped_lock lock{cache_mutex};
 
     if (const auto weak_iter = cache.find(path); weak_iter != cache.cend()) {
         const auto& weak = weak_iter->second;
@@ -117,29 +118,32 @@ VirtualFile RealVfsFilesystem::CopyFile(std::string_view old_path_, std::string_
 VirtualFile RealVfsFilesystem::MoveFile(std::string_view old_path_, std::string_view new_path_) {
     const auto old_path = FS::SanitizePath(old_path_, FS::DirectorySeparator::PlatformDefault);
     const auto new_path = FS::SanitizePath(new_path_, FS::DirectorySeparator::PlatformDefault);
-    const auto cached_file_iter = cache.find(old_path);
-
-    if (cached_file_iter != cache.cend()) {
-        auto file = cached_file_iter->second.lock();
-
-        if (!cached_file_iter->second.expired()) {
-            file->Close();
-        }
-
-        if (!FS::RenameFile(old_path, new_path)) {
-            return nullptr;
-        }
-
-        cache.erase(old_path);
-        file->Open(new_path, FS::FileAccessMode::Read, FS::FileType::BinaryFile);
-        if (file->IsOpen()) {
-            cache.insert_or_assign(new_path, std::move(file));
+    {
+        std::scoped_lock lock{cache_mutex};
+        const auto cached_file_iter = cache.find(old_path);
+
+        if (cached_file_iter != cache.cend()) {
+            auto file = cached_file_iter->second.lock();
+
+            if (!cached_file_iter->second.expired()) {
+                file->Close();
+            }
+
+            if (!FS::RenameFile(old_path, new_path)) {
+                return nullptr;
+            }
+
+            cache.erase(old_path);
+            file->Open(new_path, FS::FileAccessMode::Read, FS::FileType::BinaryFile);
+            if (file->IsOpen()) {
+                cache.insert_or_assign(new_path, std::move(file));
+            } else {
+                LOG_ERROR(Service_FS, "Failed to open path {} in order to re-cache it", new_path);
+            }
         } else {
-            LOG_ERROR(Service_FS, "Failed to open path {} in order to re-cache it", new_path);
+            UNREACHABLE();
+            return nullptr;
         }
-    } else {
-        UNREACHABLE();
-        return nullptr;
     }
 
     return OpenFile(new_path, Mode::ReadWrite);
@@ -147,6 +151,7 @@ VirtualFile RealVfsFilesystem::MoveFile(std::string_view old_path_, std::string_
 
 bool RealVfsFilesystem::DeleteFile(std::string_view path_) {
     const auto path = FS::SanitizePath(path_, FS::DirectorySeparator::PlatformDefault);
+    std::scoped_lock lock{cache_mutex};
     const auto cached_iter = cache.find(path);
 
     if (cached_iter != cache.cend()) {
@@ -189,6 +194,7 @@ VirtualDir RealVfsFilesystem::MoveDirectory(std::string_view old_path_,
         return nullptr;
     }
 
+    std::scoped_lock lock{cache_mutex};
     for (auto& kv : cache) {
         // If the path in the cache doesn't start with old_path, then bail on this file.
         if (kv.first.rfind(old_path, 0) != 0) {
@@ -220,6 +226,7 @@ VirtualDir RealVfsFilesystem::MoveDirectory(std::string_view old_path_,
 
 bool RealVfsFilesystem::DeleteDirectory(std::string_view path_) {
     const auto path = FS::SanitizePath(path_, FS::DirectorySeparator::PlatformDefault);
+    std::scoped_lock lock{cache_mutex};
 
     for (auto& kv : cache) {
         // If the path in the cache doesn't start with path, then bail on this file.
@@ -366,6 +373,14 @@ VirtualFile RealVfsDirectory::GetFile(std::string_view name) const {
     return GetFileRelative(name);
 }
 
+std::optional<std::size_t> RealVfsDirectory::GetFileSize(std::string_view name) const {
+    const auto full_path = FS::SanitizePath(path + '/' + std::string(name));
+    if (!FS::IsFile(full_path)) {
+        return std::nullopt;
+    }
+    return FS::GetSize(full_path);
+}
+
 VirtualDir RealVfsDirectory::GetSubdirectory(std::string_view name) const {
     return GetDirectoryRelative(name);
 }
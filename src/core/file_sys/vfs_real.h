@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <string_view>
 #include <boost/container/flat_map.hpp>
 #include "core/file_sys/mode.h"
@@ -36,6 +37,8 @@ public:
     bool DeleteDirectory(std::string_view path) override;
 
 private:
+    // Files are opened lazily from the threads of the FS services, so the cache needs a lock
+    std::mutex cache_mutex;
     boost::container::flat_map<std::string, std::weak_ptr<Common::FS::IOFile>> cache;
 };
 
@@ -81,6 +84,7 @@ public:
     VirtualFile GetFileRelative(std::string_view relative_path) const override;
     VirtualDir GetDirectoryRelative(std::string_view relative_path) const override;
     VirtualFile GetFile(std::string_view name) const override;
+    std::optional<std::size_t> GetFileSize(std::string_view name) const override;
     VirtualDir GetSubdirectory(std::string_view name) const override;
     VirtualFile CreateFileRelative(std::string_view relative_path) override;
     VirtualDir CreateDirectoryRelative(std::string_view relative_path) override;
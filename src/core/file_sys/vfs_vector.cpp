@@ -51,6 +51,13 @@ std::size_t VectorVfsFile::Write(const u8* data_, std::size_t length, std::size_
     return write;
 }
 
+std::span<const u8> VectorVfsFile::GetView(std::size_t offset, std::size_t length) const {
+    if (offset > data.size() || length > data.size() - offset) {
+        return {};
+    }
+    return std::span{data}.subspan(offset, length);
+}
+
 bool VectorVfsFile::Rename(std::string_view name_) {
     name = name_;
     return true;
@@ -72,6 +79,14 @@ std::vector<VirtualFile> VectorVfsDirectory::GetFiles() const {
     return files;
 }
 
+VirtualFile VectorVfsDirectory::GetFile(std::string_view file_name) const {
+    // Looks through the files in place rather than through a copy of them like the base class
+    const auto iter = std::find_if(files.begin(), files.end(), [file_name](const VirtualFile& file) {
+        return file->GetName() == file_name;
+    });
+    return iter == files.end() ? nullptr : *iter;
+}
+
 std::vector<VirtualDir> VectorVfsDirectory::GetSubdirectories() const {
     return dirs;
 }
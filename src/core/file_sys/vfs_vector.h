@@ -55,6 +55,13 @@ public:
         return 0;
     }
 
+    std::span<const u8> GetView(std::size_t offset, std::size_t length) const override {
+        if (offset > size || length > size - offset) {
+            return {};
+        }
+        return std::span{data}.subspan(offset, length);
+    }
+
     bool Rename(std::string_view new_name) override {
         name = new_name;
         return true;
@@ -87,6 +94,7 @@ public:
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    std::span<const u8> GetView(std::size_t offset, std::size_t length) const override;
     bool Rename(std::string_view name) override;
 
     virtual void Assign(std::vector<u8> new_data);
@@ -107,6 +115,7 @@ public:
     ~VectorVfsDirectory() override;
 
     std::vector<VirtualFile> GetFiles() const override;
+    VirtualFile GetFile(std::string_view file_name) const override;
     std::vector<VirtualDir> GetSubdirectories() const override;
     bool IsWritable() const override;
     bool IsReadable() const override;
@@ -30,8 +30,11 @@
 
 namespace Kernel {
 
-SessionRequestHandler::SessionRequestHandler(KernelCore& kernel_, const char* service_name_)
-    : kernel{kernel_}, service_thread{kernel.CreateServiceThread(service_name_)} {}
+SessionRequestHandler::SessionRequestHandler(KernelCore& kernel_, const char* service_name_,
+                                             ServiceThreadType thread_type)
+    : kernel{kernel_}, service_thread{thread_type == ServiceThreadType::CreateNew
+                                          ? kernel.CreateDedicatedServiceThread(service_name_)
+                                          : kernel.CreateServiceThread(service_name_)} {}
 
 SessionRequestHandler::~SessionRequestHandler() {
     kernel.ReleaseServiceThread(service_thread);
@@ -234,6 +237,12 @@ ResultCode HLERequestContext::WriteToOutgoingCommandBuffer(KThread& requesting_t
         }
     }
 
+    // Write back the output buffers that could not be accessed directly
+    for (const BounceBuffer& bounce : write_bounce_buffers) {
+        memory.WriteBlock(owner_process, bounce.address, bounce.data.data(), bounce.data.size());
+    }
+    write_bounce_buffers.clear();
+
     // Copy the translated command buffer back into the thread's command buffer area.
     memory.WriteBlock(owner_process, requesting_thread.GetTLSAddress(), cmd_buf.data(),
                       write_size * sizeof(u32));
@@ -296,6 +305,70 @@ std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
     return size;
 }
 
+std::span<const u8> HLERequestContext::ReadBufferSpan(std::size_t buffer_index) const {
+    const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
+                           BufferDescriptorA()[buffer_index].Size()};
+
+    VAddr address{};
+    std::size_t size{};
+    if (is_buffer_a) {
+        ASSERT_OR_EXECUTE_MSG(
+            BufferDescriptorA().size() > buffer_index, { return {}; },
+            "BufferDescriptorA invalid buffer_index {}", buffer_index);
+        address = BufferDescriptorA()[buffer_index].Address();
+        size = BufferDescriptorA()[buffer_index].Size();
+    } else {
+        ASSERT_OR_EXECUTE_MSG(
+            BufferDescriptorX().size() > buffer_index, { return {}; },
+            "BufferDescriptorX invalid buffer_index {}", buffer_index);
+        address = BufferDescriptorX()[buffer_index].Address();
+        size = BufferDescriptorX()[buffer_index].Size();
+    }
+    if (size == 0) {
+        return {};
+    }
+
+    if (const u8* const pointer = memory.GetContiguousPointer(address, size)) {
+        return {pointer, size};
+    }
+    auto& buffer = read_bounce_buffers.emplace_back(size);
+    memory.ReadBlock(address, buffer.data(), size);
+    return buffer;
+}
+
+std::span<u8> HLERequestContext::WriteBufferSpan(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+
+    VAddr address{};
+    std::size_t size{};
+    if (is_buffer_b) {
+        ASSERT_OR_EXECUTE_MSG(
+            BufferDescriptorB().size() > buffer_index, { return {}; },
+            "BufferDescriptorB invalid buffer_index {}", buffer_index);
+        address = BufferDescriptorB()[buffer_index].Address();
+        size = BufferDescriptorB()[buffer_index].Size();
+    } else {
+        ASSERT_OR_EXECUTE_MSG(
+            BufferDescriptorC().size() > buffer_index, { return {}; },
+            "BufferDescriptorC invalid buffer_index {}", buffer_index);
+        address = BufferDescriptorC()[buffer_index].Address();
+        size = BufferDescriptorC()[buffer_index].Size();
+    }
+    if (size == 0) {
+        return {};
+    }
+
+    if (u8* const pointer = memory.GetContiguousPointer(address, size)) {
+        return {pointer, size};
+    }
+    // Fill the bounce buffer with the current contents, so bytes left untouched by the handler
+    // are preserved when the whole buffer is written back
+    auto& bounce = write_bounce_buffers.emplace_back(BounceBuffer{address, std::vector<u8>(size)});
+    memory.ReadBlock(address, bounce.data.data(), size);
+    return bounce.data;
+}
+
 std::size_t HLERequestContext::GetReadBufferSize(std::size_t buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
@@ -8,6 +8,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -50,6 +51,12 @@ class ServiceThread;
 
 enum class ThreadWakeupReason;
 
+/// Selects the host threads that run the requests of a session handler
+enum class ServiceThreadType {
+    Default,   ///< Shared pool of the kernel, for requests that never block
+    CreateNew, ///< Dedicated host thread, for requests that can block on the host
+};
+
 /**
  * Interface implemented by HLE Session handlers.
  * This can be provided to a ServerSession in order to hook into several relevant events
@@ -57,7 +64,8 @@ enum class ThreadWakeupReason;
  */
 class SessionRequestHandler : public std::enable_shared_from_this<SessionRequestHandler> {
 public:
-    SessionRequestHandler(KernelCore& kernel, const char* service_name_);
+    SessionRequestHandler(KernelCore& kernel, const char* service_name_,
+                          ServiceThreadType thread_type = ServiceThreadType::Default);
     virtual ~SessionRequestHandler();
 
     /**
@@ -294,6 +302,23 @@ public:
         }
     }
 
+    /**
+     * Helper function to get a view of the input buffer using the appropriate buffer descriptor.
+     * The view points directly into guest memory when the buffer is contiguous in host memory,
+     * otherwise the buffer is copied into storage owned by this context.
+     * The view is valid until this context is destroyed.
+     */
+    std::span<const u8> ReadBufferSpan(std::size_t buffer_index = 0) const;
+
+    /**
+     * Helper function to get a writable view of the output buffer using the appropriate buffer
+     * descriptor. The view points directly into guest memory when the buffer is contiguous in host
+     * memory, otherwise it points to storage owned by this context that is written back to guest
+     * memory along with the response.
+     * The view is valid until this context is destroyed.
+     */
+    std::span<u8> WriteBufferSpan(std::size_t buffer_index = 0) const;
+
     /// Helper function to get the size of the input buffer
     std::size_t GetReadBufferSize(std::size_t buffer_index = 0) const;
 
@@ -350,6 +375,12 @@ private:
 
     void ParseCommandBuffer(const KHandleTable& handle_table, u32_le* src_cmdbuf, bool incoming);
 
+    /// Output buffer that could not be mapped directly and is written back with the response
+    struct BounceBuffer {
+        VAddr address;
+        std::vector<u8> data;
+    };
+
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
     Kernel::KServerSession* server_session{};
     KThread* thread;
@@ -371,6 +402,9 @@ private:
     std::vector<IPC::BufferDescriptorABW> buffer_w_desciptors;
     std::vector<IPC::BufferDescriptorC> buffer_c_desciptors;
 
+    mutable std::vector<std::vector<u8>> read_bounce_buffers;
+    mutable std::vector<BounceBuffer> write_bounce_buffers;
+
     u32_le command{};
     u64 pid{};
     u32 write_size{};
@@ -2,14 +2,17 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <bitset>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -92,8 +95,16 @@ struct KernelCore::Impl {
     void Shutdown() {
         process_list.clear();
 
-        // Ensures all service threads gracefully shutdown
-        service_threads.clear();
+        // Ensures all service threads gracefully shutdown. They are destroyed outside the lock,
+        // requests still in flight may release other service threads.
+        std::unordered_set<std::shared_ptr<Kernel::ServiceThread>> stopped_service_threads;
+        {
+            std::scoped_lock lock{service_threads_lock};
+            stopped_service_threads.swap(service_threads);
+        }
+        stopped_service_threads.clear();
+        service_thread_pool.reset();
+        dedicated_service_pools.clear();
 
         next_object_id = 0;
         next_kernel_process_id = KProcess::InitialKIPIDMin;
@@ -674,7 +685,10 @@ struct KernelCore::Impl {
     Kernel::KSharedMemory* time_shared_mem{};
 
     // Threads used for services
+    std::unique_ptr<Kernel::ServiceThreadPool> service_thread_pool;
+    std::vector<std::unique_ptr<Kernel::ServiceThreadPool>> dedicated_service_pools;
     std::unordered_set<std::shared_ptr<Kernel::ServiceThread>> service_threads;
+    std::mutex service_threads_lock;
 
     std::array<KThread*, Core::Hardware::NUM_CPU_CORES> suspend_threads;
     std::array<Core::CPUInterruptHandler, Core::Hardware::NUM_CPU_CORES> interrupts{};
@@ -977,13 +991,34 @@ void KernelCore::ExitSVCProfile() {
 }
 
 std::weak_ptr<Kernel::ServiceThread> KernelCore::CreateServiceThread(const std::string& name) {
-    auto service_thread = std::make_shared<Kernel::ServiceThread>(*this, 1, name);
+    // Services create the handlers of their sub-interfaces from the pool workers, in parallel
+    std::scoped_lock lock{impl->service_threads_lock};
+    if (!impl->service_thread_pool) {
+        // Services that can block run on dedicated threads, this pool only runs short requests
+        const std::size_t num_threads = std::clamp(std::thread::hardware_concurrency(), 4U, 8U);
+        impl->service_thread_pool =
+            std::make_unique<Kernel::ServiceThreadPool>(*this, num_threads, "yuzu:HleService");
+    }
+    auto service_thread = std::make_shared<Kernel::ServiceThread>(*impl->service_thread_pool, name);
+    impl->service_threads.emplace(service_thread);
+    return service_thread;
+}
+
+std::weak_ptr<Kernel::ServiceThread> KernelCore::CreateDedicatedServiceThread(
+    const std::string& name) {
+    std::scoped_lock lock{impl->service_threads_lock};
+    // Pools are kept until shutdown, a service may be destroyed from one of its own requests and
+    // its worker can't join itself
+    auto& pool = impl->dedicated_service_pools.emplace_back(
+        std::make_unique<Kernel::ServiceThreadPool>(*this, 1, "yuzu:" + name));
+    auto service_thread = std::make_shared<Kernel::ServiceThread>(*pool, name);
     impl->service_threads.emplace(service_thread);
     return service_thread;
 }
 
 void KernelCore::ReleaseServiceThread(std::weak_ptr<Kernel::ServiceThread> service_thread) {
     if (auto strong_ptr = service_thread.lock()) {
+        std::scoped_lock lock{impl->service_threads_lock};
         impl->service_threads.erase(strong_ptr);
     }
 }
@@ -258,6 +258,15 @@ public:
      */
     std::weak_ptr<Kernel::ServiceThread> CreateServiceThread(const std::string& name);
 
+    /**
+     * Creates an HLE service thread backed by its own host thread. Used by services whose requests
+     * can block, so they don't hold a worker shared with other services.
+     * @param name String name for the ServerSession creating this thread, also names the host
+     * thread.
+     * @returns The a weak pointer newly created service thread.
+     */
+    std::weak_ptr<Kernel::ServiceThread> CreateDedicatedServiceThread(const std::string& name);
+
     /**
      * Releases a HLE service thread, instructing KernelCore to free it. This should be called when
      * the ServerSession associated with the thread is destroyed.
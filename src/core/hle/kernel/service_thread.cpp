@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <thread>
@@ -10,6 +11,7 @@
 #include <queue>
 
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "common/scope_exit.h"
 #include "common/thread.h"
 #include "core/core.h"
@@ -21,56 +23,112 @@
 
 namespace Kernel {
 
-class ServiceThread::Impl final {
+class ServiceThreadPool::Impl final {
 public:
-    explicit Impl(KernelCore& kernel, std::size_t num_threads, const std::string& name);
+    explicit Impl(KernelCore& kernel, std::size_t num_threads, const std::string& thread_name);
     ~Impl();
 
-    void QueueSyncRequest(KSession& session, std::shared_ptr<HLERequestContext>&& context);
+    /// Queues a service thread with pending requests to be run by the workers
+    void Schedule(std::shared_ptr<ServiceThread::Impl> service_thread);
 
 private:
+    void WorkerLoop(KernelCore& kernel, const std::string& thread_name);
+
     std::vector<std::thread> threads;
-    std::queue<std::function<void()>> requests;
+    std::deque<std::shared_ptr<ServiceThread::Impl>> ready;
     std::mutex queue_mutex;
     std::condition_variable condition;
-    const std::string service_name;
     bool stop{};
 };
 
-ServiceThread::Impl::Impl(KernelCore& kernel, std::size_t num_threads, const std::string& name)
-    : service_name{name} {
-    for (std::size_t i = 0; i < num_threads; ++i)
-        threads.emplace_back([this, &kernel] {
-            Common::SetCurrentThreadName(std::string{"yuzu:HleService:" + service_name}.c_str());
+class ServiceThread::Impl final : public std::enable_shared_from_this<ServiceThread::Impl> {
+public:
+    explicit Impl(ServiceThreadPool::Impl& pool, const std::string& name);
 
-            // Wait for first request before trying to acquire a render context
-            {
-                std::unique_lock lock{queue_mutex};
-                condition.wait(lock, [this] { return stop || !requests.empty(); });
-            }
+    void QueueSyncRequest(KSession& session, std::shared_ptr<HLERequestContext>&& context);
 
-            kernel.RegisterHostThread();
+    /// Runs queued requests in order on the calling pool worker.
+    /// @returns True when requests are still pending and the service thread has to be rescheduled
+    bool RunBatch();
+
+    /// Drops all pending requests and waits for the request in flight to finish
+    void Stop();
+
+private:
+    /// Number of requests to run before yielding the worker to other service threads
+    static constexpr std::size_t MAX_BATCH_SIZE = 8;
+
+    ServiceThreadPool::Impl& pool;
+    std::queue<std::function<void()>> requests;
+    std::mutex queue_mutex;
+    std::condition_variable idle_condition;
+    std::thread::id running_thread{};
+    const std::string service_name;
+    bool scheduled{};
+    bool stop{};
+};
 
-            while (true) {
-                std::function<void()> task;
+ServiceThreadPool::Impl::Impl(KernelCore& kernel, std::size_t num_threads,
+                              const std::string& thread_name) {
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([this, &kernel, thread_name] { WorkerLoop(kernel, thread_name); });
+    }
+}
+
+ServiceThreadPool::Impl::~Impl() {
+    {
+        std::unique_lock lock{queue_mutex};
+        stop = true;
+    }
+    condition.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
 
-                {
-                    std::unique_lock lock{queue_mutex};
-                    condition.wait(lock, [this] { return stop || !requests.empty(); });
-                    if (stop || requests.empty()) {
-                        return;
-                    }
-                    task = std::move(requests.front());
-                    requests.pop();
-                }
+void ServiceThreadPool::Impl::Schedule(std::shared_ptr<ServiceThread::Impl> service_thread) {
+    {
+        std::unique_lock lock{queue_mutex};
+        ready.push_back(std::move(service_thread));
+    }
+    condition.notify_one();
+}
 
-                task();
+void ServiceThreadPool::Impl::WorkerLoop(KernelCore& kernel, const std::string& thread_name) {
+    Common::SetCurrentThreadName(thread_name.c_str());
+
+    bool is_registered = false;
+    while (true) {
+        std::shared_ptr<ServiceThread::Impl> service_thread;
+        {
+            std::unique_lock lock{queue_mutex};
+            condition.wait(lock, [this] { return stop || !ready.empty(); });
+            if (stop) {
+                return;
             }
-        });
+            service_thread = std::move(ready.front());
+            ready.pop_front();
+        }
+
+        // Wait for first request before trying to acquire a render context
+        if (!is_registered) {
+            kernel.RegisterHostThread();
+            is_registered = true;
+        }
+
+        if (service_thread->RunBatch()) {
+            // Requeue at the back so other services are not starved by a busy one
+            Schedule(std::move(service_thread));
+        }
+    }
 }
 
+ServiceThread::Impl::Impl(ServiceThreadPool::Impl& pool_, const std::string& name)
+    : pool{pool_}, service_name{name} {}
+
 void ServiceThread::Impl::QueueSyncRequest(KSession& session,
                                            std::shared_ptr<HLERequestContext>&& context) {
+    bool needs_scheduling = false;
     {
         std::unique_lock lock{queue_mutex};
 
@@ -87,25 +145,79 @@ void ServiceThread::Impl::QueueSyncRequest(KSession& session,
             // Complete the service request.
             server_session->CompleteSyncRequest(*context);
         });
+
+        // Only one worker at a time may own a service thread, this preserves request ordering
+        if (!scheduled) {
+            scheduled = true;
+            needs_scheduling = true;
+        }
     }
-    condition.notify_one();
+    if (needs_scheduling) {
+        pool.Schedule(shared_from_this());
+    }
+}
+
+bool ServiceThread::Impl::RunBatch() {
+    for (std::size_t batch = 0; batch < MAX_BATCH_SIZE; ++batch) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock{queue_mutex};
+            if (stop || requests.empty()) {
+                scheduled = false;
+                return false;
+            }
+            task = std::move(requests.front());
+            requests.pop();
+            running_thread = std::this_thread::get_id();
+        }
+
+        task();
+
+        {
+            std::unique_lock lock{queue_mutex};
+            running_thread = {};
+        }
+        idle_condition.notify_all();
+    }
+
+    std::unique_lock lock{queue_mutex};
+    if (stop || requests.empty()) {
+        scheduled = false;
+        return false;
+    }
+    return true;
 }
 
-ServiceThread::Impl::~Impl() {
+void ServiceThread::Impl::Stop() {
+    std::queue<std::function<void()>> dropped_requests;
     {
         std::unique_lock lock{queue_mutex};
         stop = true;
-    }
-    condition.notify_all();
-    for (std::thread& thread : threads) {
-        thread.join();
+        dropped_requests.swap(requests);
+        if (!dropped_requests.empty()) {
+            LOG_WARNING(Service, "Dropping {} pending requests of service={}",
+                        dropped_requests.size(), service_name);
+        }
+
+        // The service may be destroyed from one of its own requests, don't wait for ourselves
+        if (running_thread != std::this_thread::get_id()) {
+            idle_condition.wait(lock, [this] { return running_thread == std::thread::id{}; });
+        }
     }
 }
 
-ServiceThread::ServiceThread(KernelCore& kernel, std::size_t num_threads, const std::string& name)
-    : impl{std::make_unique<Impl>(kernel, num_threads, name)} {}
+ServiceThreadPool::ServiceThreadPool(KernelCore& kernel, std::size_t num_threads,
+                                     const std::string& thread_name)
+    : impl{std::make_unique<Impl>(kernel, num_threads, thread_name)} {}
 
-ServiceThread::~ServiceThread() = default;
+ServiceThreadPool::~ServiceThreadPool() = default;
+
+ServiceThread::ServiceThread(ServiceThreadPool& pool, const std::string& name)
+    : impl{std::make_shared<Impl>(*pool.impl, name)} {}
+
+ServiceThread::~ServiceThread() {
+    impl->Stop();
+}
 
 void ServiceThread::QueueSyncRequest(KSession& session,
                                      std::shared_ptr<HLERequestContext>&& context) {
@@ -13,16 +13,38 @@ class HLERequestContext;
 class KernelCore;
 class KSession;
 
+/// Host threads running the requests of one or more ServiceThreads.
+class ServiceThreadPool final {
+public:
+    explicit ServiceThreadPool(KernelCore& kernel, std::size_t num_threads,
+                               const std::string& thread_name);
+    ~ServiceThreadPool();
+
+    ServiceThreadPool(const ServiceThreadPool&) = delete;
+    ServiceThreadPool& operator=(const ServiceThreadPool&) = delete;
+
+private:
+    friend class ServiceThread;
+
+    class Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+/// Serial queue of service requests executed on a ServiceThreadPool.
+/// Requests queued on the same ServiceThread run in order and never concurrently, while requests
+/// from different ServiceThreads may run in parallel.
 class ServiceThread final {
 public:
-    explicit ServiceThread(KernelCore& kernel, std::size_t num_threads, const std::string& name);
+    explicit ServiceThread(ServiceThreadPool& pool, const std::string& name);
     ~ServiceThread();
 
     void QueueSyncRequest(KSession& session, std::shared_ptr<HLERequestContext>&& context);
 
 private:
+    friend class ServiceThreadPool;
+
     class Impl;
-    std::unique_ptr<Impl> impl;
+    std::shared_ptr<Impl> impl;
 };
 
 } // namespace Kernel
@@ -5,6 +5,7 @@
 #include <cinttypes>
 #include <cstring>
 #include <iterator>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,6 +26,7 @@
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/system_archive/system_archive.h"
 #include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_cached.h"
 #include "core/hle/ipc_helpers.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/service/filesystem/filesystem.h"
@@ -56,10 +58,22 @@ enum class FileSystemType : u8 {
     ApplicationPackage = 7,
 };
 
+/// Clamps a guest read request to the size of its output buffer
+static std::size_t ClampReadLength(s64 length, std::size_t buffer_size) {
+    const auto requested = static_cast<std::size_t>(length);
+    if (requested > buffer_size) {
+        LOG_CRITICAL(Service_FS, "length ({:016X}) is greater than buffer_size ({:016X})",
+                     requested, buffer_size);
+        return buffer_size;
+    }
+    return requested;
+}
+
 class IStorage final : public ServiceFramework<IStorage> {
 public:
     explicit IStorage(Core::System& system_, FileSys::VirtualFile backend_)
-        : ServiceFramework{system_, "IStorage"}, backend(std::move(backend_)) {
+        : ServiceFramework{system_, "IStorage"},
+          backend(std::make_shared<FileSys::CachedVfsFile>(std::move(backend_))) {
         static const FunctionInfo functions[] = {
             {0, &IStorage::Read, "Read"},
             {1, nullptr, "Write"},
@@ -95,10 +109,9 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend straight into the output buffer
+        const std::span<u8> output = ctx.WriteBufferSpan();
+        backend->Read(output.data(), ClampReadLength(length, output.size()), offset);
 
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(ResultSuccess);
@@ -156,15 +169,14 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend straight into the output buffer
+        const std::span<u8> output = ctx.WriteBufferSpan();
+        const std::size_t read_size =
+            backend->Read(output.data(), ClampReadLength(length, output.size()), offset);
 
         IPC::ResponseBuilder rb{ctx, 4};
         rb.Push(ResultSuccess);
-        rb.Push(static_cast<u64>(output.size()));
+        rb.Push(static_cast<u64>(read_size));
     }
 
     void Write(Kernel::HLERequestContext& ctx) {
@@ -190,7 +202,7 @@ private:
             return;
         }
 
-        const std::vector<u8> data = ctx.ReadBuffer();
+        const std::span<const u8> data = ctx.ReadBufferSpan();
 
         ASSERT_MSG(
             static_cast<s64>(data.size()) <= length,
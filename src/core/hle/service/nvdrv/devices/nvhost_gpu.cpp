@@ -3,6 +3,9 @@
 // Refer to the license.txt file included.
 
 #include <cstring>
+
+#include <boost/container/static_vector.hpp>
+
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/core.h"
@@ -228,11 +231,14 @@ NvResult nvhost_gpu::SubmitGPFIFOImpl(IoctlSubmitGpfifo& params, std::vector<u8>
 
     auto& gpu = system.GPU();
 
+    // All the command lists of a submission are handed to the GPU thread as a single batch
+    boost::container::static_vector<Tegra::CommandList, 3> entries_list;
+
     params.fence_out.id = channel_fence.id;
 
     if (params.flags.add_wait.Value() &&
         !syncpoint_manager.IsSyncpointExpired(params.fence_out.id, params.fence_out.value)) {
-        gpu.PushGPUEntries(Tegra::CommandList{BuildWaitCommandList(params.fence_out)});
+        entries_list.emplace_back(BuildWaitCommandList(params.fence_out));
     }
 
     if (params.flags.add_increment.Value() || params.flags.increment.Value()) {
@@ -243,18 +249,20 @@ NvResult nvhost_gpu::SubmitGPFIFOImpl(IoctlSubmitGpfifo& params, std::vector<u8>
         params.fence_out.value = syncpoint_manager.GetSyncpointMax(params.fence_out.id);
     }
 
-    gpu.PushGPUEntries(std::move(entries));
+    entries_list.push_back(std::move(entries));
 
     if (params.flags.add_increment.Value()) {
         if (params.flags.suppress_wfi) {
-            gpu.PushGPUEntries(Tegra::CommandList{
-                BuildIncrementCommandList(params.fence_out, params.AddIncrementValue())});
+            entries_list.emplace_back(
+                BuildIncrementCommandList(params.fence_out, params.AddIncrementValue()));
         } else {
-            gpu.PushGPUEntries(Tegra::CommandList{
-                BuildIncrementWithWfiCommandList(params.fence_out, params.AddIncrementValue())});
+            entries_list.emplace_back(
+                BuildIncrementWithWfiCommandList(params.fence_out, params.AddIncrementValue()));
         }
     }
 
+    gpu.PushGPUEntries(std::span{entries_list.data(), entries_list.size()});
+
     std::memcpy(output.data(), &params, sizeof(IoctlSubmitGpfifo));
     return NvResult::Success;
 }
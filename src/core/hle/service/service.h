@@ -110,7 +110,8 @@ private:
                            Kernel::HLERequestContext& ctx);
 
     explicit ServiceFrameworkBase(Core::System& system_, const char* service_name_,
-                                  u32 max_sessions_, InvokerFn* handler_invoker_);
+                                  Kernel::ServiceThreadType thread_type, u32 max_sessions_,
+                                  InvokerFn* handler_invoker_);
     ~ServiceFrameworkBase() override;
 
     void RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n);
@@ -176,12 +177,16 @@ protected:
      *
      * @param system_       The system context to construct this service under.
      * @param service_name_ Name of the service.
+     * @param thread_type   Specifies the thread type for this service. If this is set to CreateNew,
+     *                      it creates a new thread for it, otherwise this uses the default thread.
      * @param max_sessions_ Maximum number of sessions that can be
      *                      connected to this service at the same time.
      */
-    explicit ServiceFramework(Core::System& system_, const char* service_name_,
-                              u32 max_sessions_ = ServerSessionCountMax)
-        : ServiceFrameworkBase(system_, service_name_, max_sessions_, Invoker) {}
+    explicit ServiceFramework(
+        Core::System& system_, const char* service_name_,
+        Kernel::ServiceThreadType thread_type = Kernel::ServiceThreadType::Default,
+        u32 max_sessions_ = ServerSessionCountMax)
+        : ServiceFrameworkBase(system_, service_name_, thread_type, max_sessions_, Invoker) {}
 
     /// Registers handlers in the service.
     template <std::size_t N>
@@ -9,7 +9,8 @@
 namespace Service::VI {
 
 VI_M::VI_M(Core::System& system_, NVFlinger::NVFlinger& nv_flinger_)
-    : ServiceFramework{system_, "vi:m"}, nv_flinger{nv_flinger_} {
+    : ServiceFramework{system_, "vi:m", Kernel::ServiceThreadType::CreateNew},
+      nv_flinger{nv_flinger_} {
     static const FunctionInfo functions[] = {
         {2, &VI_M::GetDisplayService, "GetDisplayService"},
         {3, nullptr, "GetDisplayServiceWithProxyNameExchange"},
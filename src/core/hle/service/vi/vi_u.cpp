@@ -9,7 +9,8 @@
 namespace Service::VI {
 
 VI_U::VI_U(Core::System& system_, NVFlinger::NVFlinger& nv_flinger_)
-    : ServiceFramework{system_, "vi:u"}, nv_flinger{nv_flinger_} {
+    : ServiceFramework{system_, "vi:u", Kernel::ServiceThreadType::CreateNew},
+      nv_flinger{nv_flinger_} {
     static const FunctionInfo functions[] = {
         {0, &VI_U::GetDisplayService, "GetDisplayService"},
         {1, nullptr, "GetDisplayServiceWithProxyNameExchange"},
@@ -4,6 +4,7 @@
 
 #include <cinttypes>
 #include <cstring>
+#include <vector>
 #include "common/common_funcs.h"
 #include "common/logging/log.h"
 #include "core/core.h"
@@ -131,8 +132,9 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
     const auto static_modules = {"rtld",    "main",    "subsdk0", "subsdk1", "subsdk2", "subsdk3",
                                  "subsdk4", "subsdk5", "subsdk6", "subsdk7", "sdk"};
 
-    // Use the NSO module loader to figure out the code layout
-    std::size_t code_size{};
+    // Read every module before decompressing any of them, so that the segments of all modules can
+    // be decompressed in parallel while the file system is only accessed from this thread
+    std::vector<NSOImage> images;
     for (const auto& module : static_modules) {
         const FileSys::VirtualFile module_file{dir->GetFile(module)};
         if (!module_file) {
@@ -140,16 +142,23 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
         }
 
         const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
-        const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
-            process, system, *module_file, code_size, should_pass_arguments, false);
-        if (!tentative_next_load_addr) {
+        auto image = AppLoader_NSO::ReadModule(*module_file, should_pass_arguments);
+        if (!image) {
             return {ResultStatus::ErrorLoadingNSO, {}};
         }
+        image->name = module;
+        images.push_back(std::move(*image));
+    }
 
-        code_size = *tentative_next_load_addr;
+    if (!AppLoader_NSO::DecompressModules(images)) {
+        return {ResultStatus::ErrorLoadingNSO, {}};
     }
 
     // Setup the process code layout
+    std::size_t code_size{};
+    for (const NSOImage& image : images) {
+        code_size += image.codeset.memory.size();
+    }
     if (process.LoadFromMetadata(metadata, code_size).IsError()) {
         return {ResultStatus::ErrorUnableToParseKernelMetadata, {}};
     }
@@ -160,21 +169,11 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
     VAddr next_load_addr{base_address};
     const FileSys::PatchManager pm{metadata.GetTitleID(), system.GetFileSystemController(),
                                    system.GetContentProvider()};
-    for (const auto& module : static_modules) {
-        const FileSys::VirtualFile module_file{dir->GetFile(module)};
-        if (!module_file) {
-            continue;
-        }
-
+    for (NSOImage& image : images) {
         const VAddr load_addr{next_load_addr};
-        const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
-        const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
-            process, system, *module_file, load_addr, should_pass_arguments, true, pm);
-        if (!tentative_next_load_addr) {
-            return {ResultStatus::ErrorLoadingNSO, {}};
-        }
-
-        next_load_addr = *tentative_next_load_addr;
+        const std::string module = image.name;
+        next_load_addr =
+            AppLoader_NSO::LoadModule(process, system, std::move(image), load_addr, true, pm);
         modules.insert_or_assign(load_addr, module);
         LOG_DEBUG(Loader, "loaded module {} @ 0x{:X}", module, load_addr);
     }
@@ -2,14 +2,18 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <atomic>
 #include <cinttypes>
 #include <cstring>
+#include <utility>
 #include <vector>
 
 #include "common/common_funcs.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
 #include "common/lz4_compression.h"
+#include "common/parallel_for.h"
 #include "common/settings.h"
 #include "common/swap.h"
 #include "core/core.h"
@@ -34,17 +38,6 @@ struct MODHeader {
 };
 static_assert(sizeof(MODHeader) == 0x1c, "MODHeader has incorrect size.");
 
-std::vector<u8> DecompressSegment(const std::vector<u8>& compressed_data,
-                                  const NSOSegmentHeader& header) {
-    std::vector<u8> uncompressed_data =
-        Common::Compression::DecompressDataLZ4(compressed_data, header.size);
-
-    ASSERT_MSG(uncompressed_data.size() == header.size, "{} != {}", header.size,
-               uncompressed_data.size());
-
-    return uncompressed_data;
-}
-
 constexpr u32 PageAlignSize(u32 size) {
     return static_cast<u32>((size + Core::Memory::PAGE_MASK) & ~Core::Memory::PAGE_MASK);
 }
@@ -74,6 +67,16 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
                                                const FileSys::VfsFile& nso_file, VAddr load_base,
                                                bool should_pass_arguments, bool load_into_process,
                                                std::optional<FileSys::PatchManager> pm) {
+    std::optional<NSOImage> image = ReadModule(nso_file, should_pass_arguments);
+    if (!image || !DecompressModules({&*image, 1})) {
+        return std::nullopt;
+    }
+    return LoadModule(process, system, std::move(*image), load_base, load_into_process,
+                      std::move(pm));
+}
+
+std::optional<NSOImage> AppLoader_NSO::ReadModule(const FileSys::VfsFile& nso_file,
+                                                  bool should_pass_arguments) {
     if (nso_file.GetSize() < sizeof(NSOHeader)) {
         return std::nullopt;
     }
@@ -87,21 +90,36 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
         return std::nullopt;
     }
 
+    NSOImage image;
+    image.name = nso_file.GetName();
+    image.header = nso_header;
+    Kernel::CodeSet& codeset = image.codeset;
+
+    // Size the program image up front, so that segments can be placed directly into it
+    std::size_t segments_end = 0;
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        const NSOSegmentHeader& segment = nso_header.segments[i];
+        const u32 data_size = nso_header.IsSegmentCompressed(i)
+                                  ? segment.size
+                                  : nso_header.segments_compressed_size[i];
+        segments_end = std::max<std::size_t>(segments_end, segment.location + data_size);
+
+        codeset.segments[i].addr = segment.location;
+        codeset.segments[i].offset = segment.location;
+        codeset.segments[i].size = segment.size;
+    }
+
     // Build program image
-    Kernel::CodeSet codeset;
-    Kernel::PhysicalMemory program_image;
+    Kernel::PhysicalMemory program_image(segments_end);
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data = nso_file.ReadBytes(nso_header.segments_compressed_size[i],
-                                                  nso_header.segments[i].offset);
+        const NSOSegmentHeader& segment = nso_header.segments[i];
         if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
+            image.compressed_segments[i] =
+                nso_file.ReadBytes(nso_header.segments_compressed_size[i], segment.offset);
+        } else {
+            nso_file.Read(program_image.data() + segment.location,
+                          nso_header.segments_compressed_size[i], segment.offset);
         }
-        program_image.resize(nso_header.segments[i].location + static_cast<u32>(data.size()));
-        std::memcpy(program_image.data() + nso_header.segments[i].location, data.data(),
-                    data.size());
-        codeset.segments[i].addr = nso_header.segments[i].location;
-        codeset.segments[i].offset = nso_header.segments[i].location;
-        codeset.segments[i].size = nso_header.segments[i].size;
     }
 
     if (should_pass_arguments && !Settings::values.program_args.GetValue().empty()) {
@@ -127,15 +145,53 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
         codeset.segments[i].size = PageAlignSize(codeset.segments[i].size);
     }
 
+    codeset.memory = std::move(program_image);
+    return image;
+}
+
+bool AppLoader_NSO::DecompressModules(std::span<NSOImage> images) {
+    std::vector<std::pair<NSOImage*, std::size_t>> pending_segments;
+    for (NSOImage& image : images) {
+        for (std::size_t i = 0; i < image.header.segments.size(); ++i) {
+            if (image.header.IsSegmentCompressed(i)) {
+                pending_segments.emplace_back(&image, i);
+            }
+        }
+    }
+
+    std::atomic<bool> success{true};
+    Common::ParallelFor(pending_segments.size(), [&](std::size_t index) {
+        auto& [image, segment_index] = pending_segments[index];
+        const NSOSegmentHeader& segment = image->header.segments[segment_index];
+        const std::span<u8> destination{image->codeset.memory.data() + segment.location,
+                                        segment.size};
+        if (!Common::Compression::DecompressDataLZ4(image->compressed_segments[segment_index],
+                                                    destination)) {
+            LOG_ERROR(Loader, "Failed to decompress segment {} of module {}", segment_index,
+                      image->name);
+            success = false;
+        }
+        image->compressed_segments[segment_index] = {};
+    });
+    return success;
+}
+
+VAddr AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::System& system, NSOImage&& image,
+                                VAddr load_base, bool load_into_process,
+                                std::optional<FileSys::PatchManager> pm) {
+    const NSOHeader& nso_header = image.header;
+    Kernel::PhysicalMemory& program_image = image.codeset.memory;
+    const std::size_t image_size = program_image.size();
+
     // Apply patches if necessary
     if (pm && (pm->HasNSOPatch(nso_header.build_id) || Settings::values.dump_nso)) {
         std::vector<u8> pi_header;
-        pi_header.insert(pi_header.begin(), reinterpret_cast<u8*>(&nso_header),
-                         reinterpret_cast<u8*>(&nso_header) + sizeof(NSOHeader));
+        pi_header.insert(pi_header.begin(), reinterpret_cast<const u8*>(&nso_header),
+                         reinterpret_cast<const u8*>(&nso_header) + sizeof(NSOHeader));
         pi_header.insert(pi_header.begin() + sizeof(NSOHeader), program_image.data(),
                          program_image.data() + program_image.size());
 
-        pi_header = pm->PatchNSO(pi_header, nso_file.GetName());
+        pi_header = pm->PatchNSO(pi_header, image.name);
 
         std::copy(pi_header.begin() + sizeof(NSOHeader), pi_header.end(), program_image.data());
     }
@@ -155,8 +211,7 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
     }
 
     // Load codeset for current process
-    codeset.memory = std::move(program_image);
-    process.LoadModule(std::move(codeset), load_base);
+    process.LoadModule(std::move(image.codeset), load_base);
 
     return load_base + image_size;
 }
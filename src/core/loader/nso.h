@@ -6,10 +6,14 @@
 
 #include <array>
 #include <optional>
+#include <span>
+#include <string>
 #include <type_traits>
+#include <vector>
 #include "common/common_types.h"
 #include "common/swap.h"
 #include "core/file_sys/patch_manager.h"
+#include "core/hle/kernel/code_set.h"
 #include "core/loader/loader.h"
 
 namespace Core {
@@ -68,6 +72,18 @@ struct NSOArgumentHeader {
 };
 static_assert(sizeof(NSOArgumentHeader) == 0x20, "NSOArgumentHeader has incorrect size.");
 
+/// An NSO module laid out in memory, ready to be patched and loaded into a process
+struct NSOImage {
+    std::string name;
+    NSOHeader header{};
+
+    /// Code layout of the module, its memory holds the whole program image including .bss
+    Kernel::CodeSet codeset;
+
+    /// Segments waiting to be decompressed into the program image
+    std::array<std::vector<u8>, 3> compressed_segments;
+};
+
 /// Loads an NSO file
 class AppLoader_NSO final : public AppLoader {
 public:
@@ -91,6 +107,32 @@ public:
                                            bool should_pass_arguments, bool load_into_process,
                                            std::optional<FileSys::PatchManager> pm = {});
 
+    /**
+     * Reads an NSO and lays out its program image. Uncompressed segments are read in place, the
+     * compressed ones are only read, so that the file is never accessed from several threads.
+     *
+     * @return the image, or std::nullopt if the file is not a valid NSO.
+     */
+    static std::optional<NSOImage> ReadModule(const FileSys::VfsFile& nso_file,
+                                              bool should_pass_arguments);
+
+    /**
+     * Decompresses the pending segments of the given images straight into their program images,
+     * spreading the segments of all the images over the host cores.
+     *
+     * @return false if any of the segments failed to decompress.
+     */
+    static bool DecompressModules(std::span<NSOImage> images);
+
+    /**
+     * Applies patches to a decompressed image and loads it into the process.
+     *
+     * @return the address following the loaded image.
+     */
+    static VAddr LoadModule(Kernel::KProcess& process, Core::System& system, NSOImage&& image,
+                            VAddr load_base, bool load_into_process,
+                            std::optional<FileSys::PatchManager> pm = {});
+
     LoadResult Load(Kernel::KProcess& process, Core::System& system) override;
 
     ResultStatus ReadNSOModules(Modules& out_modules) override;
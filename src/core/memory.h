@@ -141,6 +141,19 @@ public:
         return reinterpret_cast<T*>(GetPointer(vaddr));
     }
 
+    /**
+     * Gets a pointer to a range of the current process' address space, if the whole range is
+     * backed by contiguous host memory that can be accessed directly.
+     *
+     * @param vaddr Virtual address of the start of the range.
+     * @param size  Size of the range, in bytes.
+     *
+     * @returns The pointer to the start of the range. nullptr if the range is empty, crosses
+     *          unmapped or rasterizer cached memory, or is not contiguous in host memory,
+     *          in which case it has to be accessed through ReadBlock and WriteBlock.
+     */
+    u8* GetContiguousPointer(VAddr vaddr, std::size_t size);
+
     /**
      * Reads an 8-bit unsigned value from the current process' address space
      * at the given virtual address.
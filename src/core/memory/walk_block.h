@@ -0,0 +1,80 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "common/assert.h"
+#include "common/common_types.h"
+#include "common/page_table.h"
+#include "core/memory.h"
+
+namespace Core::Memory {
+
+/**
+ * Walks the virtual range [addr, addr + size), invoking a callback once per run of pages.
+ * Adjacent pages are coalesced into a single run when they share the same page type and
+ * backing address, which means the whole run is contiguous in host memory and can be
+ * serviced with a single memcpy/memset.
+ *
+ * @param page_table    The page table to walk.
+ * @param addr          The virtual address to begin walking at.
+ * @param size          The total size of the range in bytes.
+ * @param on_unmapped   Called with (copy_amount, vaddr) for unmapped runs.
+ * @param on_memory     Called with (copy_amount, host_ptr) for runs of regular memory.
+ * @param on_rasterizer Called with (vaddr, copy_amount) for rasterizer cached runs.
+ * @param increment     Called with (copy_amount) after each run has been processed.
+ */
+template <typename OnUnmapped, typename OnMemory, typename OnRasterizer, typename Increment>
+void WalkBlock(const Common::PageTable& page_table, const VAddr addr, const std::size_t size,
+               OnUnmapped&& on_unmapped, OnMemory&& on_memory, OnRasterizer&& on_rasterizer,
+               Increment&& increment) {
+    std::size_t remaining_size = size;
+    std::size_t page_index = addr >> PAGE_BITS;
+    std::size_t page_offset = addr & PAGE_MASK;
+
+    while (remaining_size > 0) {
+        const auto [pointer, type] = page_table.pointers[page_index].PointerType();
+        const u64 backing_addr = page_table.backing_addr[page_index];
+        const auto current_vaddr = static_cast<VAddr>((page_index << PAGE_BITS) + page_offset);
+
+        std::size_t copy_amount =
+            std::min(static_cast<std::size_t>(PAGE_SIZE) - page_offset, remaining_size);
+        std::size_t next_page = page_index + 1;
+        while (copy_amount < remaining_size && page_table.pointers[next_page].Type() == type &&
+               page_table.backing_addr[next_page] == backing_addr) {
+            copy_amount +=
+                std::min(static_cast<std::size_t>(PAGE_SIZE), remaining_size - copy_amount);
+            ++next_page;
+        }
+
+        switch (type) {
+        case Common::PageType::Unmapped: {
+            on_unmapped(copy_amount, current_vaddr);
+            break;
+        }
+        case Common::PageType::Memory: {
+            DEBUG_ASSERT(pointer);
+            u8* const host_ptr = pointer + current_vaddr;
+            on_memory(copy_amount, host_ptr);
+            break;
+        }
+        case Common::PageType::RasterizerCachedMemory: {
+            on_rasterizer(current_vaddr, copy_amount);
+            break;
+        }
+        default:
+            UNREACHABLE();
+        }
+
+        page_index = next_page;
+        page_offset = 0;
+        increment(copy_amount);
+        remaining_size -= copy_amount;
+    }
+}
+
+} // namespace Core::Memory
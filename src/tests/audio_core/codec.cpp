@@ -0,0 +1,102 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "audio_core/codec.h"
+#include "common/common_types.h"
+
+namespace AudioCore::Codec {
+
+namespace {
+// Covers the sizes around the vector width and the channel counts with and without a fast path
+constexpr std::array<std::size_t, 7> SAMPLE_COUNTS{0, 1, 3, 4, 5, 9, 240};
+constexpr std::array<std::size_t, 3> CHANNEL_COUNTS{1, 2, 6};
+
+template <typename T>
+void TestDecodePCM(std::vector<T> (*make_input)(std::mt19937&, std::size_t),
+                   s32 (*reference)(T)) {
+    std::mt19937 engine{0x70636D};
+    for (const std::size_t count : SAMPLE_COUNTS) {
+        for (const std::size_t channel_count : CHANNEL_COUNTS) {
+            const std::vector<T> input = make_input(engine, count * channel_count);
+            for (std::size_t channel = 0; channel < channel_count; ++channel) {
+                std::vector<s32> expected(count);
+                for (std::size_t i = 0; i < count; ++i) {
+                    expected[i] = reference(input[i * channel_count + channel]);
+                }
+                std::vector<s32> output(count);
+                DecodePCM<T>(output, input, channel_count, channel);
+                REQUIRE(output == expected);
+            }
+        }
+    }
+}
+
+template <typename T>
+std::vector<T> RandomIntegers(std::mt19937& engine, std::size_t count) {
+    std::uniform_int_distribution<s32> distribution(std::numeric_limits<T>::min(),
+                                                    std::numeric_limits<T>::max());
+    std::vector<T> samples(count);
+    for (T& sample : samples) {
+        sample = static_cast<T>(distribution(engine));
+    }
+    return samples;
+}
+
+std::vector<f32> RandomFloats(std::mt19937& engine, std::size_t count) {
+    std::uniform_real_distribution<f32> distribution(-1.0f, 1.0f);
+    std::vector<f32> samples(count);
+    for (f32& sample : samples) {
+        sample = distribution(engine);
+    }
+    return samples;
+}
+} // Anonymous namespace
+
+TEST_CASE("Codec[DecodePCM]", "[audio_core]") {
+    TestDecodePCM<s8>(RandomIntegers<s8>, [](s8 sample) { return sample * 256; });
+    TestDecodePCM<s16>(RandomIntegers<s16>, [](s16 sample) { return static_cast<s32>(sample); });
+    TestDecodePCM<s32>(RandomIntegers<s32>, [](s32 sample) { return sample >> 16; });
+    TestDecodePCM<f32>(RandomFloats, [](f32 sample) { return static_cast<s32>(sample * 32767); });
+}
+
+TEST_CASE("Codec[DecodeADPCMFrame]", "[audio_core]") {
+    std::mt19937 engine{0x6164706D};
+    std::uniform_int_distribution<s32> byte(0, 0xFF);
+    std::uniform_int_distribution<s32> coefficient(-0x1000, 0x1000);
+
+    ADPCM_Coeff coeff;
+    for (s16& value : coeff) {
+        value = static_cast<s16>(coefficient(engine));
+    }
+    ADPCMState state{0, 0};
+    ADPCMState expected_state{0, 0};
+    for (int iteration = 0; iteration < 256; ++iteration) {
+        std::array<u8, ADPCM_FRAME_SIZE> frame;
+        for (u8& value : frame) {
+            value = static_cast<u8>(byte(engine));
+        }
+
+        std::array<s32, ADPCM_SAMPLES_PER_FRAME> expected;
+        for (std::size_t i = 0; i < ADPCM_SAMPLES_PER_FRAME; ++i) {
+            const u8 data = frame[i / 2 + 1];
+            const s32 nibble = i % 2 == 0 ? data >> 4 : data & 0xF;
+            expected[i] = DecodeADPCMSample(nibble >= 8 ? nibble - 16 : nibble, frame[0], coeff,
+                                            expected_state);
+        }
+        std::array<s32, ADPCM_SAMPLES_PER_FRAME> output;
+        DecodeADPCMFrame(output.data(), frame.data(), coeff, state);
+        REQUIRE(output == expected);
+        REQUIRE(state.yn1 == expected_state.yn1);
+        REQUIRE(state.yn2 == expected_state.yn2);
+    }
+}
+
+} // namespace AudioCore::Codec
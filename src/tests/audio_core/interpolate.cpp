@@ -0,0 +1,125 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "audio_core/algorithm/interpolate.h"
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+#ifdef ARCHITECTURE_x86_64
+namespace {
+std::vector<s32> RandomSamples(std::mt19937& engine, std::size_t count) {
+    std::uniform_int_distribution<s32> distribution(-0x8000, 0x7FFF);
+    std::vector<s32> samples(count);
+    for (s32& sample : samples) {
+        sample = distribution(engine);
+    }
+    return samples;
+}
+} // Anonymous namespace
+
+TEST_CASE("Interpolate[Resample]", "[audio_core]") {
+    if (!SSE41::IsSupported()) {
+        return;
+    }
+    // Pitches around the boundaries between the three filter curves
+    constexpr std::array<s32, 7> pitches{0x1000, 0x7FFF, 0x8000, 0x8001, 0xAAAA, 0xAAAB, 0x17FFF};
+    constexpr std::array<std::size_t, 7> sample_counts{0, 1, 3, 4, 5, 17, 240};
+
+    std::mt19937 engine{0x72657361};
+    std::uniform_int_distribution<s32> fraction_distribution(0, 0x7FFF);
+    for (int iteration = 0; iteration < 16; ++iteration) {
+        for (const s32 pitch : pitches) {
+            for (const std::size_t count : sample_counts) {
+                const s32 fraction = fraction_distribution(engine);
+                const auto input_size = static_cast<std::size_t>(
+                    ((fraction + pitch * static_cast<s32>(count)) >> 15) + 4);
+                const std::vector<s32> input = RandomSamples(engine, input_size);
+
+                std::vector<s32> expected(count);
+                std::vector<s32> output(count);
+                s32 expected_fraction = fraction;
+                s32 output_fraction = fraction;
+                Scalar::Resample(expected, input, pitch, expected_fraction);
+                SSE41::Resample(output, input, pitch, output_fraction);
+                REQUIRE(output == expected);
+                REQUIRE(output_fraction == expected_fraction);
+            }
+        }
+    }
+}
+#endif
+
+TEST_CASE("Interpolate[Expected]", "[audio_core]") {
+    // Output of the original vector implementation, for two consecutive blocks of the same input.
+    // Each ratio picks a different filter curve.
+    struct Case {
+        double ratio;
+        std::array<std::vector<s16>, 2> blocks;
+    };
+    const std::array<Case, 3> cases{{
+        {0.5,
+         {{{34, 17, 34, 17, 34, 17, -8877, -4892, -8877, -4892, -9982, -1568,
+            -9982, -1568, 7594, 18562, 7594, 18562, 26612, -913, 26612, -913, 7137, -21115,
+            7137, -21115, -13066, -2026, -13066, -2026, 6024, 16992, 6024, 16992},
+           {24902, -2622, 24902, -2622, 7121, -21131, 7121, -21131, -11353, -313, -11353, -313,
+            7594, 18562, 7594, 18562, 26612, -913, 26612, -913, 7137, -21115, 7137, -21115,
+            -13066, -2026, -13066, -2026, 6024, 16992, 6024, 16992}}}},
+        {1.25,
+         {{{-1598, -818, -11736, -5919, -8782, -700, 3558, 11957, 25184, -19390, -6442, 1971, 5987,
+            14659},
+           {18373, 8539, -10144, -8802, 11526, 18778, 24221, -985, 18113, -21145, -2049, 6014}}}},
+        {1.5,
+         {{{-3300, -1690, -7547, -3573, -450, 7542, 21073, -1066, -4548, -9999, 5978, 11525},
+           {17388, -13471, -6030, -573, 15533, 10326, 6923, -15457, -2006, 5981}}}},
+    }};
+
+    std::vector<s16> input(16);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<s16>(static_cast<s32>(i) * 0x1F3D - 0x4000);
+    }
+
+    for (const Case& test : cases) {
+        InterpolationState vector_state;
+        InterpolationState span_state;
+        for (const std::vector<s16>& expected : test.blocks) {
+            REQUIRE(Interpolate(vector_state, input, test.ratio) == expected);
+
+            std::vector<s16> output(InterpolatedSize(input.size(), test.ratio));
+            output.resize(Interpolate(span_state, input, output, test.ratio));
+            REQUIRE(output == expected);
+        }
+    }
+}
+
+TEST_CASE("Interpolate[OutputBound]", "[audio_core]") {
+    // Upsampling carries the position over between calls, the output of every call has to fit
+    // in InterpolatedSize regardless of where the previous one left off
+    constexpr s16 GUARD = 0x5A5A;
+    constexpr std::size_t GUARD_SIZE = 16;
+    const std::vector<s16> input(2 * 67, 0x100);
+
+    for (const double ratio : {0.1, 0.3, 0.5, 0.75, 0.9999}) {
+        InterpolationState state;
+        for (std::size_t frames = 1; frames < input.size() / 2; frames += 3) {
+            const std::span<const s16> block{input.data(), frames * 2};
+            const std::size_t max_size = InterpolatedSize(block.size(), ratio);
+            std::vector<s16> output(max_size + GUARD_SIZE, GUARD);
+
+            const std::size_t size = Interpolate(state, block, output, ratio);
+            REQUIRE(size <= max_size);
+            REQUIRE(std::all_of(output.begin() + max_size, output.end(),
+                                [](s16 sample) { return sample == GUARD; }));
+        }
+    }
+}
+
+} // namespace AudioCore
@@ -0,0 +1,138 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "audio_core/algorithm/mix.h"
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+namespace {
+struct Backend {
+    std::string name;
+    void (*apply_mix)(std::span<s32>, std::span<const s32>, s32, s32);
+    void (*apply_gain)(std::span<s32>, std::span<const s32>, s32, s32, s32);
+    void (*apply_gain_without_delta)(std::span<s32>, std::span<const s32>, s32, s32);
+};
+
+std::vector<Backend> GetVectorBackends() {
+    std::vector<Backend> backends;
+#ifdef ARCHITECTURE_x86_64
+    if (SSE41::IsSupported()) {
+        backends.push_back({"SSE4.1", SSE41::ApplyMix, SSE41::ApplyGain,
+                            SSE41::ApplyGainWithoutDelta});
+    }
+    if (AVX2::IsSupported()) {
+        backends.push_back(
+            {"AVX2", AVX2::ApplyMix, AVX2::ApplyGain, AVX2::ApplyGainWithoutDelta});
+    }
+#endif
+    return backends;
+}
+
+// Covers the empty buffer, counts around the vector widths and the renderer's frame sizes
+constexpr std::array<s32, 11> SAMPLE_COUNTS{0, 1, 3, 4, 5, 7, 8, 9, 17, 160, 240};
+
+class Fuzzer {
+public:
+    std::vector<s32> Samples(s32 count) {
+        // Alternate between full range values and ones in the range of actual PCM samples
+        std::uniform_int_distribution<s32> full;
+        std::uniform_int_distribution<s32> pcm(-0x800000, 0x7FFFFF);
+        const bool use_full = full(engine) & 1;
+        std::vector<s32> samples(static_cast<std::size_t>(count));
+        for (s32& sample : samples) {
+            sample = use_full ? full(engine) : pcm(engine);
+        }
+        return samples;
+    }
+
+    s32 Gain() {
+        constexpr std::array<s32, 6> edge_cases{0,       1,       -1,
+                                                0x8000,  std::numeric_limits<s32>::max(),
+                                                std::numeric_limits<s32>::min()};
+        std::uniform_int_distribution<std::size_t> pick(0, edge_cases.size() * 2);
+        const std::size_t index = pick(engine);
+        if (index < edge_cases.size()) {
+            return edge_cases[index];
+        }
+        return std::uniform_int_distribution<s32>{}(engine);
+    }
+
+private:
+    std::mt19937 engine{0x6175646F};
+};
+} // Anonymous namespace
+
+TEST_CASE("Mix[ApplyMix]", "[audio_core]") {
+    Fuzzer fuzzer;
+    for (const Backend& backend : GetVectorBackends()) {
+        INFO(backend.name);
+        for (int iteration = 0; iteration < 64; ++iteration) {
+            for (const s32 count : SAMPLE_COUNTS) {
+                const std::vector<s32> input = fuzzer.Samples(count);
+                const s32 gain = fuzzer.Gain();
+                std::vector<s32> expected = fuzzer.Samples(count);
+                std::vector<s32> output = expected;
+
+                Scalar::ApplyMix(expected, input, gain, count);
+                backend.apply_mix(output, input, gain, count);
+                REQUIRE(output == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Mix[ApplyGain]", "[audio_core]") {
+    Fuzzer fuzzer;
+    for (const Backend& backend : GetVectorBackends()) {
+        INFO(backend.name);
+        for (int iteration = 0; iteration < 64; ++iteration) {
+            for (const s32 count : SAMPLE_COUNTS) {
+                const std::vector<s32> input = fuzzer.Samples(count);
+                const s32 gain = fuzzer.Gain();
+                const s32 delta = fuzzer.Gain();
+                std::vector<s32> expected(input.size());
+                std::vector<s32> output(input.size());
+
+                Scalar::ApplyGain(expected, input, gain, delta, count);
+                backend.apply_gain(output, input, gain, delta, count);
+                REQUIRE(output == expected);
+
+                // The renderer applies the gain in place
+                output = input;
+                backend.apply_gain(output, output, gain, delta, count);
+                REQUIRE(output == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Mix[ApplyGainWithoutDelta]", "[audio_core]") {
+    Fuzzer fuzzer;
+    for (const Backend& backend : GetVectorBackends()) {
+        INFO(backend.name);
+        for (int iteration = 0; iteration < 64; ++iteration) {
+            for (const s32 count : SAMPLE_COUNTS) {
+                const std::vector<s32> input = fuzzer.Samples(count);
+                const s32 gain = fuzzer.Gain();
+                std::vector<s32> expected(input.size());
+                std::vector<s32> output(input.size());
+
+                Scalar::ApplyGainWithoutDelta(expected, input, gain, count);
+                backend.apply_gain_without_delta(output, input, gain, count);
+                REQUIRE(output == expected);
+            }
+        }
+    }
+}
+
+} // namespace AudioCore
@@ -0,0 +1,56 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "audio_core/sink_ring_buffer.h"
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+TEST_CASE("SinkRingBuffer[Underrun]", "[audio_core]") {
+    SinkRingBuffer queue{2};
+    const std::vector<s16> samples{1, 2, 3, 4};
+    queue.Push(2, samples);
+    REQUIRE(queue.Size() == 4U);
+
+    // Missing frames repeat the last frame played
+    std::array<s16, 8> output{};
+    queue.Pop(output);
+    REQUIRE(output == std::array<s16, 8>{1, 2, 3, 4, 3, 4, 3, 4});
+    REQUIRE(queue.Size() == 0U);
+
+    queue.Pop(output);
+    REQUIRE(output == std::array<s16, 8>{3, 4, 3, 4, 3, 4, 3, 4});
+}
+
+TEST_CASE("SinkRingBuffer[Downmix]", "[audio_core]") {
+    SinkRingBuffer queue{2};
+    // Enough frames to go through several downmix chunks
+    std::vector<s16> samples;
+    for (s16 frame = 0; frame < 1000; frame++) {
+        const std::array<s16, 6> channels{frame, static_cast<s16>(-frame), 1000, 0, 100, -100};
+        samples.insert(samples.end(), channels.begin(), channels.end());
+    }
+    queue.Push(6, samples);
+    REQUIRE(queue.Size() == 2000U);
+
+    std::vector<s16> output(2000);
+    queue.Pop(output);
+    for (s16 frame = 0; frame < 1000; frame++) {
+        REQUIRE(output[frame * 2 + 0] == frame + 707 + 70);
+        REQUIRE(output[frame * 2 + 1] == -frame + 707 - 70);
+    }
+}
+
+TEST_CASE("SinkRingBuffer[Overflow]", "[audio_core]") {
+    SinkRingBuffer queue{6};
+    // Only whole frames are queued when the samples do not all fit
+    const std::vector<s16> samples(0x10000 + 6);
+    queue.Push(6, samples);
+    REQUIRE(queue.Size() == 0x10000 / 6 * 6);
+}
+
+} // namespace AudioCore
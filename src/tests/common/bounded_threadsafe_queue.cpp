@@ -0,0 +1,84 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/bounded_threadsafe_queue.h"
+
+namespace Common {
+
+TEST_CASE("BoundedSPSCQueue: Basic Tests", "[common]") {
+    BoundedSPSCQueue<int, 4> queue;
+    REQUIRE(queue.Empty());
+
+    // Staged elements must not be visible until published
+    queue.Stage(1);
+    queue.Stage(2);
+    REQUIRE(queue.Empty());
+    int value{};
+    REQUIRE(!queue.TryPop(value));
+
+    queue.Publish();
+    REQUIRE(queue.Size() == 2U);
+
+    queue.Push(3);
+    queue.Push(4);
+    REQUIRE(queue.Size() == 4U);
+
+    for (int i = 1; i <= 4; ++i) {
+        REQUIRE(queue.TryPop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE(queue.Empty());
+    REQUIRE(!queue.TryPop(value));
+
+    // Indices wrap around the end of the storage
+    queue.Push(5);
+    REQUIRE(queue.PopWait() == 5);
+}
+
+TEST_CASE("BoundedSPSCQueue: Move only elements", "[common]") {
+    BoundedSPSCQueue<std::unique_ptr<int>, 2> queue;
+    queue.Push(std::make_unique<int>(42));
+    const std::unique_ptr<int> value = queue.PopWait();
+    REQUIRE(value);
+    REQUIRE(*value == 42);
+}
+
+TEST_CASE("BoundedSPSCQueue: Threaded Test", "[common]") {
+    constexpr std::size_t count = 100000;
+    BoundedSPSCQueue<std::vector<std::size_t>, 64> queue;
+
+    std::thread producer{[&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            // Alternate between single pushes and batches to exercise both paths
+            if (i % 3 == 0) {
+                queue.Push(std::vector<std::size_t>{i});
+            } else {
+                queue.Stage(std::vector<std::size_t>{i});
+                if (i % 3 == 2) {
+                    queue.Publish();
+                }
+            }
+        }
+        queue.Publish();
+    }};
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::vector<std::size_t> value = queue.PopWait();
+        if (value.size() != 1 || value[0] != i) {
+            ++mismatches;
+        }
+    }
+    producer.join();
+
+    REQUIRE(mismatches == 0);
+    REQUIRE(queue.Empty());
+}
+
+} // namespace Common
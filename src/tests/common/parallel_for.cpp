@@ -0,0 +1,72 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/parallel_for.h"
+
+namespace Common {
+
+TEST_CASE("ParallelFor: Empty Range", "[common]") {
+    std::size_t num_calls = 0;
+    ParallelFor(0, [&num_calls](std::size_t) { ++num_calls; });
+    REQUIRE(num_calls == 0);
+}
+
+TEST_CASE("ParallelFor: Single Item", "[common]") {
+    // A single item is processed by the calling thread
+    const std::thread::id caller = std::this_thread::get_id();
+    std::vector<std::size_t> indices;
+    std::thread::id worker;
+    ParallelFor(1, [&](std::size_t index) {
+        indices.push_back(index);
+        worker = std::this_thread::get_id();
+    });
+    REQUIRE(indices == std::vector<std::size_t>{0});
+    REQUIRE(worker == caller);
+}
+
+TEST_CASE("ParallelFor: Every Index Once", "[common]") {
+    constexpr std::size_t count = 10000;
+    std::vector<std::atomic<int>> calls(count);
+    for (int iteration = 0; iteration < 16; ++iteration) {
+        ParallelFor(count, [&calls](std::size_t index) { ++calls[index]; });
+    }
+    for (const auto& num_calls : calls) {
+        REQUIRE(num_calls == 16);
+    }
+}
+
+TEST_CASE("ParallelFor: Nested", "[common]") {
+    // Inner calls made from the pool must not wait for the pool to become idle
+    constexpr std::size_t count = 64;
+    std::atomic<std::size_t> num_calls{0};
+    ParallelFor(count, [&num_calls](std::size_t) {
+        ParallelFor(count, [&num_calls](std::size_t) { ++num_calls; });
+    });
+    REQUIRE(num_calls == count * count);
+}
+
+TEST_CASE("ParallelFor: Exception", "[common]") {
+    std::atomic<std::size_t> num_calls{0};
+    REQUIRE_THROWS_AS(ParallelFor(1000,
+                                  [&num_calls](std::size_t index) {
+                                      ++num_calls;
+                                      if (index == 10) {
+                                          throw std::runtime_error("failure");
+                                      }
+                                  }),
+                      std::runtime_error);
+
+    // The pool is still usable afterwards
+    std::atomic<std::size_t> num_calls_after{0};
+    ParallelFor(100, [&num_calls_after](std::size_t) { ++num_calls_after; });
+    REQUIRE(num_calls_after == 100);
+}
+
+} // namespace Common
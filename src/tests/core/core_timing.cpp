@@ -10,6 +10,7 @@
 #include <cstdlib>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -144,3 +145,100 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
     printf("HostTimer No Pausing Timer Time: %.3f %.6f\n", timer_time / 1000.f,
            timer_time / 1000000.f);
 }
+
+TEST_CASE("CoreTiming[ManyEvents]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    constexpr std::size_t num_types = 64;
+    constexpr std::size_t num_events = 4096;
+
+    std::vector<std::uintptr_t> fired;
+    fired.reserve(num_events);
+    std::vector<std::shared_ptr<Core::Timing::EventType>> events;
+    for (std::size_t i = 0; i < num_types; i++) {
+        events.push_back(Core::Timing::CreateEvent(
+            "callback" + std::to_string(i),
+            [&fired](std::uintptr_t user_data, std::chrono::nanoseconds) {
+                fired.push_back(user_data);
+            }));
+    }
+
+    core_timing.SyncPause(true);
+
+    const u64 schedule_start = core_timing.GetGlobalTimeNs().count();
+    for (std::size_t i = 0; i < num_events; i++) {
+        const auto future_ns = std::chrono::nanoseconds{static_cast<s64>(i * 1000 + 100)};
+        core_timing.ScheduleEvent(future_ns, events[i % num_types], i);
+    }
+    const u64 schedule_end = core_timing.GetGlobalTimeNs().count();
+
+    // Unschedule every odd event, the remaining ones must still fire in order
+    for (std::size_t i = 1; i < num_events; i += 2) {
+        core_timing.UnscheduleEvent(events[i % num_types], i);
+    }
+    const u64 unschedule_end = core_timing.GetGlobalTimeNs().count();
+
+    core_timing.Pause(false);
+
+    while (core_timing.HasPendingEvents())
+        ;
+
+    REQUIRE(fired.size() == num_events / 2);
+    for (std::size_t i = 0; i < fired.size(); i++) {
+        REQUIRE(fired[i] == i * 2);
+    }
+
+    printf("HostTimer Many Events Scheduling Time: %.3f us\n",
+           static_cast<double>(schedule_end - schedule_start) / 1000.0);
+    printf("HostTimer Many Events Unscheduling Time: %.3f us\n",
+           static_cast<double>(unschedule_end - schedule_end) / 1000.0);
+}
+
+TEST_CASE("CoreTiming[ManyEventsSameType]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    constexpr std::size_t num_events = 4096;
+
+    // Thread timeouts work like this, one event type with the thread handle as user data
+    std::vector<std::uintptr_t> fired;
+    fired.reserve(num_events);
+    const auto event = Core::Timing::CreateEvent(
+        "callback", [&fired](std::uintptr_t user_data, std::chrono::nanoseconds) {
+            fired.push_back(user_data);
+        });
+
+    core_timing.SyncPause(true);
+
+    for (std::size_t i = 0; i < num_events; i++) {
+        const auto future_ns = std::chrono::nanoseconds{static_cast<s64>(i * 1000 + 100)};
+        core_timing.ScheduleEvent(future_ns, event, i);
+    }
+
+    // Unscheduling events that were already unscheduled must not affect the others
+    const u64 unschedule_start = core_timing.GetGlobalTimeNs().count();
+    for (std::size_t i = 1; i < num_events; i += 2) {
+        core_timing.UnscheduleEvent(event, i);
+        core_timing.UnscheduleEvent(event, i);
+    }
+    const u64 unschedule_end = core_timing.GetGlobalTimeNs().count();
+
+    // Events may be scheduled again with user data whose events were unscheduled
+    core_timing.ScheduleEvent(std::chrono::nanoseconds{static_cast<s64>(num_events * 1000)}, event,
+                              1);
+
+    core_timing.Pause(false);
+
+    while (core_timing.HasPendingEvents())
+        ;
+
+    REQUIRE(fired.size() == num_events / 2 + 1);
+    for (std::size_t i = 0; i < num_events / 2; i++) {
+        REQUIRE(fired[i] == i * 2);
+    }
+    REQUIRE(fired.back() == 1);
+
+    printf("HostTimer Many Events Same Type Unscheduling Time: %.3f us\n",
+           static_cast<double>(unschedule_end - unschedule_start) / 1000.0);
+}
@@ -0,0 +1,110 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/hex_util.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/key_manager.h"
+
+namespace Core::Crypto {
+
+namespace {
+std::vector<u8> MakeSequence(std::size_t size) {
+    std::vector<u8> data(size);
+    std::iota(data.begin(), data.end(), u8{0});
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("AESCipher[CTR]", "[core][crypto]") {
+    // NIST SP 800-38A, F.5.1 CTR-AES128.Encrypt
+    const auto key = Common::HexStringToArray<0x10>("2b7e151628aed2a6abf7158809cf4f3c");
+    const auto iv = Common::HexStringToArray<0x10>("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+    const auto plaintext = Common::HexStringToArray<0x40>(
+        "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+        "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+    const auto ciphertext = Common::HexStringToArray<0x40>(
+        "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+        "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee");
+
+    AESCipher<Key128> cipher(key, Mode::CTR);
+
+    std::array<u8, 0x40> output{};
+    cipher.SetIV(iv);
+    cipher.Transcode(plaintext.data(), plaintext.size(), output.data(), Op::Encrypt);
+    REQUIRE(output == ciphertext);
+
+    // In place, with a partial block at the end
+    output = ciphertext;
+    cipher.SetIV(iv);
+    cipher.Transcode(output.data(), 0x3B, output.data(), Op::Decrypt);
+    REQUIRE(std::equal(output.begin(), output.begin() + 0x3B, plaintext.begin()));
+
+    // Consecutive calls continue the counter from the last block touched
+    cipher.SetIV(iv);
+    cipher.Transcode(ciphertext.data(), 0x20, output.data(), Op::Decrypt);
+    cipher.Transcode(ciphertext.data() + 0x20, 0x20, output.data() + 0x20, Op::Decrypt);
+    REQUIRE(output == plaintext);
+}
+
+TEST_CASE("AESCipher[XTS]", "[core][crypto]") {
+    // IEEE 1619-2007, XTS-AES-128 vector 1
+    {
+        AESCipher<Key256> cipher(Key256{}, Mode::XTS);
+        std::array<u8, 0x20> output{};
+        cipher.XTSTranscode(output.data(), output.size(), output.data(), 0, 0x20, Op::Encrypt);
+        REQUIRE(output == Common::HexStringToArray<0x20>(
+                              "917cf69ebd68b2ec9b9fe9a3eadda692cd43d2f59598ed858c02c2652fbf922e"));
+    }
+
+    // Two sectors, with the big endian sector number as the tweak
+    Key256 key{};
+    std::iota(key.begin(), key.end(), u8{0});
+    const std::vector<u8> plaintext = MakeSequence(0x40);
+    const auto ciphertext = Common::HexStringToArray<0x40>(
+        "bb6282966bcde70df1f603e50a5a4ebaab1089a06d675e03263b36783d572c72"
+        "360f6c4eb8291d7861c0d71104afa8ec9118816f8ff66dd92da7797d0976fae4");
+
+    AESCipher<Key256> cipher(key, Mode::XTS);
+
+    std::array<u8, 0x40> output{};
+    cipher.XTSTranscode(plaintext.data(), plaintext.size(), output.data(), 5, 0x20, Op::Encrypt);
+    REQUIRE(output == ciphertext);
+
+    cipher.XTSTranscode(output.data(), output.size(), output.data(), 5, 0x20, Op::Decrypt);
+    REQUIRE(std::equal(output.begin(), output.end(), plaintext.begin()));
+}
+
+TEST_CASE("AESCipher[Throughput]", "[.][benchmark]") {
+    Key128 ctr_key{};
+    Key256 xts_key{};
+    std::iota(ctr_key.begin(), ctr_key.end(), u8{0});
+    std::iota(xts_key.begin(), xts_key.end(), u8{0});
+    AESCipher<Key128> ctr_cipher(ctr_key, Mode::CTR);
+    AESCipher<Key256> xts_cipher(xts_key, Mode::XTS);
+
+    for (const std::size_t size : {0x4000, 0x40000, 0x100000, 0x800000}) {
+        std::vector<u8> buffer = MakeSequence(size);
+        const std::string suffix = std::to_string(size / 1024) + " KiB";
+
+        BENCHMARK("CTR " + suffix) {
+            ctr_cipher.SetIV(std::array<u8, 0x10>{});
+            ctr_cipher.Transcode(buffer.data(), buffer.size(), buffer.data(), Op::Decrypt);
+            return buffer[0];
+        };
+        BENCHMARK("XTS " + suffix) {
+            xts_cipher.XTSTranscode(buffer.data(), buffer.size(), buffer.data(), 0, 0x4000,
+                                    Op::Decrypt);
+            return buffer[0];
+        };
+    }
+}
+
+} // namespace Core::Crypto
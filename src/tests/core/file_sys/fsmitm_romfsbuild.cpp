@@ -0,0 +1,105 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/file_sys/romfs.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace FileSys {
+
+namespace {
+VirtualFile MakeFile(std::string name, std::string_view contents) {
+    return std::make_shared<VectorVfsFile>(std::vector<u8>(contents.begin(), contents.end()),
+                                           std::move(name));
+}
+
+VirtualDir MakeDir(std::string name, std::vector<VirtualFile> files,
+                   std::vector<VirtualDir> dirs = {}) {
+    return std::make_shared<VectorVfsDirectory>(std::move(files), std::move(dirs),
+                                                std::move(name));
+}
+
+/// Builds a RomFS out of the layers and extracts its root back
+VirtualDir BuildLayers(std::vector<VirtualDir> layers, VirtualDir ext = nullptr) {
+    const auto romfs = CreateLayeredRomFS(std::move(layers), std::move(ext));
+    REQUIRE(romfs != nullptr);
+    const auto root = ExtractRomFS(romfs, RomFSExtractionType::SingleDiscard);
+    REQUIRE(root != nullptr);
+    return root;
+}
+
+/// Returns the contents of the file at path, or an empty optional if there is none
+std::optional<std::string> ReadText(const VirtualDir& root, std::string_view path) {
+    const auto file = root->GetFileRelative(path);
+    if (file == nullptr) {
+        return std::nullopt;
+    }
+    const auto data = file->ReadAllBytes();
+    return std::string(data.begin(), data.end());
+}
+} // Anonymous namespace
+
+TEST_CASE("RomFSBuildContext[FilePriority]", "[core][file_sys]") {
+    const auto top = MakeDir("", {MakeFile("a.bin", "top"), MakeFile("b.bin", "top")});
+    const auto middle = MakeDir("", {MakeFile("b.bin", "middle"), MakeFile("c.bin", "middle")});
+    const auto bottom = MakeDir("", {MakeFile("a.bin", "bottom"), MakeFile("b.bin", "bottom"),
+                                     MakeFile("c.bin", "bottom"), MakeFile("d.bin", "bottom")});
+
+    const auto root = BuildLayers({top, middle, bottom});
+    REQUIRE(root->GetFiles().size() == 4);
+    REQUIRE(ReadText(root, "a.bin") == "top");
+    REQUIRE(ReadText(root, "b.bin") == "top");
+    REQUIRE(ReadText(root, "c.bin") == "middle");
+    REQUIRE(ReadText(root, "d.bin") == "bottom");
+}
+
+TEST_CASE("RomFSBuildContext[DirectoryMerge]", "[core][file_sys]") {
+    const auto top = MakeDir("", {}, {MakeDir("dir", {MakeFile("a.bin", "top")})});
+    const auto bottom = MakeDir(
+        "", {},
+        {MakeDir("dir", {MakeFile("a.bin", "bottom"), MakeFile("b.bin", "bottom")},
+                 {MakeDir("sub", {MakeFile("c.bin", "bottom")})})});
+
+    // Directories of the same name are merged at every depth, their files keep their priority
+    const auto root = BuildLayers({top, bottom});
+    REQUIRE(root->GetSubdirectories().size() == 1);
+    REQUIRE(root->GetDirectoryRelative("dir")->GetFiles().size() == 2);
+    REQUIRE(ReadText(root, "dir/a.bin") == "top");
+    REQUIRE(ReadText(root, "dir/b.bin") == "bottom");
+    REQUIRE(ReadText(root, "dir/sub/c.bin") == "bottom");
+}
+
+TEST_CASE("RomFSBuildContext[TypeConflict]", "[core][file_sys]") {
+    // A file hides a directory of the same name below it, and the other way around
+    const auto top =
+        MakeDir("", {MakeFile("entry", "top")}, {MakeDir("other", {MakeFile("a.bin", "top")})});
+    const auto bottom = MakeDir("", {MakeFile("other", "bottom")},
+                                {MakeDir("entry", {MakeFile("a.bin", "bottom")})});
+
+    const auto root = BuildLayers({top, bottom});
+    REQUIRE(ReadText(root, "entry") == "top");
+    REQUIRE(root->GetSubdirectory("entry") == nullptr);
+    REQUIRE(ReadText(root, "other/a.bin") == "top");
+    REQUIRE(root->GetFile("other") == nullptr);
+}
+
+TEST_CASE("RomFSBuildContext[Stub]", "[core][file_sys]") {
+    const auto top = MakeDir("", {MakeFile("a.bin", "top")});
+    const auto bottom = MakeDir("", {MakeFile("b.bin", "bottom")},
+                                {MakeDir("dir", {MakeFile("c.bin", "bottom")})});
+    const auto ext = MakeDir("", {MakeFile("a.bin.stub", ""), MakeFile("dir.stub", "")});
+
+    // Stubs remove entries regardless of the layer they come from
+    const auto root = BuildLayers({top, bottom}, ext);
+    REQUIRE(ReadText(root, "a.bin") == std::nullopt);
+    REQUIRE(ReadText(root, "b.bin") == "bottom");
+    REQUIRE(root->GetSubdirectory("dir") == nullptr);
+}
+
+} // namespace FileSys
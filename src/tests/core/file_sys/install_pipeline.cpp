@@ -0,0 +1,107 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <mbedtls/sha256.h>
+#include "core/file_sys/install_pipeline.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace FileSys {
+
+namespace {
+constexpr std::size_t BLOCK_SIZE = 16;
+
+// Sizes cover a single partial block, exact multiples of the block size and an empty file
+constexpr std::array<std::size_t, 5> FILE_SIZES{1, BLOCK_SIZE, 37, BLOCK_SIZE * 12, 0};
+
+std::vector<u8> MakeData(std::size_t size, u8 seed) {
+    std::vector<u8> data(size);
+    std::iota(data.begin(), data.end(), seed);
+    return data;
+}
+
+std::array<u8, 0x20> Hash(const std::vector<u8>& data) {
+    std::array<u8, 0x20> hash{};
+    mbedtls_sha256_ret(data.data(), data.size(), hash.data(), 0);
+    return hash;
+}
+
+struct Fixture {
+    Fixture() {
+        for (std::size_t i = 0; i < FILE_SIZES.size(); ++i) {
+            auto& data = sources_data.emplace_back(MakeData(FILE_SIZES[i], static_cast<u8>(i)));
+            auto destination = std::make_shared<VectorVfsFile>();
+            destinations.push_back(destination);
+            jobs.push_back({std::make_shared<VectorVfsFile>(data), destination, Hash(data)});
+        }
+    }
+
+    std::vector<std::vector<u8>> sources_data;
+    std::vector<std::shared_ptr<VectorVfsFile>> destinations;
+    std::vector<InstallJob> jobs;
+};
+} // Anonymous namespace
+
+TEST_CASE("InstallFiles[Copy]", "[core][file_sys]") {
+    Fixture fixture;
+    // Files without an expected hash are copied without being verified
+    fixture.jobs[1].expected_hash.reset();
+
+    std::size_t progress = 0;
+    REQUIRE(InstallFiles(fixture.jobs, BLOCK_SIZE, [&progress](std::size_t written) {
+        progress += written;
+        return true;
+    }));
+
+    for (std::size_t i = 0; i < FILE_SIZES.size(); ++i) {
+        REQUIRE(fixture.destinations[i]->ReadAllBytes() == fixture.sources_data[i]);
+    }
+    REQUIRE(progress == std::accumulate(FILE_SIZES.begin(), FILE_SIZES.end(), std::size_t{0}));
+}
+
+TEST_CASE("InstallFiles[NoVerification]", "[core][file_sys]") {
+    Fixture fixture;
+    // Without any expected hash the blocks go from the reader straight to the writer
+    for (auto& job : fixture.jobs) {
+        job.expected_hash.reset();
+    }
+
+    REQUIRE(InstallFiles(fixture.jobs, BLOCK_SIZE));
+    for (std::size_t i = 0; i < FILE_SIZES.size(); ++i) {
+        REQUIRE(fixture.destinations[i]->ReadAllBytes() == fixture.sources_data[i]);
+    }
+}
+
+TEST_CASE("InstallFiles[HashMismatch]", "[core][file_sys]") {
+    Fixture fixture;
+    fixture.jobs[2].expected_hash->front() ^= 1;
+
+    REQUIRE(!InstallFiles(fixture.jobs, BLOCK_SIZE));
+    for (const auto& destination : fixture.destinations) {
+        REQUIRE(destination->GetSize() == 0);
+    }
+}
+
+TEST_CASE("InstallFiles[Cancel]", "[core][file_sys]") {
+    Fixture fixture;
+
+    std::size_t num_calls = 0;
+    REQUIRE(!InstallFiles(fixture.jobs, BLOCK_SIZE, [&num_calls](std::size_t) {
+        ++num_calls;
+        return num_calls < 3;
+    }));
+
+    // No block is written after the copy was cancelled
+    REQUIRE(num_calls == 3);
+    for (const auto& destination : fixture.destinations) {
+        REQUIRE(destination->GetSize() == 0);
+    }
+}
+
+} // namespace FileSys
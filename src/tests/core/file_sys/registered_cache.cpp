@@ -0,0 +1,45 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/common_funcs.h"
+#include "core/file_sys/registered_cache.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace FileSys {
+
+namespace {
+/// Builds a cache index with a single record that claims cnmt_size bytes of CNMT
+std::vector<u8> MakeIndex(u64 cnmt_size, std::size_t cnmt_bytes) {
+    const std::array<u32, 3> header{Common::MakeMagic('R', 'C', 'I', 'X'), 1, 1};
+    const std::array<u64, 5> record{0, 0, 0x200, 0x0100000000001000, cnmt_size};
+
+    std::vector<u8> data(sizeof(header) + sizeof(record) + cnmt_bytes);
+    std::memcpy(data.data(), header.data(), sizeof(header));
+    std::memcpy(data.data() + sizeof(header), record.data(), sizeof(record));
+    return data;
+}
+
+VirtualDir MakeCacheDir(std::vector<u8> index) {
+    const auto meta_dir = std::make_shared<VectorVfsDirectory>(
+        std::vector<VirtualFile>{
+            std::make_shared<VectorVfsFile>(std::move(index), "cnmt_index.bin")},
+        std::vector<VirtualDir>{}, "yuzu_meta");
+    return std::make_shared<VectorVfsDirectory>(std::vector<VirtualFile>{},
+                                                std::vector<VirtualDir>{meta_dir});
+}
+} // Anonymous namespace
+
+TEST_CASE("RegisteredCache[CorruptIndex]", "[core][file_sys]") {
+    // Records whose CNMT runs past the end of the index are rejected before anything is allocated
+    REQUIRE_NOTHROW(RegisteredCache{MakeCacheDir(MakeIndex(~u64{0} >> 4, 0x10))});
+    REQUIRE_NOTHROW(RegisteredCache{MakeCacheDir(MakeIndex(0x11, 0x10))});
+    REQUIRE_NOTHROW(RegisteredCache{MakeCacheDir(MakeIndex(0x10, 0x10))});
+}
+
+} // namespace FileSys
@@ -0,0 +1,155 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/file_sys/vfs_cached.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace FileSys {
+
+namespace {
+constexpr std::size_t BLOCK_SIZE = 16;
+constexpr std::size_t MAX_BLOCKS = 5;
+constexpr std::size_t READ_AHEAD_BLOCKS = 4;
+constexpr std::size_t FILE_SIZE = 100;
+
+std::vector<u8> Expected(std::size_t length, std::size_t offset) {
+    std::vector<u8> data(length);
+    std::iota(data.begin(), data.end(), static_cast<u8>(offset));
+    return data;
+}
+
+/// Vector backed file without a view, so every read goes through Read, and counts them
+class CountingVfsFile final : public VectorVfsFile {
+public:
+    explicit CountingVfsFile(std::vector<u8> initial_data)
+        : VectorVfsFile(std::move(initial_data)) {}
+
+    std::size_t Read(u8* data_, std::size_t length, std::size_t offset) const override {
+        ++num_reads;
+        return VectorVfsFile::Read(data_, length, offset);
+    }
+
+    std::span<const u8> GetView(std::size_t, std::size_t) const override {
+        return {};
+    }
+
+    mutable std::size_t num_reads = 0;
+};
+
+// Reads are issued out of order on purpose. Two back to back sequential reads would start a
+// read-ahead on the background worker and make the number of wrapped reads nondeterministic.
+struct Fixture {
+    std::vector<u8> Read(std::size_t length, std::size_t offset) const {
+        std::vector<u8> data(length, 0xFF);
+        data.resize(file.Read(data.data(), data.size(), offset));
+        return data;
+    }
+
+    std::shared_ptr<CountingVfsFile> base =
+        std::make_shared<CountingVfsFile>(Expected(FILE_SIZE, 0));
+    CachedVfsFile file{base, BLOCK_SIZE, MAX_BLOCKS, READ_AHEAD_BLOCKS};
+};
+} // Anonymous namespace
+
+TEST_CASE("CachedVfsFile[BlockBoundaries]", "[core][file_sys]") {
+    Fixture fixture;
+
+    // A read covering exactly one block loads only that block
+    REQUIRE(fixture.Read(BLOCK_SIZE, BLOCK_SIZE) == Expected(BLOCK_SIZE, BLOCK_SIZE));
+    REQUIRE(fixture.base->num_reads == 1);
+
+    // The first and last bytes of the block are served from the cache
+    REQUIRE(fixture.Read(1, BLOCK_SIZE) == Expected(1, BLOCK_SIZE));
+    REQUIRE(fixture.Read(1, BLOCK_SIZE * 2 - 1) == Expected(1, BLOCK_SIZE * 2 - 1));
+    REQUIRE(fixture.base->num_reads == 1);
+
+    // The first byte after it belongs to the next block
+    REQUIRE(fixture.Read(1, BLOCK_SIZE * 2) == Expected(1, BLOCK_SIZE * 2));
+    REQUIRE(fixture.base->num_reads == 2);
+}
+
+TEST_CASE("CachedVfsFile[CrossBlock]", "[core][file_sys]") {
+    Fixture fixture;
+
+    // Starts in the middle of block 0 and ends in the middle of block 3
+    REQUIRE(fixture.Read(50, 10) == Expected(50, 10));
+    REQUIRE(fixture.base->num_reads == 4);
+
+    // Reads within the loaded blocks are served from the cache
+    REQUIRE(fixture.Read(20, 30) == Expected(20, 30));
+    REQUIRE(fixture.Read(BLOCK_SIZE * 3, 0) == Expected(BLOCK_SIZE * 3, 0));
+    REQUIRE(fixture.base->num_reads == 4);
+
+    // A sixth block evicts the least recently used one, block 3
+    REQUIRE(fixture.Read(1, BLOCK_SIZE * 4) == Expected(1, BLOCK_SIZE * 4));
+    REQUIRE(fixture.Read(1, BLOCK_SIZE * 5) == Expected(1, BLOCK_SIZE * 5));
+    REQUIRE(fixture.base->num_reads == 6);
+    REQUIRE(fixture.Read(1, BLOCK_SIZE * 2) == Expected(1, BLOCK_SIZE * 2));
+    REQUIRE(fixture.base->num_reads == 6);
+    REQUIRE(fixture.Read(1, BLOCK_SIZE * 3) == Expected(1, BLOCK_SIZE * 3));
+    REQUIRE(fixture.base->num_reads == 7);
+}
+
+TEST_CASE("CachedVfsFile[EOF]", "[core][file_sys]") {
+    Fixture fixture;
+    REQUIRE(fixture.file.GetSize() == FILE_SIZE);
+
+    // The last block is partial and reads are clamped to the end of the file
+    constexpr std::size_t last_block = FILE_SIZE / BLOCK_SIZE * BLOCK_SIZE;
+    REQUIRE(fixture.Read(BLOCK_SIZE, last_block) == Expected(FILE_SIZE - last_block, last_block));
+    REQUIRE(fixture.Read(10, FILE_SIZE - 5) == Expected(5, FILE_SIZE - 5));
+    REQUIRE(fixture.Read(1, FILE_SIZE - 1) == Expected(1, FILE_SIZE - 1));
+    REQUIRE(fixture.base->num_reads == 2);
+
+    // Reads at or past the end return nothing and don't touch the wrapped file
+    REQUIRE(fixture.Read(1, FILE_SIZE).empty());
+    REQUIRE(fixture.Read(BLOCK_SIZE, FILE_SIZE * 2).empty());
+    REQUIRE(fixture.base->num_reads == 2);
+}
+
+TEST_CASE("CachedVfsFile[Write]", "[core][file_sys]") {
+    Fixture fixture;
+    REQUIRE(fixture.Read(BLOCK_SIZE * 2, 0) == Expected(BLOCK_SIZE * 2, 0));
+    REQUIRE(fixture.base->num_reads == 2);
+
+    // Writes go through and drop the cached blocks they touch
+    const std::array<u8, 4> patch{0xA0, 0xA1, 0xA2, 0xA3};
+    REQUIRE(fixture.file.Write(patch.data(), patch.size(), BLOCK_SIZE - 2) == patch.size());
+    std::vector<u8> expected = Expected(BLOCK_SIZE * 2, 0);
+    std::copy(patch.begin(), patch.end(), expected.begin() + BLOCK_SIZE - 2);
+    REQUIRE(fixture.Read(BLOCK_SIZE * 2, 0) == expected);
+    REQUIRE(fixture.base->num_reads == 4);
+
+    // Growing the file exposes the new bytes of the previously partial last block
+    constexpr std::size_t last_block = FILE_SIZE / BLOCK_SIZE * BLOCK_SIZE;
+    REQUIRE(fixture.Read(BLOCK_SIZE, last_block) == Expected(FILE_SIZE - last_block, last_block));
+    REQUIRE(fixture.file.Resize(FILE_SIZE + 8));
+    REQUIRE(fixture.file.GetSize() == FILE_SIZE + 8);
+    expected = Expected(FILE_SIZE - last_block, last_block);
+    expected.resize(FILE_SIZE + 8 - last_block);
+    REQUIRE(fixture.Read(BLOCK_SIZE, last_block) == expected);
+}
+
+TEST_CASE("CachedVfsFile[LargeRead]", "[core][file_sys]") {
+    Fixture fixture;
+
+    // Reads larger than the read-ahead window go straight to the wrapped file
+    constexpr std::size_t window = BLOCK_SIZE * READ_AHEAD_BLOCKS;
+    REQUIRE(fixture.Read(window + 1, 1) == Expected(window + 1, 1));
+    REQUIRE(fixture.base->num_reads == 1);
+    REQUIRE(fixture.Read(1, 1) == Expected(1, 1));
+    REQUIRE(fixture.base->num_reads == 2);
+    REQUIRE(fixture.Read(window + 1, 1) == Expected(window + 1, 1));
+    REQUIRE(fixture.base->num_reads == 3);
+}
+
+} // namespace FileSys
@@ -0,0 +1,124 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/page_table.h"
+#include "core/memory.h"
+#include "core/memory/walk_block.h"
+
+namespace Core::Memory {
+
+namespace {
+constexpr std::size_t ADDRESS_SPACE_BITS = 25;
+constexpr std::size_t NUM_PAGES = std::size_t{1} << (ADDRESS_SPACE_BITS - PAGE_BITS);
+
+struct Run {
+    Common::PageType type;
+    VAddr vaddr;
+    std::size_t size;
+
+    bool operator==(const Run&) const = default;
+};
+
+/// Page table over a host buffer, laid out like Memory::MapPages does
+struct Fixture {
+    Fixture() {
+        page_table.Resize(ADDRESS_SPACE_BITS, PAGE_BITS);
+    }
+
+    /// Maps num_pages guest pages from first_page onto the host buffer at backing_page
+    void Map(std::size_t first_page, std::size_t num_pages, std::size_t backing_page,
+             Common::PageType type = Common::PageType::Memory) {
+        for (std::size_t page = first_page; page < first_page + num_pages; ++page) {
+            const std::size_t offset = (backing_page + page - first_page) * PAGE_SIZE;
+            const std::size_t vaddr = page << PAGE_BITS;
+            page_table.pointers[page].Store(memory.data() + offset - vaddr, type);
+            page_table.backing_addr[page] = BACKING_BASE + offset - vaddr;
+        }
+    }
+
+    std::vector<Run> Walk(VAddr addr, std::size_t size) const {
+        std::vector<Run> runs;
+        WalkBlock(
+            page_table, addr, size,
+            [&runs](std::size_t copy_amount, VAddr vaddr) {
+                runs.push_back({Common::PageType::Unmapped, vaddr, copy_amount});
+            },
+            [this, &runs](std::size_t copy_amount, const u8* host_ptr) {
+                const auto offset = static_cast<std::size_t>(host_ptr - memory.data());
+                runs.push_back({Common::PageType::Memory, offset, copy_amount});
+            },
+            [&runs](VAddr vaddr, std::size_t copy_amount) {
+                runs.push_back({Common::PageType::RasterizerCachedMemory, vaddr, copy_amount});
+            },
+            [](std::size_t) {});
+        return runs;
+    }
+
+    static constexpr u64 BACKING_BASE = 0x80000000;
+
+    std::vector<u8> memory = std::vector<u8>(NUM_PAGES * PAGE_SIZE);
+    Common::PageTable page_table;
+};
+} // Anonymous namespace
+
+TEST_CASE("WalkBlock[Coalesce]", "[core][memory]") {
+    Fixture fixture;
+    fixture.Map(0, 8, 0);
+    fixture.Map(10, 1, 20);
+    fixture.Map(11, 1, 30);
+    fixture.Map(12, 2, 40, Common::PageType::RasterizerCachedMemory);
+
+    // Memory runs are reported with their offset in the host buffer
+    using Common::PageType;
+    REQUIRE(fixture.Walk(0x100, 14 * PAGE_SIZE - 0x200) ==
+            std::vector<Run>{
+                {PageType::Memory, 0x100, 8 * PAGE_SIZE - 0x100},
+                {PageType::Unmapped, 8 * PAGE_SIZE, 2 * PAGE_SIZE},
+                {PageType::Memory, 20 * PAGE_SIZE, PAGE_SIZE},
+                {PageType::Memory, 30 * PAGE_SIZE, PAGE_SIZE},
+                {PageType::RasterizerCachedMemory, 12 * PAGE_SIZE, 2 * PAGE_SIZE - 0x100},
+            });
+
+    // Ranges inside a single page are a single run
+    REQUIRE(fixture.Walk(0x10, 0x20) == std::vector<Run>{{PageType::Memory, 0x10, 0x20}});
+}
+
+TEST_CASE("WalkBlock[Throughput]", "[.][benchmark]") {
+    // Contiguous guest memory is copied in one run, scattered memory one page at a time
+    Fixture contiguous;
+    contiguous.Map(0, NUM_PAGES / 2, 0);
+    Fixture scattered;
+    for (std::size_t page = 0; page < NUM_PAGES / 2; ++page) {
+        scattered.Map(page, 1, NUM_PAGES - 1 - page);
+    }
+
+    std::vector<u8> buffer(NUM_PAGES / 2 * PAGE_SIZE);
+    const auto read_block = [&buffer](const Fixture& fixture, std::size_t size) {
+        u8* dest = buffer.data();
+        WalkBlock(
+            fixture.page_table, 0, size, [](std::size_t, VAddr) {},
+            [&dest](std::size_t copy_amount, const u8* host_ptr) {
+                std::memcpy(dest, host_ptr, copy_amount);
+            },
+            [](VAddr, std::size_t) {}, [&dest](std::size_t copy_amount) { dest += copy_amount; });
+        return buffer[size - 1];
+    };
+
+    for (std::size_t size = 4 * 1024; size <= 16 * 1024 * 1024; size *= 4) {
+        const std::string suffix = std::to_string(size / 1024) + " KiB";
+        BENCHMARK("Contiguous " + suffix) {
+            return read_block(contiguous, size);
+        };
+        BENCHMARK("Scattered " + suffix) {
+            return read_block(scattered, size);
+        };
+    }
+}
+
+} // namespace Core::Memory
@@ -0,0 +1,131 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "video_core/textures/decoders.h"
+
+namespace {
+using namespace Tegra::Texture;
+
+/// Per pixel reference of the block linear layout, used to validate the sector based copies
+u32 ReferenceOffset(u32 x, u32 y, u32 bytes_per_pixel, u32 width, u32 block_height) {
+    const u32 stride = width * bytes_per_pixel;
+    const u32 gobs_in_x = (stride + GOB_SIZE_X - 1) / GOB_SIZE_X;
+    const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height);
+    const u32 block_y = y / GOB_SIZE_Y;
+    const u32 byte_x = x * bytes_per_pixel;
+    return (block_y >> block_height) * block_size +
+           ((block_y & ((1U << block_height) - 1)) << GOB_SIZE_SHIFT) +
+           ((byte_x / GOB_SIZE_X) << (GOB_SIZE_SHIFT + block_height)) +
+           SWIZZLE_TABLE[y % GOB_SIZE_Y][byte_x % GOB_SIZE_X];
+}
+
+/// Pixel at a time copy the sector based swizzle replaced, kept to measure it against
+void SwizzlePerPixel(std::span<u8> swizzled, std::span<const u8> linear, u32 bytes_per_pixel,
+                     u32 width, u32 height, u32 block_height) {
+    const u32 pitch = width * bytes_per_pixel;
+    const u32 gobs_in_x = (pitch + GOB_SIZE_X - 1) / GOB_SIZE_X;
+    const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height);
+    const u32 block_height_mask = (1U << block_height) - 1;
+    const u32 x_shift = GOB_SIZE_SHIFT + block_height;
+    for (u32 y = 0; y < height; ++y) {
+        const auto& table = SWIZZLE_TABLE[y % GOB_SIZE_Y];
+        const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
+        const u32 offset_y = (block_y >> block_height) * block_size +
+                             ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+        for (u32 column = 0; column < width; ++column) {
+            const u32 x = column * bytes_per_pixel;
+            const u32 offset =
+                offset_y + ((x >> GOB_SIZE_X_SHIFT) << x_shift) + table[x % GOB_SIZE_X];
+            std::memcpy(&swizzled[offset], &linear[y * pitch + x], bytes_per_pixel);
+        }
+    }
+}
+
+std::vector<u8> MakePattern(std::size_t size) {
+    std::vector<u8> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<u8>(i * 7 + i / 251);
+    }
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("Swizzle: Matches per pixel reference", "[video_core]") {
+    static constexpr std::array<u32, 5> bytes_per_pixel_list{1, 2, 4, 8, 16};
+    static constexpr u32 width = 77;
+    static constexpr u32 height = 35;
+    static constexpr u32 block_height = 2;
+    for (const u32 bytes_per_pixel : bytes_per_pixel_list) {
+        const std::size_t swizzled_size =
+            CalculateSize(true, bytes_per_pixel, width, height, 1, block_height, 0);
+        const std::vector<u8> linear = MakePattern(width * height * bytes_per_pixel);
+        std::vector<u8> swizzled(swizzled_size);
+        SwizzleTexture(swizzled, linear, bytes_per_pixel, width, height, 1, block_height, 0);
+
+        for (u32 y = 0; y < height; ++y) {
+            for (u32 x = 0; x < width; ++x) {
+                const u32 offset = ReferenceOffset(x, y, bytes_per_pixel, width, block_height);
+                const u32 linear_offset = (y * width + x) * bytes_per_pixel;
+                for (u32 byte = 0; byte < bytes_per_pixel; ++byte) {
+                    REQUIRE(swizzled[offset + byte] == linear[linear_offset + byte]);
+                }
+            }
+        }
+
+        std::vector<u8> unswizzled(linear.size());
+        UnswizzleTexture(unswizzled, swizzled, bytes_per_pixel, width, height, 1, block_height, 0);
+        REQUIRE(unswizzled == linear);
+    }
+}
+
+TEST_CASE("Swizzle: Subrect round trip", "[video_core]") {
+    static constexpr u32 bytes_per_pixel = 4;
+    static constexpr u32 width = 100;
+    static constexpr u32 block_height = 1;
+    static constexpr u32 origin_x = 3;
+    static constexpr u32 origin_y = 5;
+    static constexpr u32 subrect_width = 41;
+    static constexpr u32 subrect_height = 19;
+    static constexpr u32 pitch = subrect_width * bytes_per_pixel;
+
+    std::vector<u8> swizzled(CalculateSize(true, bytes_per_pixel, width, 32, 1, block_height, 0));
+    const std::vector<u8> linear = MakePattern(pitch * subrect_height);
+    SwizzleSubrect(subrect_width, subrect_height, pitch, width, bytes_per_pixel, swizzled.data(),
+                   linear.data(), block_height, origin_x, origin_y);
+
+    std::vector<u8> unswizzled(linear.size());
+    UnswizzleSubrect(subrect_width, subrect_height, pitch, width, bytes_per_pixel, block_height,
+                     origin_x, origin_y, unswizzled.data(), swizzled.data());
+    REQUIRE(unswizzled == linear);
+}
+
+TEST_CASE("Swizzle[Throughput]", "[.][benchmark]") {
+    static constexpr u32 width = 2048;
+    static constexpr u32 height = 1024;
+    static constexpr u32 block_height = 4;
+    for (const u32 bytes_per_pixel : {1U, 4U, 16U}) {
+        const std::vector<u8> linear = MakePattern(width * height * bytes_per_pixel);
+        std::vector<u8> swizzled(
+            CalculateSize(true, bytes_per_pixel, width, height, 1, block_height, 0));
+        const std::string suffix = std::to_string(bytes_per_pixel) + " bytes per pixel";
+
+        BENCHMARK("Per pixel " + suffix) {
+            SwizzlePerPixel(swizzled, linear, bytes_per_pixel, width, height, block_height);
+            return swizzled[0];
+        };
+        BENCHMARK("Per sector " + suffix) {
+            SwizzleTexture(swizzled, linear, bytes_per_pixel, width, height, 1, block_height, 0);
+            return swizzled[0];
+        };
+    }
+}
@@ -489,6 +489,10 @@ void GPU::PushGPUEntries(Tegra::CommandList&& entries) {
     gpu_thread.SubmitList(std::move(entries));
 }
 
+void GPU::PushGPUEntries(std::span<Tegra::CommandList> entries_list) {
+    gpu_thread.SubmitLists(entries_list);
+}
+
 void GPU::PushCommandBuffer(Tegra::ChCommandHeaderList& entries) {
     if (!use_nvdec) {
         return;
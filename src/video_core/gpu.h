@@ -10,6 +10,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <span>
 #include "common/common_types.h"
 #include "core/hle/service/nvdrv/nvdata.h"
 #include "core/hle/service/nvflinger/buffer_queue.h"
@@ -323,6 +324,9 @@ public:
     /// Push GPU command entries to be processed
     void PushGPUEntries(Tegra::CommandList&& entries);
 
+    /// Push multiple GPU command entries to be processed as a single batch, the entries are moved
+    void PushGPUEntries(std::span<Tegra::CommandList> entries_list);
+
     /// Push GPU command buffer entries to be processed
     void PushCommandBuffer(Tegra::ChCommandHeaderList& entries);
 
@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <limits>
+
 #include "common/assert.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
@@ -16,6 +18,16 @@
 
 namespace VideoCommon::GPUThread {
 
+/// Pops commands without executing them until the shutdown command is reached.
+/// ShutDown may be blocked pushing EndProcessingCommand into a full queue, so the GPU thread has to
+/// keep consuming until it sees that command before it can exit.
+static void DiscardCommands(SynchState& state) {
+    CommandDataContainer next;
+    do {
+        next = state.queue.PopWait();
+    } while (!std::holds_alternative<EndProcessingCommand>(next.data));
+}
+
 /// Runs the GPU thread
 static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
                       Core::Frontend::GraphicsContext& context, Tegra::DmaPusher& dma_pusher,
@@ -33,6 +45,7 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
 
     // If emulation was stopped during disk shader loading, abort before trying to acquire context
     if (!state.is_running) {
+        DiscardCommands(state);
         return;
     }
 
@@ -40,8 +53,15 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
     VideoCore::RasterizerInterface* const rasterizer = renderer.ReadRasterizer();
 
     CommandDataContainer next;
-    while (state.is_running) {
+    for (;;) {
         next = state.queue.PopWait();
+        if (!state.is_running) {
+            // Shutdown is pending, drop everything queued up to the shutdown command
+            if (!std::holds_alternative<EndProcessingCommand>(next.data)) {
+                DiscardCommands(state);
+            }
+            return;
+        }
         if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
             dma_pusher.Push(std::move(submit_list->entries));
             dma_pusher.DispatchCalls();
@@ -55,17 +75,12 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
             rasterizer->FlushRegion(flush->addr, flush->size);
         } else if (const auto* invalidate = std::get_if<InvalidateRegionCommand>(&next.data)) {
             rasterizer->OnCPUWrite(invalidate->addr, invalidate->size);
-        } else if (std::holds_alternative<EndProcessingCommand>(next.data)) {
-            ASSERT(state.is_running == false);
         } else {
             UNREACHABLE();
         }
-        state.signaled_fence.store(next.fence);
+        state.signaled_fence.store(next.fence, std::memory_order_release);
         if (next.block) {
-            // We have to lock the write_lock to ensure that the condition_variable wait not get a
-            // race between the check and the lock itself.
-            std::lock_guard lk(state.write_lock);
-            state.cv.notify_all();
+            state.signaled_fence.notify_all();
         }
     }
 }
@@ -89,6 +104,25 @@ void ThreadManager::SubmitList(Tegra::CommandList&& entries) {
     PushCommand(SubmitListCommand(std::move(entries)));
 }
 
+void ThreadManager::SubmitLists(std::span<Tegra::CommandList> entries_list) {
+    if (entries_list.empty()) {
+        return;
+    }
+    std::unique_lock lk(state.write_lock);
+    u64 fence{};
+    for (std::size_t index = 0; index < entries_list.size(); ++index) {
+        // In synchronous GPU mode, only the last command of the batch has to block the caller
+        const bool block = !is_async && index == entries_list.size() - 1;
+        fence = StageCommand(SubmitListCommand(std::move(entries_list[index])), block);
+    }
+    state.queue.Publish();
+    lk.unlock();
+
+    if (!is_async) {
+        WaitForFence(fence);
+    }
+}
+
 void ThreadManager::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
     PushCommand(SwapBuffersCommand(framebuffer ? std::make_optional(*framebuffer) : std::nullopt));
 }
@@ -125,9 +159,12 @@ void ThreadManager::ShutDown() {
     {
         std::lock_guard lk(state.write_lock);
         state.is_running = false;
-        state.cv.notify_all();
     }
 
+    // Wake up any thread blocked on a fence, they will observe the GPU thread is no longer running
+    state.signaled_fence.store(std::numeric_limits<u64>::max(), std::memory_order_release);
+    state.signaled_fence.notify_all();
+
     if (!thread.joinable()) {
         return;
     }
@@ -148,17 +185,29 @@ u64 ThreadManager::PushCommand(CommandData&& command_data, bool block) {
     }
 
     std::unique_lock lk(state.write_lock);
-    const u64 fence{++state.last_fence};
-    state.queue.Push(CommandDataContainer(std::move(command_data), fence, block));
+    const u64 fence{StageCommand(std::move(command_data), block)};
+    state.queue.Publish();
+    lk.unlock();
 
     if (block) {
-        state.cv.wait(lk, [this, fence] {
-            return fence <= state.signaled_fence.load(std::memory_order_relaxed) ||
-                   !state.is_running;
-        });
+        WaitForFence(fence);
     }
 
     return fence;
 }
 
+u64 ThreadManager::StageCommand(CommandData&& command_data, bool block) {
+    const u64 fence{++state.last_fence};
+    state.queue.Stage(CommandDataContainer(std::move(command_data), fence, block));
+    return fence;
+}
+
+void ThreadManager::WaitForFence(u64 fence) {
+    u64 signaled_fence = state.signaled_fence.load(std::memory_order_acquire);
+    while (signaled_fence < fence && state.is_running) {
+        state.signaled_fence.wait(signaled_fence, std::memory_order_acquire);
+        signaled_fence = state.signaled_fence.load(std::memory_order_acquire);
+    }
+}
+
 } // namespace VideoCommon::GPUThread
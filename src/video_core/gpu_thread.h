@@ -5,13 +5,13 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <thread>
 #include <variant>
 
-#include "common/threadsafe_queue.h"
+#include "common/bounded_threadsafe_queue.h"
 #include "video_core/framebuffer_config.h"
 
 namespace Tegra {
@@ -100,14 +100,16 @@ struct CommandDataContainer {
 
 /// Struct used to synchronize the GPU thread
 struct SynchState final {
+    /// Maximum number of commands in flight between the emulated CPU and the GPU thread
+    static constexpr std::size_t COMMAND_QUEUE_SIZE = 1024;
+
     std::atomic_bool is_running{true};
 
-    using CommandQueue = Common::SPSCQueue<CommandDataContainer>;
+    using CommandQueue = Common::BoundedSPSCQueue<CommandDataContainer, COMMAND_QUEUE_SIZE>;
     std::mutex write_lock;
     CommandQueue queue;
     u64 last_fence{};
     std::atomic<u64> signaled_fence{};
-    std::condition_variable cv;
 };
 
 /// Class used to manage the GPU thread
@@ -123,6 +125,9 @@ public:
     /// Push GPU command entries to be processed
     void SubmitList(Tegra::CommandList&& entries);
 
+    /// Push multiple GPU command entries to be processed, published as a single batch
+    void SubmitLists(std::span<Tegra::CommandList> entries_list);
+
     /// Swap buffers (render frame)
     void SwapBuffers(const Tegra::FramebufferConfig* framebuffer);
 
@@ -144,6 +149,12 @@ private:
     /// Pushes a command to be executed by the GPU thread
     u64 PushCommand(CommandData&& command_data, bool block = false);
 
+    /// Stages a command without publishing it to the GPU thread, write_lock must be held
+    u64 StageCommand(CommandData&& command_data, bool block);
+
+    /// Blocks the caller until the GPU thread has processed the given fence
+    void WaitForFence(u64 fence);
+
     Core::System& system;
     const bool is_async;
     VideoCore::RasterizerInterface* rasterizer = nullptr;
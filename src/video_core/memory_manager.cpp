@@ -16,8 +16,23 @@
 
 namespace Tegra {
 
+namespace {
+/// Caches the last page table leaf looked up by the current thread.
+/// Sequential accesses from the DMA pusher and engine uploads tend to stay within the same leaf.
+struct TranslationCache {
+    u64 instance_id{};
+    std::size_t root_index{};
+    const void* leaf{};
+};
+
+thread_local TranslationCache translation_cache;
+
+std::atomic<u64> next_instance_id{1};
+} // Anonymous namespace
+
 MemoryManager::MemoryManager(Core::System& system_)
-    : system{system_}, page_table(page_table_size) {}
+    : system{system_}, instance_id{next_instance_id.fetch_add(1, std::memory_order_relaxed)},
+      page_table_root{std::make_unique<std::atomic<PageTableLeaf*>[]>(page_table_root_size)} {}
 
 MemoryManager::~MemoryManager() = default;
 
@@ -119,8 +134,42 @@ void MemoryManager::TryUnlockPage(PageEntry page_entry, std::size_t size) {
                .IsSuccess());
 }
 
+const MemoryManager::PageTableLeaf* MemoryManager::FindLeaf(std::size_t page_index) const {
+    const std::size_t root_index{page_index >> page_table_leaf_bits};
+    if (translation_cache.instance_id == instance_id &&
+        translation_cache.root_index == root_index) {
+        return static_cast<const PageTableLeaf*>(translation_cache.leaf);
+    }
+    const PageTableLeaf* const leaf{page_table_root[root_index].load(std::memory_order_acquire)};
+    if (leaf) {
+        // Only cache allocated leaves, unallocated ones may be allocated at any time
+        translation_cache = TranslationCache{
+            .instance_id = instance_id,
+            .root_index = root_index,
+            .leaf = leaf,
+        };
+    }
+    return leaf;
+}
+
+MemoryManager::PageTableLeaf& MemoryManager::GetOrCreateLeaf(std::size_t page_index) {
+    std::atomic<PageTableLeaf*>& root_entry{page_table_root[page_index >> page_table_leaf_bits]};
+    if (PageTableLeaf* const leaf = root_entry.load(std::memory_order_relaxed)) {
+        return *leaf;
+    }
+    auto& new_leaf{page_table_leaves.emplace_back(std::make_unique<PageTableLeaf>())};
+    PageTableLeaf* const leaf{new_leaf.get()};
+    root_entry.store(leaf, std::memory_order_release);
+    return *leaf;
+}
+
 PageEntry MemoryManager::GetPageEntry(GPUVAddr gpu_addr) const {
-    return page_table[PageEntryIndex(gpu_addr)];
+    const std::size_t page_index{PageEntryIndex(gpu_addr)};
+    const PageTableLeaf* const leaf{FindLeaf(page_index)};
+    if (!leaf) {
+        return PageEntry::State::Unmapped;
+    }
+    return (*leaf)[page_index & page_table_leaf_mask];
 }
 
 void MemoryManager::SetPageEntry(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size) {
@@ -132,7 +181,12 @@ void MemoryManager::SetPageEntry(GPUVAddr gpu_addr, PageEntry page_entry, std::s
 
     //// Lock the new page
     // TryLockPage(page_entry, size);
-    auto& current_page = page_table[PageEntryIndex(gpu_addr)];
+    const std::size_t page_index{PageEntryIndex(gpu_addr)};
+    if (page_entry.IsUnmapped() && !FindLeaf(page_index)) {
+        // Unallocated leaves are entirely unmapped, there's nothing to update
+        return;
+    }
+    auto& current_page = GetOrCreateLeaf(page_index)[page_index & page_table_leaf_mask];
 
     if ((!current_page.IsValid() && page_entry.IsValid()) ||
         current_page.ToAddress() != page_entry.ToAddress()) {
@@ -153,7 +207,16 @@ std::optional<GPUVAddr> MemoryManager::FindFreeRange(std::size_t size, std::size
     u64 available_size{};
     GPUVAddr gpu_addr{start_32bit_address ? address_space_start_low : address_space_start};
     while (gpu_addr + available_size < address_space_size) {
-        if (GetPageEntry(gpu_addr + available_size).IsUnmapped()) {
+        const std::size_t page_index{PageEntryIndex(gpu_addr + available_size)};
+        if (!FindLeaf(page_index)) {
+            // Skip the whole unallocated leaf, all of its pages are unmapped
+            const u64 leaf_pages_left{page_table_leaf_size - (page_index & page_table_leaf_mask)};
+            available_size += leaf_pages_left * page_size;
+
+            if (available_size >= size) {
+                return gpu_addr;
+            }
+        } else if (GetPageEntry(gpu_addr + available_size).IsUnmapped()) {
             available_size += page_size;
 
             if (available_size >= size) {
@@ -418,7 +481,8 @@ bool MemoryManager::IsFullyMappedRange(GPUVAddr gpu_addr, std::size_t size) cons
     size_t page_index{gpu_addr >> page_bits};
     const size_t page_last{(gpu_addr + size + page_size - 1) >> page_bits};
     while (page_index < page_last) {
-        if (!page_table[page_index].IsValid() || page_table[page_index].ToAddress() == 0) {
+        const PageEntry page_entry{GetPageEntry(page_index << page_bits)};
+        if (!page_entry.IsValid() || page_entry.ToAddress() == 0) {
             return false;
         }
         ++page_index;
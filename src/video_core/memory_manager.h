@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -144,6 +147,19 @@ public:
     void Unmap(GPUVAddr gpu_addr, std::size_t size);
 
 private:
+    static constexpr u64 page_table_leaf_bits{10};
+    static constexpr u64 page_table_leaf_size{1 << page_table_leaf_bits};
+    static constexpr u64 page_table_leaf_mask{page_table_leaf_size - 1};
+
+    /// Second level of the page table, only allocated when a page within it is set
+    using PageTableLeaf = std::array<PageEntry, page_table_leaf_size>;
+
+    /// Returns the leaf containing the given page index, or nullptr when it's not allocated
+    [[nodiscard]] const PageTableLeaf* FindLeaf(std::size_t page_index) const;
+
+    /// Returns the leaf containing the given page index, allocating it if necessary
+    [[nodiscard]] PageTableLeaf& GetOrCreateLeaf(std::size_t page_index);
+
     [[nodiscard]] PageEntry GetPageEntry(GPUVAddr gpu_addr) const;
     void SetPageEntry(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size = page_size);
     GPUVAddr UpdateRange(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size);
@@ -168,12 +184,19 @@ private:
     static constexpr u64 page_table_bits{24};
     static constexpr u64 page_table_size{1 << page_table_bits};
     static constexpr u64 page_table_mask{page_table_size - 1};
+    static constexpr u64 page_table_root_size{page_table_size >> page_table_leaf_bits};
 
     Core::System& system;
 
+    /// Unique identifier of this instance, used to validate per-thread translation caches
+    const u64 instance_id;
+
     VideoCore::RasterizerInterface* rasterizer = nullptr;
 
-    std::vector<PageEntry> page_table;
+    /// First level of the page table, pointing to the leaves owned by page_table_leaves.
+    /// Leaves are never freed while the memory manager is alive, so pointers to them are stable.
+    std::unique_ptr<std::atomic<PageTableLeaf*>[]> page_table_root;
+    std::vector<std::unique_ptr<PageTableLeaf>> page_table_leaves;
 
     using MapRange = std::pair<GPUVAddr, size_t>;
     std::vector<MapRange> map_ranges;
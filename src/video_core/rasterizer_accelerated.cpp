@@ -2,7 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <atomic>
+#include <algorithm>
+#include <mutex>
 
 #include "common/assert.h"
 #include "common/common_types.h"
@@ -19,53 +20,67 @@ RasterizerAccelerated::RasterizerAccelerated(Memory& cpu_memory_) : cpu_memory{c
 RasterizerAccelerated::~RasterizerAccelerated() = default;
 
 void RasterizerAccelerated::UpdatePagesCachedCount(VAddr addr, u64 size, int delta) {
-    u64 uncache_begin = 0;
-    u64 cache_begin = 0;
-    u64 uncache_bytes = 0;
-    u64 cache_bytes = 0;
+    ASSERT_MSG(delta == 1 || delta == -1, "Delta must be either 1 or -1!");
 
-    std::atomic_thread_fence(std::memory_order_acquire);
+    const u64 page_begin = addr >> PAGE_BITS;
     const u64 page_end = Common::DivCeil(addr + size, PAGE_SIZE);
-    for (u64 page = addr >> PAGE_BITS; page != page_end; ++page) {
-        std::atomic_uint16_t& count = cached_pages.at(page >> 2).Count(page);
-
-        if (delta > 0) {
-            ASSERT_MSG(count.load(std::memory_order::relaxed) < UINT16_MAX, "Count may overflow!");
-        } else if (delta < 0) {
-            ASSERT_MSG(count.load(std::memory_order::relaxed) > 0, "Count may underflow!");
-        } else {
-            ASSERT_MSG(false, "Delta must be non-zero!");
-        }
+    if (page_begin >= page_end) {
+        return;
+    }
+    const PageInterval interval = PageInterval::right_open(page_begin, page_end);
 
-        // Adds or subtracts 1, as count is a unsigned 8-bit value
-        count.fetch_add(static_cast<u16>(delta), std::memory_order_release);
+    std::scoped_lock lock{cached_pages_mutex};
 
-        // Assume delta is either -1 or 1
-        if (count.load(std::memory_order::relaxed) == 0) {
-            if (uncache_bytes == 0) {
-                uncache_begin = page;
-            }
-            uncache_bytes += PAGE_SIZE;
-        } else if (uncache_bytes > 0) {
-            cpu_memory.RasterizerMarkRegionCached(uncache_begin << PAGE_BITS, uncache_bytes, false);
-            uncache_bytes = 0;
+    // Walk the existing runs overlapping the interval. Gaps between runs are pages with a count
+    // of zero, runs with a count of one are pages that become uncached when decremented.
+    // Adjacent transitions are merged so each contiguous run costs a single page table update.
+    u64 cursor = page_begin;
+    u64 run_begin = 0;
+    u64 run_end = 0;
+    const auto flush_run = [&](bool cached) {
+        if (run_begin != run_end) {
+            MarkRegionCached(run_begin, run_end, cached);
         }
-        if (count.load(std::memory_order::relaxed) == 1 && delta > 0) {
-            if (cache_bytes == 0) {
-                cache_begin = page;
+        run_begin = 0;
+        run_end = 0;
+    };
+    const auto [first, last] = cached_pages.equal_range(interval);
+    for (auto it = first; it != last; ++it) {
+        const u64 segment_begin = std::max(boost::icl::first(it->first), page_begin);
+        const u64 segment_end = std::min(boost::icl::last_next(it->first), page_end);
+        const u32 count = it->second;
+        if (delta > 0) {
+            ASSERT_MSG(count < UINT32_MAX, "Count may overflow!");
+            if (segment_begin > cursor) {
+                MarkRegionCached(cursor, segment_begin, true);
+            }
+        } else {
+            ASSERT_MSG(segment_begin == cursor, "Count may underflow!");
+            if (count == 1) {
+                if (run_end != segment_begin) {
+                    flush_run(false);
+                    run_begin = segment_begin;
+                }
+                run_end = segment_end;
             }
-            cache_bytes += PAGE_SIZE;
-        } else if (cache_bytes > 0) {
-            cpu_memory.RasterizerMarkRegionCached(cache_begin << PAGE_BITS, cache_bytes, true);
-            cache_bytes = 0;
         }
+        cursor = segment_end;
     }
-    if (uncache_bytes > 0) {
-        cpu_memory.RasterizerMarkRegionCached(uncache_begin << PAGE_BITS, uncache_bytes, false);
-    }
-    if (cache_bytes > 0) {
-        cpu_memory.RasterizerMarkRegionCached(cache_begin << PAGE_BITS, cache_bytes, true);
+    if (delta > 0) {
+        if (cursor < page_end) {
+            MarkRegionCached(cursor, page_end, true);
+        }
+        cached_pages += std::make_pair(interval, 1U);
+    } else {
+        ASSERT_MSG(cursor == page_end, "Count may underflow!");
+        flush_run(false);
+        cached_pages -= std::make_pair(interval, 1U);
     }
 }
 
+void RasterizerAccelerated::MarkRegionCached(u64 page_begin, u64 page_end, bool cached) {
+    const u64 num_pages = page_end - page_begin;
+    cpu_memory.RasterizerMarkRegionCached(page_begin << PAGE_BITS, num_pages << PAGE_BITS, cached);
+}
+
 } // namespace VideoCore
@@ -4,8 +4,9 @@
 
 #pragma once
 
-#include <array>
-#include <atomic>
+#include <mutex>
+
+#include <boost/icl/interval_map.hpp>
 
 #include "common/common_types.h"
 #include "video_core/rasterizer_interface.h"
@@ -25,24 +26,17 @@ public:
     void UpdatePagesCachedCount(VAddr addr, u64 size, int delta) override;
 
 private:
-    class CacheEntry final {
-    public:
-        CacheEntry() = default;
-
-        std::atomic_uint16_t& Count(std::size_t page) {
-            return values[page & 3];
-        }
+    using PageCountMap = boost::icl::interval_map<u64, u32>;
+    using PageInterval = PageCountMap::interval_type;
 
-        const std::atomic_uint16_t& Count(std::size_t page) const {
-            return values[page & 3];
-        }
+    /// Marks a run of pages as cached or uncached in the CPU page table in a single call
+    void MarkRegionCached(u64 page_begin, u64 page_end, bool cached);
 
-    private:
-        std::array<std::atomic_uint16_t, 4> values{};
-    };
-    static_assert(sizeof(CacheEntry) == 8, "CacheEntry should be 8 bytes!");
+    /// Run-length map of CPU page indices to the number of times they are cached.
+    /// Pages with a count of zero are absorbed and don't occupy any storage.
+    PageCountMap cached_pages;
+    std::mutex cached_pages_mutex;
 
-    std::array<CacheEntry, 0x1000000> cached_pages;
     Core::Memory::Memory& cpu_memory;
 };
 
@@ -222,7 +222,7 @@ private:
 
     void VisitBlock(const NodeBlock& bb);
 
-    std::string Visit(const Node& node);
+    std::string Visit(Node node);
 
     std::tuple<std::string, std::string, std::size_t> BuildCoords(Operation);
     std::string BuildAoffi(Operation);
@@ -377,11 +377,11 @@ private:
         std::string address;
         std::string_view opname;
         bool robust = false;
-        if (const auto gmem = std::get_if<GmemNode>(&*operation[0])) {
+        if (const auto gmem = std::get_if<GmemNode>(operation[0])) {
             address = GlobalMemoryPointer(*gmem);
             opname = "ATOM";
             robust = true;
-        } else if (const auto smem = std::get_if<SmemNode>(&*operation[0])) {
+        } else if (const auto smem = std::get_if<SmemNode>(operation[0])) {
             address = fmt::format("shared_mem[{}]", Visit(smem->GetAddress()));
             opname = "ATOMS";
         } else {
@@ -1111,7 +1111,7 @@ void ARBDecompiler::DecompileBranchMode() {
         ++basic_block_it;
 
         if (basic_block_it != basic_block_end) {
-            const auto op = std::get_if<OperationNode>(&*bb[bb.size() - 1]);
+            const auto op = std::get_if<OperationNode>(bb[bb.size() - 1]);
             if (!op || op->GetCode() != OperationCode::Branch) {
                 const u32 next_address = basic_block_it->first;
                 AddLine("MOV.U PC.x, {};", next_address);
@@ -1239,8 +1239,8 @@ void ARBDecompiler::VisitBlock(const NodeBlock& bb) {
     }
 }
 
-std::string ARBDecompiler::Visit(const Node& node) {
-    if (const auto operation = std::get_if<OperationNode>(&*node)) {
+std::string ARBDecompiler::Visit(Node node) {
+    if (const auto operation = std::get_if<OperationNode>(node)) {
         if (const auto amend_index = operation->GetAmendIndex()) {
             Visit(ir.GetAmendNode(*amend_index));
         }
@@ -1257,7 +1257,7 @@ std::string ARBDecompiler::Visit(const Node& node) {
         return (this->*decompiler)(*operation);
     }
 
-    if (const auto gpr = std::get_if<GprNode>(&*node)) {
+    if (const auto gpr = std::get_if<GprNode>(node)) {
         const u32 index = gpr->GetIndex();
         if (index == Register::ZeroIndex) {
             return "{0, 0, 0, 0}.x";
@@ -1265,17 +1265,17 @@ std::string ARBDecompiler::Visit(const Node& node) {
         return fmt::format("R{}.x", index);
     }
 
-    if (const auto cv = std::get_if<CustomVarNode>(&*node)) {
+    if (const auto cv = std::get_if<CustomVarNode>(node)) {
         return fmt::format("CV{}.x", cv->GetIndex());
     }
 
-    if (const auto immediate = std::get_if<ImmediateNode>(&*node)) {
+    if (const auto immediate = std::get_if<ImmediateNode>(node)) {
         std::string temporary = AllocTemporary();
         AddLine("MOV.U {}, {};", temporary, immediate->GetValue());
         return temporary;
     }
 
-    if (const auto predicate = std::get_if<PredicateNode>(&*node)) {
+    if (const auto predicate = std::get_if<PredicateNode>(node)) {
         std::string temporary = AllocTemporary();
         switch (const auto index = predicate->GetIndex(); index) {
         case Tegra::Shader::Pred::UnusedIndex:
@@ -1294,7 +1294,7 @@ std::string ARBDecompiler::Visit(const Node& node) {
         return temporary;
     }
 
-    if (const auto abuf = std::get_if<AbufNode>(&*node)) {
+    if (const auto abuf = std::get_if<AbufNode>(node)) {
         if (abuf->IsPhysicalBuffer()) {
             UNIMPLEMENTED_MSG("Physical buffers are not implemented");
             return "{0, 0, 0, 0}.x";
@@ -1357,10 +1357,10 @@ std::string ARBDecompiler::Visit(const Node& node) {
         return "{0, 0, 0, 0}.x";
     }
 
-    if (const auto cbuf = std::get_if<CbufNode>(&*node)) {
+    if (const auto cbuf = std::get_if<CbufNode>(node)) {
         std::string offset_string;
         const auto& offset = cbuf->GetOffset();
-        if (const auto imm = std::get_if<ImmediateNode>(&*offset)) {
+        if (const auto imm = std::get_if<ImmediateNode>(offset)) {
             offset_string = std::to_string(imm->GetValue());
         } else {
             offset_string = Visit(offset);
@@ -1370,32 +1370,32 @@ std::string ARBDecompiler::Visit(const Node& node) {
         return temporary;
     }
 
-    if (const auto gmem = std::get_if<GmemNode>(&*node)) {
+    if (const auto gmem = std::get_if<GmemNode>(node)) {
         std::string temporary = AllocTemporary();
         AddLine("MOV {}, 0;", temporary);
         AddLine("LOAD.U32 {} (NE.x), {};", temporary, GlobalMemoryPointer(*gmem));
         return temporary;
     }
 
-    if (const auto lmem = std::get_if<LmemNode>(&*node)) {
+    if (const auto lmem = std::get_if<LmemNode>(node)) {
         std::string temporary = Visit(lmem->GetAddress());
         AddLine("SHR.U {}, {}, 2;", temporary, temporary);
         AddLine("MOV.U {}, lmem[{}].x;", temporary, temporary);
         return temporary;
     }
 
-    if (const auto smem = std::get_if<SmemNode>(&*node)) {
+    if (const auto smem = std::get_if<SmemNode>(node)) {
         std::string temporary = Visit(smem->GetAddress());
         AddLine("LDS.U32 {}, shared_mem[{}];", temporary, temporary);
         return temporary;
     }
 
-    if (const auto internal_flag = std::get_if<InternalFlagNode>(&*node)) {
+    if (const auto internal_flag = std::get_if<InternalFlagNode>(node)) {
         const std::size_t index = static_cast<std::size_t>(internal_flag->GetFlag());
         return fmt::format("{}.x", INTERNAL_FLAG_NAMES[index]);
     }
 
-    if (const auto conditional = std::get_if<ConditionalNode>(&*node)) {
+    if (const auto conditional = std::get_if<ConditionalNode>(node)) {
         if (const auto amend_index = conditional->GetAmendIndex()) {
             Visit(ir.GetAmendNode(*amend_index));
         }
@@ -1406,7 +1406,7 @@ std::string ARBDecompiler::Visit(const Node& node) {
         return {};
     }
 
-    if ([[maybe_unused]] const auto cmt = std::get_if<CommentNode>(&*node)) {
+    if ([[maybe_unused]] const auto cmt = std::get_if<CommentNode>(node)) {
         // Uncommenting this will generate invalid code. GLASM lacks comments.
         // AddLine("// {}", cmt->GetText());
         return {};
@@ -1511,17 +1511,17 @@ void ARBDecompiler::Exit() {
 }
 
 std::string ARBDecompiler::Assign(Operation operation) {
-    const Node& dest = operation[0];
-    const Node& src = operation[1];
+    const Node dest = operation[0];
+    const Node src = operation[1];
 
     std::string dest_name;
-    if (const auto gpr = std::get_if<GprNode>(&*dest)) {
+    if (const auto gpr = std::get_if<GprNode>(dest)) {
         if (gpr->GetIndex() == Register::ZeroIndex) {
             // Writing to Register::ZeroIndex is a no op
             return {};
         }
         dest_name = fmt::format("R{}.x", gpr->GetIndex());
-    } else if (const auto abuf = std::get_if<AbufNode>(&*dest)) {
+    } else if (const auto abuf = std::get_if<AbufNode>(dest)) {
         const u32 element = abuf->GetElement();
         const char swizzle = Swizzle(element);
         switch (const Attribute::Index index = abuf->GetIndex()) {
@@ -1563,15 +1563,15 @@ std::string ARBDecompiler::Assign(Operation operation) {
                 fmt::format("result.attrib[{}].{}", GetGenericAttributeIndex(index), swizzle);
             break;
         }
-    } else if (const auto lmem = std::get_if<LmemNode>(&*dest)) {
+    } else if (const auto lmem = std::get_if<LmemNode>(dest)) {
         const std::string address = Visit(lmem->GetAddress());
         AddLine("SHR.U {}, {}, 2;", address, address);
         dest_name = fmt::format("lmem[{}].x", address);
-    } else if (const auto smem = std::get_if<SmemNode>(&*dest)) {
+    } else if (const auto smem = std::get_if<SmemNode>(dest)) {
         AddLine("STS.U32 {}, shared_mem[{}];", Visit(src), Visit(smem->GetAddress()));
         ResetTemporaries();
         return {};
-    } else if (const auto gmem = std::get_if<GmemNode>(&*dest)) {
+    } else if (const auto gmem = std::get_if<GmemNode>(dest)) {
         AddLine("IF NE.x;");
         AddLine("STORE.U32 {}, {};", Visit(src), GlobalMemoryPointer(*gmem));
         AddLine("ENDIF;");
@@ -1600,11 +1600,11 @@ std::string ARBDecompiler::FClamp(Operation operation) {
     static constexpr u32 POSITIVE_ONE = 0x3f800000;
 
     std::string temporary = AllocTemporary();
-    const Node& value = operation[0];
-    const Node& low = operation[1];
-    const Node& high = operation[2];
-    const auto* const imm_low = std::get_if<ImmediateNode>(&*low);
-    const auto* const imm_high = std::get_if<ImmediateNode>(&*high);
+    const Node value = operation[0];
+    const Node low = operation[1];
+    const Node high = operation[2];
+    const auto* const imm_low = std::get_if<ImmediateNode>(low);
+    const auto* const imm_high = std::get_if<ImmediateNode>(high);
     if (imm_low && imm_high && imm_low->GetValue() == 0 && imm_high->GetValue() == POSITIVE_ONE) {
         AddLine("MOV.F32.SAT {}, {};", temporary, Visit(value));
     } else {
@@ -1789,12 +1789,12 @@ std::string ARBDecompiler::HPack2(Operation operation) {
 }
 
 std::string ARBDecompiler::LogicalAssign(Operation operation) {
-    const Node& dest = operation[0];
-    const Node& src = operation[1];
+    const Node dest = operation[0];
+    const Node src = operation[1];
 
     std::string target;
 
-    if (const auto pred = std::get_if<PredicateNode>(&*dest)) {
+    if (const auto pred = std::get_if<PredicateNode>(dest)) {
         ASSERT_MSG(!pred->IsNegated(), "Negating logical assignment");
 
         const Tegra::Shader::Pred index = pred->GetIndex();
@@ -1805,7 +1805,7 @@ std::string ARBDecompiler::LogicalAssign(Operation operation) {
             return {};
         }
         target = fmt::format("P{}.x", static_cast<u64>(index));
-    } else if (const auto internal_flag = std::get_if<InternalFlagNode>(&*dest)) {
+    } else if (const auto internal_flag = std::get_if<InternalFlagNode>(dest)) {
         const std::size_t index = static_cast<std::size_t>(internal_flag->GetFlag());
         target = fmt::format("{}.x", INTERNAL_FLAG_NAMES[index]);
     } else {
@@ -351,8 +351,8 @@ bool IsPrecise(Operation operand) {
     return false;
 }
 
-bool IsPrecise(const Node& node) {
-    if (const auto operation = std::get_if<OperationNode>(&*node)) {
+bool IsPrecise(Node node) {
+    if (const auto operation = std::get_if<OperationNode>(node)) {
         return IsPrecise(*operation);
     }
     return false;
@@ -989,8 +989,8 @@ private:
         }
     }
 
-    Expression Visit(const Node& node) {
-        if (const auto operation = std::get_if<OperationNode>(&*node)) {
+    Expression Visit(Node node) {
+        if (const auto operation = std::get_if<OperationNode>(node)) {
             if (const auto amend_index = operation->GetAmendIndex()) {
                 Visit(ir.GetAmendNode(*amend_index)).CheckVoid();
             }
@@ -1007,7 +1007,7 @@ private:
             return (this->*decompiler)(*operation);
         }
 
-        if (const auto gpr = std::get_if<GprNode>(&*node)) {
+        if (const auto gpr = std::get_if<GprNode>(node)) {
             const u32 index = gpr->GetIndex();
             if (index == Register::ZeroIndex) {
                 return {"0U", Type::Uint};
@@ -1015,12 +1015,12 @@ private:
             return {GetRegister(index), Type::Float};
         }
 
-        if (const auto cv = std::get_if<CustomVarNode>(&*node)) {
+        if (const auto cv = std::get_if<CustomVarNode>(node)) {
             const u32 index = cv->GetIndex();
             return {GetCustomVariable(index), Type::Float};
         }
 
-        if (const auto immediate = std::get_if<ImmediateNode>(&*node)) {
+        if (const auto immediate = std::get_if<ImmediateNode>(node)) {
             const u32 value = immediate->GetValue();
             if (value < 10) {
                 // For eyecandy avoid using hex numbers on single digits
@@ -1029,7 +1029,7 @@ private:
             return {fmt::format("0x{:X}U", immediate->GetValue()), Type::Uint};
         }
 
-        if (const auto predicate = std::get_if<PredicateNode>(&*node)) {
+        if (const auto predicate = std::get_if<PredicateNode>(node)) {
             const auto value = [&]() -> std::string {
                 switch (const auto index = predicate->GetIndex(); index) {
                 case Tegra::Shader::Pred::UnusedIndex:
@@ -1046,7 +1046,7 @@ private:
             return {value, Type::Bool};
         }
 
-        if (const auto abuf = std::get_if<AbufNode>(&*node)) {
+        if (const auto abuf = std::get_if<AbufNode>(node)) {
             UNIMPLEMENTED_IF_MSG(abuf->IsPhysicalBuffer() && stage == ShaderType::Geometry,
                                  "Physical attributes in geometry shaders are not implemented");
             if (abuf->IsPhysicalBuffer()) {
@@ -1057,10 +1057,10 @@ private:
             return ReadAttribute(abuf->GetIndex(), abuf->GetElement(), abuf->GetBuffer());
         }
 
-        if (const auto cbuf = std::get_if<CbufNode>(&*node)) {
+        if (const auto cbuf = std::get_if<CbufNode>(node)) {
             const Node offset = cbuf->GetOffset();
 
-            if (const auto immediate = std::get_if<ImmediateNode>(&*offset)) {
+            if (const auto immediate = std::get_if<ImmediateNode>(offset)) {
                 // Direct access
                 const u32 offset_imm = immediate->GetValue();
                 ASSERT_MSG(offset_imm % 4 == 0, "Unaligned cbuf direct access");
@@ -1094,7 +1094,7 @@ private:
             return {result, Type::Uint};
         }
 
-        if (const auto gmem = std::get_if<GmemNode>(&*node)) {
+        if (const auto gmem = std::get_if<GmemNode>(node)) {
             const std::string real = Visit(gmem->GetRealAddress()).AsUint();
             const std::string base = Visit(gmem->GetBaseAddress()).AsUint();
             const std::string final_offset = fmt::format("({} - {}) >> 2", real, base);
@@ -1102,21 +1102,21 @@ private:
                     Type::Uint};
         }
 
-        if (const auto lmem = std::get_if<LmemNode>(&*node)) {
+        if (const auto lmem = std::get_if<LmemNode>(node)) {
             return {
                 fmt::format("{}[{} >> 2]", GetLocalMemory(), Visit(lmem->GetAddress()).AsUint()),
                 Type::Uint};
         }
 
-        if (const auto smem = std::get_if<SmemNode>(&*node)) {
+        if (const auto smem = std::get_if<SmemNode>(node)) {
             return {fmt::format("smem[{} >> 2]", Visit(smem->GetAddress()).AsUint()), Type::Uint};
         }
 
-        if (const auto internal_flag = std::get_if<InternalFlagNode>(&*node)) {
+        if (const auto internal_flag = std::get_if<InternalFlagNode>(node)) {
             return {GetInternalFlag(internal_flag->GetFlag()), Type::Bool};
         }
 
-        if (const auto conditional = std::get_if<ConditionalNode>(&*node)) {
+        if (const auto conditional = std::get_if<ConditionalNode>(node)) {
             if (const auto amend_index = conditional->GetAmendIndex()) {
                 Visit(ir.GetAmendNode(*amend_index)).CheckVoid();
             }
@@ -1131,7 +1131,7 @@ private:
             return {};
         }
 
-        if (const auto comment = std::get_if<CommentNode>(&*node)) {
+        if (const auto comment = std::get_if<CommentNode>(node)) {
             code.AddLine("// " + comment->GetText());
             return {};
         }
@@ -1140,7 +1140,7 @@ private:
         return {};
     }
 
-    Expression ReadAttribute(Attribute::Index attribute, u32 element, const Node& buffer = {}) {
+    Expression ReadAttribute(Attribute::Index attribute, u32 element, Node buffer = {}) {
         const auto GeometryPass = [&](std::string_view name) {
             if (stage == ShaderType::Geometry && buffer) {
                 // TODO(Rodrigo): Guard geometry inputs against out of bound reads. Some games
@@ -1443,7 +1443,7 @@ private:
         std::string expr = ", ";
         switch (type) {
         case Type::Int:
-            if (const auto immediate = std::get_if<ImmediateNode>(&*operand)) {
+            if (const auto immediate = std::get_if<ImmediateNode>(operand)) {
                 // Inline the string as an immediate integer in GLSL (some extra arguments are
                 // required to be constant)
                 expr += std::to_string(static_cast<s32>(immediate->GetValue()));
@@ -1464,8 +1464,8 @@ private:
         return expr;
     }
 
-    std::string ReadTextureOffset(const Node& value) {
-        if (const auto immediate = std::get_if<ImmediateNode>(&*value)) {
+    std::string ReadTextureOffset(Node value) {
+        if (const auto immediate = std::get_if<ImmediateNode>(value)) {
             // Inline the string as an immediate integer in GLSL (AOFFI arguments are required
             // to be constant by the standard).
             return std::to_string(static_cast<s32>(immediate->GetValue()));
@@ -1573,11 +1573,11 @@ private:
     }
 
     Expression Assign(Operation operation) {
-        const Node& dest = operation[0];
-        const Node& src = operation[1];
+        const Node dest = operation[0];
+        const Node src = operation[1];
 
         Expression target;
-        if (const auto gpr = std::get_if<GprNode>(&*dest)) {
+        if (const auto gpr = std::get_if<GprNode>(dest)) {
             if (gpr->GetIndex() == Register::ZeroIndex) {
                 // Writing to Register::ZeroIndex is a no op but we still have to visit the source
                 // as it might have side effects.
@@ -1585,27 +1585,27 @@ private:
                 return {};
             }
             target = {GetRegister(gpr->GetIndex()), Type::Float};
-        } else if (const auto abuf = std::get_if<AbufNode>(&*dest)) {
+        } else if (const auto abuf = std::get_if<AbufNode>(dest)) {
             UNIMPLEMENTED_IF(abuf->IsPhysicalBuffer());
             auto output = GetOutputAttribute(abuf);
             if (!output) {
                 return {};
             }
             target = std::move(*output);
-        } else if (const auto lmem = std::get_if<LmemNode>(&*dest)) {
+        } else if (const auto lmem = std::get_if<LmemNode>(dest)) {
             target = {
                 fmt::format("{}[{} >> 2]", GetLocalMemory(), Visit(lmem->GetAddress()).AsUint()),
                 Type::Uint};
-        } else if (const auto smem = std::get_if<SmemNode>(&*dest)) {
+        } else if (const auto smem = std::get_if<SmemNode>(dest)) {
             ASSERT(stage == ShaderType::Compute);
             target = {fmt::format("smem[{} >> 2]", Visit(smem->GetAddress()).AsUint()), Type::Uint};
-        } else if (const auto gmem = std::get_if<GmemNode>(&*dest)) {
+        } else if (const auto gmem = std::get_if<GmemNode>(dest)) {
             const std::string real = Visit(gmem->GetRealAddress()).AsUint();
             const std::string base = Visit(gmem->GetBaseAddress()).AsUint();
             const std::string final_offset = fmt::format("({} - {}) >> 2", real, base);
             target = {fmt::format("{}[{}]", GetGlobalMemory(gmem->GetDescriptor()), final_offset),
                       Type::Uint};
-        } else if (const auto cv = std::get_if<CustomVarNode>(&*dest)) {
+        } else if (const auto cv = std::get_if<CustomVarNode>(dest)) {
             target = {GetCustomVariable(cv->GetIndex()), Type::Float};
         } else {
             UNREACHABLE_MSG("Assign called without a proper target");
@@ -1928,12 +1928,12 @@ private:
     }
 
     Expression LogicalAssign(Operation operation) {
-        const Node& dest = operation[0];
-        const Node& src = operation[1];
+        const Node dest = operation[0];
+        const Node src = operation[1];
 
         std::string target;
 
-        if (const auto pred = std::get_if<PredicateNode>(&*dest)) {
+        if (const auto pred = std::get_if<PredicateNode>(dest)) {
             ASSERT_MSG(!pred->IsNegated(), "Negating logical assignment");
 
             const auto index = pred->GetIndex();
@@ -1944,7 +1944,7 @@ private:
                 return {};
             }
             target = GetPredicate(index);
-        } else if (const auto flag = std::get_if<InternalFlagNode>(&*dest)) {
+        } else if (const auto flag = std::get_if<InternalFlagNode>(dest)) {
             target = GetInternalFlag(flag->GetFlag());
         }
 
@@ -2198,7 +2198,7 @@ private:
     }
 
     Expression Branch(Operation operation) {
-        const auto target = std::get_if<ImmediateNode>(&*operation[0]);
+        const auto target = std::get_if<ImmediateNode>(operation[0]);
         UNIMPLEMENTED_IF(!target);
 
         code.AddLine("jmp_to = 0x{:X}U;", target->GetValue());
@@ -2216,7 +2216,7 @@ private:
 
     Expression PushFlowStack(Operation operation) {
         const auto stack = std::get<MetaStackClass>(operation.GetMeta());
-        const auto target = std::get_if<ImmediateNode>(&*operation[0]);
+        const auto target = std::get_if<ImmediateNode>(operation[0]);
         UNIMPLEMENTED_IF(!target);
 
         code.AddLine("{}[{}++] = 0x{:X}U;", FlowStackName(stack), FlowStackTopName(stack),
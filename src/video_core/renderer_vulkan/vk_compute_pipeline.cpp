@@ -18,13 +18,13 @@ namespace Vulkan {
 VKComputePipeline::VKComputePipeline(const Device& device_, VKScheduler& scheduler_,
                                      VKDescriptorPool& descriptor_pool_,
                                      VKUpdateDescriptorQueue& update_descriptor_queue_,
-                                     const SPIRVShader& shader_)
+                                     const SPIRVShader& shader_, VkPipelineCache pipeline_cache)
     : device{device_}, scheduler{scheduler_}, entries{shader_.entries},
       descriptor_set_layout{CreateDescriptorSetLayout()},
       descriptor_allocator{descriptor_pool_, *descriptor_set_layout},
       update_descriptor_queue{update_descriptor_queue_}, layout{CreatePipelineLayout()},
       descriptor_template{CreateDescriptorUpdateTemplate()},
-      shader_module{CreateShaderModule(shader_.code)}, pipeline{CreatePipeline()} {}
+      shader_module{CreateShaderModule(shader_.code)}, pipeline{CreatePipeline(pipeline_cache)} {}
 
 VKComputePipeline::~VKComputePipeline() = default;
 
@@ -116,7 +116,7 @@ vk::ShaderModule VKComputePipeline::CreateShaderModule(const std::vector<u32>& c
     });
 }
 
-vk::Pipeline VKComputePipeline::CreatePipeline() const {
+vk::Pipeline VKComputePipeline::CreatePipeline(VkPipelineCache pipeline_cache) const {
 
     VkComputePipelineCreateInfo ci{
         .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
@@ -147,7 +147,7 @@ vk::Pipeline VKComputePipeline::CreatePipeline() const {
         ci.stage.pNext = &subgroup_size_ci;
     }
 
-    return device.GetLogical().CreateComputePipeline(ci);
+    return device.GetLogical().CreateComputePipeline(ci, pipeline_cache);
 }
 
 } // namespace Vulkan
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
 #include "common/common_types.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
 #include "video_core/renderer_vulkan/vk_shader_decompiler.h"
@@ -15,12 +19,30 @@ class Device;
 class VKScheduler;
 class VKUpdateDescriptorQueue;
 
+struct ComputePipelineCacheKey {
+    GPUVAddr shader;
+    u32 shared_memory_size;
+    std::array<u32, 3> workgroup_size;
+
+    std::size_t Hash() const noexcept;
+
+    bool operator==(const ComputePipelineCacheKey& rhs) const noexcept;
+
+    bool operator!=(const ComputePipelineCacheKey& rhs) const noexcept {
+        return !operator==(rhs);
+    }
+};
+static_assert(std::has_unique_object_representations_v<ComputePipelineCacheKey>);
+static_assert(std::is_trivially_copyable_v<ComputePipelineCacheKey>);
+static_assert(std::is_trivially_constructible_v<ComputePipelineCacheKey>);
+
 class VKComputePipeline final {
 public:
     explicit VKComputePipeline(const Device& device_, VKScheduler& scheduler_,
                                VKDescriptorPool& descriptor_pool_,
                                VKUpdateDescriptorQueue& update_descriptor_queue_,
-                               const SPIRVShader& shader_);
+                               const SPIRVShader& shader_,
+                               VkPipelineCache pipeline_cache = nullptr);
     ~VKComputePipeline();
 
     VkDescriptorSet CommitDescriptorSet();
@@ -46,7 +68,7 @@ private:
 
     vk::ShaderModule CreateShaderModule(const std::vector<u32>& code) const;
 
-    vk::Pipeline CreatePipeline() const;
+    vk::Pipeline CreatePipeline(VkPipelineCache pipeline_cache) const;
 
     const Device& device;
     VKScheduler& scheduler;
@@ -5,11 +5,21 @@
 #include <algorithm>
 #include <cstddef>
 #include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "common/bit_cast.h"
 #include "common/cityhash.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/settings.h"
+#include "common/thread_worker.h"
 #include "core/core.h"
 #include "core/memory.h"
 #include "video_core/engines/kepler_compute.h"
@@ -38,6 +48,7 @@ MICROPROFILE_DECLARE(Vulkan_PipelineCache);
 using Tegra::Engines::ShaderType;
 using VideoCommon::Shader::GetShaderAddress;
 using VideoCommon::Shader::GetShaderCode;
+using VideoCommon::Shader::GetUniqueIdentifier;
 using VideoCommon::Shader::KERNEL_MAIN_OFFSET;
 using VideoCommon::Shader::ProgramCode;
 using VideoCommon::Shader::STAGE_MAIN_OFFSET;
@@ -56,6 +67,16 @@ constexpr VideoCommon::Shader::CompilerSettings compiler_settings{
     .disable_else_derivation = true,
 };
 
+vk::PipelineCache CreateDriverCache(const Device& device, std::span<const u8> initial_data) {
+    return device.GetLogical().CreatePipelineCache({
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .initialDataSize = initial_data.size(),
+        .pInitialData = initial_data.data(),
+    });
+}
+
 constexpr std::size_t GetStageFromProgram(std::size_t program) {
     return program == 0 ? 0 : program - 1;
 }
@@ -102,6 +123,29 @@ void AddBindings(std::vector<VkDescriptorSetLayoutBinding>& bindings, u32& bindi
     }
 }
 
+Specialization MakeGraphicsSpecialization(const FixedPipelineState& fixed_state) {
+    Specialization specialization;
+    if (fixed_state.topology == Maxwell::PrimitiveTopology::Points) {
+        float point_size;
+        std::memcpy(&point_size, &fixed_state.point_size, sizeof(float));
+        specialization.point_size = point_size;
+        ASSERT(point_size != 0.0f);
+    }
+    for (std::size_t i = 0; i < Maxwell::NumVertexAttributes; ++i) {
+        const auto& attribute = fixed_state.attributes[i];
+        specialization.enabled_attributes[i] = attribute.enabled.Value() != 0;
+        specialization.attribute_types[i] = attribute.Type();
+    }
+    specialization.ndc_minus_one_to_one = fixed_state.ndc_minus_one_to_one;
+    specialization.early_fragment_tests = fixed_state.early_z;
+
+    // Alpha test
+    specialization.alpha_test_func =
+        FixedPipelineState::UnpackComparisonOp(fixed_state.alpha_test_func.Value());
+    specialization.alpha_test_ref = Common::BitCast<float>(fixed_state.alpha_test_ref);
+    return specialization;
+}
+
 u32 FillDescriptorLayout(const ShaderEntries& entries,
                          std::vector<VkDescriptorSetLayoutBinding>& bindings,
                          Maxwell::ShaderProgram program_type, u32 base_binding) {
@@ -140,8 +184,9 @@ bool ComputePipelineCacheKey::operator==(const ComputePipelineCacheKey& rhs) con
 
 Shader::Shader(Tegra::Engines::ConstBufferEngineInterface& engine_, ShaderType stage_,
                GPUVAddr gpu_addr_, VAddr cpu_addr_, ProgramCode program_code_, u32 main_offset_)
-    : gpu_addr(gpu_addr_), program_code(std::move(program_code_)), registry(stage_, engine_),
-      shader_ir(program_code, main_offset_, compiler_settings, registry),
+    : gpu_addr(gpu_addr_), program_code(std::move(program_code_)),
+      unique_identifier(GetUniqueIdentifier(stage_, false, program_code)),
+      registry(stage_, engine_), shader_ir(program_code, main_offset_, compiler_settings, registry),
       entries(GenerateShaderEntries(shader_ir)) {}
 
 Shader::~Shader() = default;
@@ -154,10 +199,177 @@ VKPipelineCache::VKPipelineCache(RasterizerVulkan& rasterizer_, Tegra::GPU& gpu_
                                  VKUpdateDescriptorQueue& update_descriptor_queue_)
     : VideoCommon::ShaderCache<Shader>{rasterizer_}, gpu{gpu_}, maxwell3d{maxwell3d_},
       kepler_compute{kepler_compute_}, gpu_memory{gpu_memory_}, device{device_},
-      scheduler{scheduler_}, descriptor_pool{descriptor_pool_}, update_descriptor_queue{
-                                                                    update_descriptor_queue_} {}
+      scheduler{scheduler_}, descriptor_pool{descriptor_pool_},
+      update_descriptor_queue{update_descriptor_queue_},
+      driver_cache{CreateDriverCache(device_, {})}, disk_cache{device_} {}
+
+VKPipelineCache::~VKPipelineCache() {
+    SaveDriverCache();
+}
+
+void VKPipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
+                                        const VideoCore::DiskResourceLoadCallback& callback,
+                                        TextureCacheRuntime& texture_cache_runtime) {
+    if (!Settings::values.use_disk_shader_cache.GetValue() || title_id == 0) {
+        return;
+    }
+    const auto base_dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::ShaderDir) / "vulkan";
+    if (!Common::FS::CreateDirs(base_dir)) {
+        LOG_ERROR(Render_Vulkan, "Failed to create directory={}",
+                  Common::FS::PathToUTF8String(base_dir));
+        return;
+    }
+    driver_cache_path = base_dir / fmt::format("{:016X}.bin", title_id);
+
+    // The driver cache has to be seeded before the pipelines are rebuilt against it
+    LoadDriverCache();
+
+    auto entries = disk_cache.Load(base_dir, title_id);
+    if (stop_loading.stop_requested()) {
+        return;
+    }
+    PrewarmPipelines(stop_loading, callback, texture_cache_runtime, std::move(entries.first),
+                     std::move(entries.second));
+    if (callback) {
+        callback(VideoCore::LoadCallbackStage::Complete, 0, 0);
+    }
+}
 
-VKPipelineCache::~VKPipelineCache() = default;
+void VKPipelineCache::LoadDriverCache() {
+    std::vector<u8> data;
+    {
+        const Common::FS::IOFile file{driver_cache_path, Common::FS::FileAccessMode::Read,
+                                      Common::FS::FileType::BinaryFile};
+        if (!file.IsOpen()) {
+            return;
+        }
+        data.resize(file.GetSize());
+        if (file.Read(data) != data.size()) {
+            LOG_ERROR(Render_Vulkan, "Failed to read pipeline cache file, ignoring");
+            return;
+        }
+    }
+    // Drivers validate the blob header against the device and discard incompatible data
+    try {
+        driver_cache = CreateDriverCache(device, data);
+    } catch (const vk::Exception& exception) {
+        LOG_ERROR(Render_Vulkan, "Failed to seed the pipeline cache: {}", exception.what());
+        return;
+    }
+    LOG_INFO(Render_Vulkan, "Loaded {} bytes of driver pipeline cache", data.size());
+}
+
+void VKPipelineCache::PrewarmPipelines(std::stop_token stop_loading,
+                                       const VideoCore::DiskResourceLoadCallback& callback,
+                                       TextureCacheRuntime& texture_cache_runtime,
+                                       std::vector<GraphicsPipelineDiskEntry> graphics_entries,
+                                       std::vector<ComputePipelineDiskEntry> compute_entries) {
+    // A key is saved again when its guest code changed between runs, only build the latest one
+    std::unordered_map<GraphicsPipelineCacheKey, GraphicsPipelineDiskEntry*> graphics_keys;
+    for (GraphicsPipelineDiskEntry& entry : graphics_entries) {
+        // Render passes are created here, the builder threads only read their handles
+        entry.key.renderpass = texture_cache_runtime.RenderPass(entry.renderpass_key);
+        graphics_keys.insert_or_assign(entry.key, &entry);
+    }
+    std::unordered_map<ComputePipelineCacheKey, ComputePipelineDiskEntry*> compute_keys;
+    for (ComputePipelineDiskEntry& entry : compute_entries) {
+        compute_keys.insert_or_assign(entry.key, &entry);
+    }
+    const std::size_t total = graphics_keys.size() + compute_keys.size();
+    if (total == 0) {
+        return;
+    }
+    LOG_INFO(Render_Vulkan, "Building {} pipelines from the disk cache", total);
+
+    std::mutex mutex;
+    std::size_t built = 0;
+    const auto on_built = [&] {
+        // Called with the mutex locked
+        ++built;
+        if (callback) {
+            callback(VideoCore::LoadCallbackStage::Build, built, total);
+        }
+    };
+    const u32 num_workers = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+    Common::ThreadWorker workers(num_workers, "yuzu:PipelineBuilder");
+    for (const auto& [key, entry] : graphics_keys) {
+        workers.QueueWork([this, &mutex, &on_built, &stop_loading, disk_entry = entry] {
+            if (stop_loading.stop_requested()) {
+                return;
+            }
+            std::vector<VkDescriptorSetLayoutBinding> bindings;
+            u32 base_binding = 0;
+            for (std::size_t stage = 0; stage < Maxwell::MaxShaderStage; ++stage) {
+                if (const auto& shader = disk_entry->program[stage]) {
+                    const auto program_type = static_cast<Maxwell::ShaderProgram>(stage + 1);
+                    base_binding =
+                        FillDescriptorLayout(shader->entries, bindings, program_type, base_binding);
+                }
+            }
+            std::unique_ptr<VKGraphicsPipeline> pipeline;
+            try {
+                pipeline = std::make_unique<VKGraphicsPipeline>(
+                    device, scheduler, descriptor_pool, update_descriptor_queue, disk_entry->key,
+                    bindings, disk_entry->program, disk_entry->num_color_buffers, *driver_cache);
+            } catch (const vk::Exception& exception) {
+                LOG_ERROR(Render_Vulkan, "Failed to build a cached pipeline: {}",
+                          exception.what());
+                return;
+            }
+            std::scoped_lock lock{mutex};
+            prewarmed_graphics.insert_or_assign(
+                disk_entry->key, PrewarmedGraphicsPipeline{
+                                     .pipeline = std::move(pipeline),
+                                     .unique_identifiers = disk_entry->unique_identifiers,
+                                 });
+            on_built();
+        });
+    }
+    for (const auto& [key, entry] : compute_keys) {
+        workers.QueueWork([this, &mutex, &on_built, &stop_loading, disk_entry = entry] {
+            if (stop_loading.stop_requested()) {
+                return;
+            }
+            std::unique_ptr<VKComputePipeline> pipeline;
+            try {
+                pipeline = std::make_unique<VKComputePipeline>(device, scheduler, descriptor_pool,
+                                                               update_descriptor_queue,
+                                                               disk_entry->shader, *driver_cache);
+            } catch (const vk::Exception& exception) {
+                LOG_ERROR(Render_Vulkan, "Failed to build a cached pipeline: {}",
+                          exception.what());
+                return;
+            }
+            std::scoped_lock lock{mutex};
+            prewarmed_compute.insert_or_assign(
+                disk_entry->key, PrewarmedComputePipeline{
+                                     .pipeline = std::move(pipeline),
+                                     .unique_identifier = disk_entry->unique_identifier,
+                                 });
+            on_built();
+        });
+    }
+    workers.WaitForRequests(stop_loading);
+}
+
+void VKPipelineCache::SaveDriverCache() const {
+    if (driver_cache_path.empty() || !driver_cache) {
+        return;
+    }
+    std::vector<u8> data;
+    try {
+        data = driver_cache.GetData();
+    } catch (const vk::Exception& exception) {
+        LOG_ERROR(Render_Vulkan, "Failed to read the pipeline cache: {}", exception.what());
+        return;
+    }
+    const Common::FS::IOFile file{driver_cache_path, Common::FS::FileAccessMode::Write,
+                                  Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen() || file.Write(data) != data.size()) {
+        LOG_ERROR(Render_Vulkan, "Failed to write pipeline cache file={}",
+                  Common::FS::PathToUTF8String(driver_cache_path));
+    }
+}
 
 std::array<Shader*, Maxwell::MaxShaderProgram> VKPipelineCache::GetShaders() {
     std::array<Shader*, Maxwell::MaxShaderProgram> shaders{};
@@ -200,7 +412,7 @@ std::array<Shader*, Maxwell::MaxShaderProgram> VKPipelineCache::GetShaders() {
 }
 
 VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
-    const GraphicsPipelineCacheKey& key, u32 num_color_buffers,
+    const GraphicsPipelineCacheKey& key, const Framebuffer& framebuffer,
     VideoCommon::Shader::AsyncShaders& async_shaders) {
     MICROPROFILE_SCOPE(Vulkan_PipelineCache);
 
@@ -209,16 +421,22 @@ VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
     }
     last_graphics_key = key;
 
+    const u32 num_color_buffers = framebuffer.NumColorBuffers();
     if (device.UseAsynchronousShaders() && async_shaders.IsShaderAsync(gpu)) {
         std::unique_lock lock{pipeline_cache};
         const auto [pair, is_cache_miss] = graphics_cache.try_emplace(key);
         if (is_cache_miss) {
+            pair->second = TakePrewarmedPipeline(key);
+        }
+        if (is_cache_miss && !pair->second) {
             gpu.ShaderNotify().MarkSharderBuilding();
             LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
-            const auto [program, bindings] = DecompileShaders(key.fixed_state);
+            auto [program, bindings] = DeferShaders(key.fixed_state);
+            program.renderpass_key = framebuffer.GetRenderPassKey();
+            program.num_color_buffers = num_color_buffers;
             async_shaders.QueueVulkanShader(this, device, scheduler, descriptor_pool,
-                                            update_descriptor_queue, bindings, program, key,
-                                            num_color_buffers);
+                                            update_descriptor_queue, std::move(bindings),
+                                            std::move(program), key, num_color_buffers);
         }
         last_graphics_pipeline = pair->second.get();
         return last_graphics_pipeline;
@@ -227,12 +445,24 @@ VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
     const auto [pair, is_cache_miss] = graphics_cache.try_emplace(key);
     auto& entry = pair->second;
     if (is_cache_miss) {
+        entry = TakePrewarmedPipeline(key);
+    }
+    if (is_cache_miss && !entry) {
         gpu.ShaderNotify().MarkSharderBuilding();
         LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
-        const auto [program, bindings] = DecompileShaders(key.fixed_state);
+        auto [program, bindings] = DecompileShaders(key.fixed_state);
         entry = std::make_unique<VKGraphicsPipeline>(device, scheduler, descriptor_pool,
                                                      update_descriptor_queue, key, bindings,
-                                                     program, num_color_buffers);
+                                                     program, num_color_buffers, *driver_cache);
+        if (disk_cache.IsEnabled()) {
+            disk_cache.SaveGraphicsPipeline({
+                .key = key,
+                .renderpass_key = framebuffer.GetRenderPassKey(),
+                .num_color_buffers = num_color_buffers,
+                .unique_identifiers = GetStageIdentifiers(),
+                .program = std::move(program),
+            });
+        }
         gpu.ShaderNotify().MarkShaderComplete();
     }
     last_graphics_pipeline = entry.get();
@@ -273,6 +503,15 @@ VKComputePipeline& VKPipelineCache::GetComputePipeline(const ComputePipelineCach
         }
     }
 
+    if (const auto it = prewarmed_compute.find(key); it != prewarmed_compute.end()) {
+        PrewarmedComputePipeline prewarmed = std::move(it->second);
+        prewarmed_compute.erase(it);
+        if (prewarmed.unique_identifier == shader->GetUniqueIdentifier()) {
+            entry = std::move(prewarmed.pipeline);
+            return *entry;
+        }
+    }
+
     const Specialization specialization{
         .base_binding = 0,
         .workgroup_size = key.workgroup_size,
@@ -286,16 +525,67 @@ VKComputePipeline& VKPipelineCache::GetComputePipeline(const ComputePipelineCach
                                              shader->GetRegistry(), specialization),
                                    shader->GetEntries()};
     entry = std::make_unique<VKComputePipeline>(device, scheduler, descriptor_pool,
-                                                update_descriptor_queue, spirv_shader);
+                                                update_descriptor_queue, spirv_shader,
+                                                *driver_cache);
+    if (disk_cache.IsEnabled()) {
+        disk_cache.SaveComputePipeline({
+            .key = key,
+            .unique_identifier = shader->GetUniqueIdentifier(),
+            .shader = spirv_shader,
+        });
+    }
     return *entry;
 }
 
-void VKPipelineCache::EmplacePipeline(std::unique_ptr<VKGraphicsPipeline> pipeline) {
+void VKPipelineCache::EmplacePipeline(std::unique_ptr<VKGraphicsPipeline> pipeline,
+                                      const DeferredProgram& deferred,
+                                      const SPIRVProgram& program) {
+    if (disk_cache.IsEnabled()) {
+        GraphicsPipelineDiskEntry disk_entry{
+            .key = pipeline->GetCacheKey(),
+            .renderpass_key = deferred.renderpass_key,
+            .num_color_buffers = deferred.num_color_buffers,
+            .unique_identifiers{},
+            .program = program,
+        };
+        for (std::size_t stage = 0; stage < Maxwell::MaxShaderStage; ++stage) {
+            if (deferred.stages[stage]) {
+                disk_entry.unique_identifiers[stage] = deferred.stages[stage]->unique_identifier;
+            }
+        }
+        disk_cache.SaveGraphicsPipeline(disk_entry);
+    }
     gpu.ShaderNotify().MarkShaderComplete();
     std::unique_lock lock{pipeline_cache};
     graphics_cache.at(pipeline->GetCacheKey()) = std::move(pipeline);
 }
 
+std::unique_ptr<VKGraphicsPipeline> VKPipelineCache::TakePrewarmedPipeline(
+    const GraphicsPipelineCacheKey& key) {
+    const auto it = prewarmed_graphics.find(key);
+    if (it == prewarmed_graphics.end()) {
+        return nullptr;
+    }
+    PrewarmedGraphicsPipeline prewarmed = std::move(it->second);
+    prewarmed_graphics.erase(it);
+
+    // Guest code might have changed at the same addresses since the pipeline was saved
+    if (prewarmed.unique_identifiers != GetStageIdentifiers()) {
+        return nullptr;
+    }
+    return std::move(prewarmed.pipeline);
+}
+
+std::array<u64, Maxwell::MaxShaderStage> VKPipelineCache::GetStageIdentifiers() const {
+    std::array<u64, Maxwell::MaxShaderStage> identifiers{};
+    for (std::size_t index = 1; index < Maxwell::MaxShaderProgram; ++index) {
+        if (const Shader* const shader = last_shaders[index]) {
+            identifiers[GetStageFromProgram(index)] = shader->GetUniqueIdentifier();
+        }
+    }
+    return identifiers;
+}
+
 void VKPipelineCache::OnShaderRemoval(Shader* shader) {
     bool finished = false;
     const auto Finish = [&] {
@@ -332,26 +622,7 @@ void VKPipelineCache::OnShaderRemoval(Shader* shader) {
 
 std::pair<SPIRVProgram, std::vector<VkDescriptorSetLayoutBinding>>
 VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
-    Specialization specialization;
-    if (fixed_state.topology == Maxwell::PrimitiveTopology::Points) {
-        float point_size;
-        std::memcpy(&point_size, &fixed_state.point_size, sizeof(float));
-        specialization.point_size = point_size;
-        ASSERT(point_size != 0.0f);
-    }
-    for (std::size_t i = 0; i < Maxwell::NumVertexAttributes; ++i) {
-        const auto& attribute = fixed_state.attributes[i];
-        specialization.enabled_attributes[i] = attribute.enabled.Value() != 0;
-        specialization.attribute_types[i] = attribute.Type();
-    }
-    specialization.ndc_minus_one_to_one = fixed_state.ndc_minus_one_to_one;
-    specialization.early_fragment_tests = fixed_state.early_z;
-
-    // Alpha test
-    specialization.alpha_test_func =
-        FixedPipelineState::UnpackComparisonOp(fixed_state.alpha_test_func.Value());
-    specialization.alpha_test_ref = Common::BitCast<float>(fixed_state.alpha_test_ref);
-
+    Specialization specialization = MakeGraphicsSpecialization(fixed_state);
     SPIRVProgram program;
     std::vector<VkDescriptorSetLayoutBinding> bindings;
 
@@ -381,6 +652,63 @@ VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
     return {std::move(program), std::move(bindings)};
 }
 
+std::pair<DeferredProgram, std::vector<VkDescriptorSetLayoutBinding>>
+VKPipelineCache::DeferShaders(const FixedPipelineState& fixed_state) {
+    DeferredProgram program{
+        .stages{},
+        .specialization = MakeGraphicsSpecialization(fixed_state),
+        .renderpass_key{},
+        .num_color_buffers = 0,
+    };
+    std::vector<VkDescriptorSetLayoutBinding> bindings;
+    u32 base_binding = 0;
+
+    for (std::size_t index = 1; index < Maxwell::MaxShaderProgram; ++index) {
+        const auto program_enum = static_cast<Maxwell::ShaderProgram>(index);
+        // Skip stages that are not enabled
+        if (!maxwell3d.regs.IsShaderConfigEnabled(index)) {
+            continue;
+        }
+        const GPUVAddr gpu_addr = GetShaderAddress(maxwell3d, program_enum);
+        const std::optional<VAddr> cpu_addr = gpu_memory.GpuToCpuAddress(gpu_addr);
+        Shader* const shader = cpu_addr ? TryGet(*cpu_addr) : null_shader.get();
+
+        const std::size_t stage = index == 0 ? 0 : index - 1; // Stage indices are 0 - 5
+        const auto& entries = shader->GetEntries();
+        program.stages[stage].emplace(DeferredShaderStage{
+            .type = GetShaderType(program_enum),
+            .unique_identifier = shader->GetUniqueIdentifier(),
+            .code = shader->GetCode(),
+            .registry = shader->GetRegistry().Snapshot(),
+            .entries = entries,
+        });
+        base_binding = FillDescriptorLayout(entries, bindings, program_enum, base_binding);
+    }
+    return {std::move(program), std::move(bindings)};
+}
+
+SPIRVProgram DecompileDeferredProgram(const Device& device, DeferredProgram& deferred) {
+    Specialization& specialization = deferred.specialization;
+    SPIRVProgram program;
+    for (std::size_t stage = 0; stage < Maxwell::MaxShaderStage; ++stage) {
+        auto& source = deferred.stages[stage];
+        if (!source) {
+            continue;
+        }
+        // The snapshot is detached from the engines and holds every key, sampler and the driver
+        // profile the GPU thread decode of this same code obtained. Decoding it again with the
+        // same settings issues the same queries, so they are all answered from the snapshot.
+        const VideoCommon::Shader::ShaderIR ir(source->code, STAGE_MAIN_OFFSET, compiler_settings,
+                                               source->registry);
+        program[stage] = {
+            Decompile(device, ir, source->type, source->registry, specialization),
+            std::move(source->entries),
+        };
+        specialization.base_binding += program[stage]->entries.NumBindings();
+    }
+    return program;
+}
+
 template <VkDescriptorType descriptor_type, class Container>
 void AddEntry(std::vector<VkDescriptorUpdateTemplateEntry>& template_entries, u32& binding,
               u32& offset, const Container& container) {
@@ -6,7 +6,9 @@
 
 #include <array>
 #include <cstddef>
+#include <filesystem>
 #include <memory>
+#include <stop_token>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -17,8 +19,10 @@
 #include "common/common_types.h"
 #include "video_core/engines/const_buffer_engine_interface.h"
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_vulkan/fixed_pipeline_state.h"
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
+#include "video_core/renderer_vulkan/vk_pipeline_disk_cache.h"
 #include "video_core/renderer_vulkan/vk_shader_decompiler.h"
 #include "video_core/shader/async_shaders.h"
 #include "video_core/shader/memory_util.h"
@@ -35,30 +39,12 @@ namespace Vulkan {
 
 class Device;
 class RasterizerVulkan;
-class VKComputePipeline;
 class VKDescriptorPool;
 class VKScheduler;
 class VKUpdateDescriptorQueue;
 
 using Maxwell = Tegra::Engines::Maxwell3D::Regs;
 
-struct ComputePipelineCacheKey {
-    GPUVAddr shader;
-    u32 shared_memory_size;
-    std::array<u32, 3> workgroup_size;
-
-    std::size_t Hash() const noexcept;
-
-    bool operator==(const ComputePipelineCacheKey& rhs) const noexcept;
-
-    bool operator!=(const ComputePipelineCacheKey& rhs) const noexcept {
-        return !operator==(rhs);
-    }
-};
-static_assert(std::has_unique_object_representations_v<ComputePipelineCacheKey>);
-static_assert(std::is_trivially_copyable_v<ComputePipelineCacheKey>);
-static_assert(std::is_trivially_constructible_v<ComputePipelineCacheKey>);
-
 } // namespace Vulkan
 
 namespace std {
@@ -108,14 +94,40 @@ public:
         return entries;
     }
 
+    const VideoCommon::Shader::ProgramCode& GetCode() const {
+        return program_code;
+    }
+
+    u64 GetUniqueIdentifier() const {
+        return unique_identifier;
+    }
+
 private:
     GPUVAddr gpu_addr{};
     VideoCommon::Shader::ProgramCode program_code;
+    u64 unique_identifier{};
     VideoCommon::Shader::Registry registry;
     VideoCommon::Shader::ShaderIR shader_ir;
     ShaderEntries entries;
 };
 
+/// Guest shader stage captured on the GPU thread, it is decoded again on a shader worker
+struct DeferredShaderStage {
+    Tegra::Engines::ShaderType type;
+    u64 unique_identifier;
+    VideoCommon::Shader::ProgramCode code;
+    VideoCommon::Shader::Registry registry; ///< Snapshot, never touches the engines
+    ShaderEntries entries;
+};
+
+/// Graphics program whose decode and SPIR-V emission have been deferred to a shader worker
+struct DeferredProgram {
+    std::array<std::optional<DeferredShaderStage>, Maxwell::MaxShaderStage> stages;
+    Specialization specialization;
+    RenderPassKey renderpass_key;
+    u32 num_color_buffers;
+};
+
 class VKPipelineCache final : public VideoCommon::ShaderCache<Shader> {
 public:
     explicit VKPipelineCache(RasterizerVulkan& rasterizer, Tegra::GPU& gpu,
@@ -129,12 +141,25 @@ public:
     std::array<Shader*, Maxwell::MaxShaderProgram> GetShaders();
 
     VKGraphicsPipeline* GetGraphicsPipeline(const GraphicsPipelineCacheKey& key,
-                                            u32 num_color_buffers,
+                                            const Framebuffer& framebuffer,
                                             VideoCommon::Shader::AsyncShaders& async_shaders);
 
     VKComputePipeline& GetComputePipeline(const ComputePipelineCacheKey& key);
 
-    void EmplacePipeline(std::unique_ptr<VKGraphicsPipeline> pipeline);
+    /// Inserts a pipeline built by a shader worker, deferred and program are saved to disk
+    void EmplacePipeline(std::unique_ptr<VKGraphicsPipeline> pipeline,
+                         const DeferredProgram& deferred, const SPIRVProgram& program);
+
+    /// Seeds the driver pipeline cache with the blob saved by a previous run of the title and
+    /// builds the pipelines it saved, in parallel. Must be called before any pipeline is built.
+    void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
+                           const VideoCore::DiskResourceLoadCallback& callback,
+                           TextureCacheRuntime& texture_cache_runtime);
+
+    /// Returns the driver pipeline cache that all pipelines are built against
+    VkPipelineCache GetDriverCache() const noexcept {
+        return *driver_cache;
+    }
 
 protected:
     void OnShaderRemoval(Shader* shader) final;
@@ -143,6 +168,29 @@ private:
     std::pair<SPIRVProgram, std::vector<VkDescriptorSetLayoutBinding>> DecompileShaders(
         const FixedPipelineState& fixed_state);
 
+    /// Captures the bound graphics shaders so they can be decompiled outside of the GPU thread
+    std::pair<DeferredProgram, std::vector<VkDescriptorSetLayoutBinding>> DeferShaders(
+        const FixedPipelineState& fixed_state);
+
+    /// Reads the driver pipeline cache blob saved by a previous run of the title
+    void LoadDriverCache();
+
+    /// Writes the driver pipeline cache blob to disk, if a title has been loaded
+    void SaveDriverCache() const;
+
+    /// Builds the pipelines saved by previous runs of the title on a pool of threads
+    void PrewarmPipelines(std::stop_token stop_loading,
+                          const VideoCore::DiskResourceLoadCallback& callback,
+                          TextureCacheRuntime& texture_cache_runtime,
+                          std::vector<GraphicsPipelineDiskEntry> graphics_entries,
+                          std::vector<ComputePipelineDiskEntry> compute_entries);
+
+    /// Returns the prewarmed pipeline of a key if it was built from the bound guest shaders
+    std::unique_ptr<VKGraphicsPipeline> TakePrewarmedPipeline(const GraphicsPipelineCacheKey& key);
+
+    /// Returns the identifiers of the bound guest shaders, indexed by stage
+    std::array<u64, Maxwell::MaxShaderStage> GetStageIdentifiers() const;
+
     Tegra::GPU& gpu;
     Tegra::Engines::Maxwell3D& maxwell3d;
     Tegra::Engines::KeplerCompute& kepler_compute;
@@ -153,6 +201,10 @@ private:
     VKDescriptorPool& descriptor_pool;
     VKUpdateDescriptorQueue& update_descriptor_queue;
 
+    std::filesystem::path driver_cache_path;
+    vk::PipelineCache driver_cache;
+    PipelineDiskCache disk_cache;
+
     std::unique_ptr<Shader> null_shader;
     std::unique_ptr<Shader> null_kernel;
 
@@ -165,8 +217,24 @@ private:
     std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<VKGraphicsPipeline>>
         graphics_cache;
     std::unordered_map<ComputePipelineCacheKey, std::unique_ptr<VKComputePipeline>> compute_cache;
+
+    struct PrewarmedGraphicsPipeline {
+        std::unique_ptr<VKGraphicsPipeline> pipeline;
+        std::array<u64, Maxwell::MaxShaderStage> unique_identifiers;
+    };
+    struct PrewarmedComputePipeline {
+        std::unique_ptr<VKComputePipeline> pipeline;
+        u64 unique_identifier;
+    };
+    /// Pipelines built from the disk cache, they are moved to the caches above once the guest
+    /// binds the same shaders again
+    std::unordered_map<GraphicsPipelineCacheKey, PrewarmedGraphicsPipeline> prewarmed_graphics;
+    std::unordered_map<ComputePipelineCacheKey, PrewarmedComputePipeline> prewarmed_compute;
 };
 
+/// Decodes and decompiles a deferred program, it can be called from any thread
+SPIRVProgram DecompileDeferredProgram(const Device& device, DeferredProgram& deferred);
+
 void FillDescriptorUpdateTemplateEntries(
     const ShaderEntries& entries, u32& binding, u32& offset,
     std::vector<VkDescriptorUpdateTemplateEntryKHR>& template_entries);
@@ -0,0 +1,266 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "video_core/renderer_vulkan/vk_pipeline_disk_cache.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+
+namespace Vulkan {
+
+using Common::FS::IOFile;
+
+namespace {
+
+constexpr u32 NativeVersion = 1;
+
+enum class EntryType : u32 {
+    Graphics,
+    Compute,
+};
+
+template <typename T>
+bool WriteVector(const IOFile& file, const std::vector<T>& vector) {
+    return file.WriteObject(static_cast<u32>(vector.size())) && file.Write(vector) == vector.size();
+}
+
+/// Reads a vector of trivially copyable entries, placeholder gives a value to types without a
+/// default constructor before they are overwritten
+template <typename T>
+bool ReadVector(const IOFile& file, std::vector<T>& vector, const T& placeholder = T{}) {
+    u32 size;
+    if (!file.ReadObject(size)) {
+        return false;
+    }
+    vector.assign(size, placeholder);
+    return file.Read(vector) == size;
+}
+
+bool SaveShader(const IOFile& file, const SPIRVShader& shader) {
+    const ShaderEntries& entries = shader.entries;
+    const std::vector<u32> attributes(entries.attributes.begin(), entries.attributes.end());
+    return WriteVector(file, shader.code) && WriteVector(file, entries.const_buffers) &&
+           WriteVector(file, entries.global_buffers) &&
+           WriteVector(file, entries.uniform_texels) && WriteVector(file, entries.samplers) &&
+           WriteVector(file, entries.storage_texels) && WriteVector(file, entries.images) &&
+           WriteVector(file, attributes) && file.WriteObject(entries.clip_distances) &&
+           file.WriteObject(static_cast<u64>(entries.shader_length)) &&
+           file.WriteObject(entries.enabled_uniform_buffers) &&
+           file.WriteObject(entries.uses_warps);
+}
+
+bool LoadShader(const IOFile& file, SPIRVShader& shader) {
+    using Tegra::Shader::ImageType;
+    using Tegra::Shader::TextureType;
+    const SamplerEntry sampler_placeholder(0, 0, TextureType{}, false, false, false, false);
+    const ImageEntry image_placeholder(0, 0, ImageType{});
+
+    ShaderEntries& entries = shader.entries;
+    std::vector<u32> attributes;
+    u64 shader_length;
+    if (!ReadVector(file, shader.code) ||
+        !ReadVector(file, entries.const_buffers, ConstBufferEntry({}, 0)) ||
+        !ReadVector(file, entries.global_buffers) ||
+        !ReadVector(file, entries.uniform_texels, sampler_placeholder) ||
+        !ReadVector(file, entries.samplers, sampler_placeholder) ||
+        !ReadVector(file, entries.storage_texels, image_placeholder) ||
+        !ReadVector(file, entries.images, image_placeholder) || !ReadVector(file, attributes) ||
+        !file.ReadObject(entries.clip_distances) || !file.ReadObject(shader_length) ||
+        !file.ReadObject(entries.enabled_uniform_buffers) || !file.ReadObject(entries.uses_warps)) {
+        return false;
+    }
+    entries.attributes.insert(attributes.begin(), attributes.end());
+    entries.shader_length = static_cast<std::size_t>(shader_length);
+    return true;
+}
+
+} // Anonymous namespace
+
+bool GraphicsPipelineDiskEntry::Load(const IOFile& file) {
+    u32 key_size;
+    if (!file.ReadObject(key_size) || key_size > sizeof(key)) {
+        return false;
+    }
+    // Keys are saved with their dynamic size, the trailing bytes stay zeroed
+    key = {};
+    if (file.ReadSpan(std::span(reinterpret_cast<u8*>(&key), key_size)) != key_size ||
+        key.Size() != key_size) {
+        return false;
+    }
+    u32 stage_mask;
+    if (!file.ReadObject(renderpass_key) || !file.ReadObject(num_color_buffers) ||
+        !file.ReadObject(stage_mask)) {
+        return false;
+    }
+    for (std::size_t stage = 0; stage < Maxwell::MaxShaderStage; ++stage) {
+        if ((stage_mask & (1U << stage)) == 0) {
+            continue;
+        }
+        if (!file.ReadObject(unique_identifiers[stage]) ||
+            !LoadShader(file, program[stage].emplace())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GraphicsPipelineDiskEntry::Save(const IOFile& file) const {
+    GraphicsPipelineCacheKey saved_key = key;
+    saved_key.renderpass = VK_NULL_HANDLE;
+
+    const u32 key_size = static_cast<u32>(key.Size());
+    u32 stage_mask = 0;
+    for (std::size_t stage = 0; stage < Maxwell::MaxShaderStage; ++stage) {
+        stage_mask |= program[stage] ? 1U << stage : 0U;
+    }
+    if (!file.WriteObject(key_size) ||
+        file.WriteSpan(std::span(reinterpret_cast<const u8*>(&saved_key), key_size)) !=
+            key_size ||
+        !file.WriteObject(renderpass_key) || !file.WriteObject(num_color_buffers) ||
+        !file.WriteObject(stage_mask)) {
+        return false;
+    }
+    for (std::size_t stage = 0; stage < Maxwell::MaxShaderStage; ++stage) {
+        if (!program[stage]) {
+            continue;
+        }
+        if (!file.WriteObject(unique_identifiers[stage]) || !SaveShader(file, *program[stage])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ComputePipelineDiskEntry::Load(const IOFile& file) {
+    return file.ReadObject(key) && file.ReadObject(unique_identifier) && LoadShader(file, shader);
+}
+
+bool ComputePipelineDiskEntry::Save(const IOFile& file) const {
+    return file.WriteObject(key) && file.WriteObject(unique_identifier) &&
+           SaveShader(file, shader);
+}
+
+PipelineDiskCache::PipelineDiskCache(const Device& device) {
+    // SPIR-V depends on the features of the device and on the decompiler of this build
+    header.version = NativeVersion;
+    header.driver_id = static_cast<u32>(device.GetDriverID());
+    header.driver_version = device.GetDriverVersion();
+    const std::string_view model_name = device.GetModelName();
+    std::copy_n(model_name.begin(), std::min(model_name.size(), header.model_name.size() - 1),
+                header.model_name.begin());
+    const std::size_t build_length =
+        std::min(std::strlen(Common::g_shader_cache_version), header.build_version.size());
+    std::copy_n(Common::g_shader_cache_version, build_length, header.build_version.begin());
+}
+
+PipelineDiskCache::~PipelineDiskCache() = default;
+
+std::pair<std::vector<GraphicsPipelineDiskEntry>, std::vector<ComputePipelineDiskEntry>>
+PipelineDiskCache::Load(const std::filesystem::path& base_dir, u64 title_id) {
+    std::vector<GraphicsPipelineDiskEntry> graphics;
+    std::vector<ComputePipelineDiskEntry> compute;
+    {
+        std::scoped_lock lock{mutex};
+        path = base_dir / fmt::format("{:016X}_pipelines.bin", title_id);
+    }
+    u64 valid_size = 0;
+    {
+        IOFile file{path, Common::FS::FileAccessMode::Read, Common::FS::FileType::BinaryFile};
+        if (!file.IsOpen()) {
+            return {};
+        }
+        Header file_header;
+        if (!file.ReadObject(file_header) || file_header != header) {
+            LOG_INFO(Render_Vulkan, "Pipeline cache is from another build or device, removing");
+            file.Close();
+            if (!Common::FS::RemoveFile(path)) {
+                LOG_ERROR(Render_Vulkan, "Failed to remove pipeline cache file={}",
+                          Common::FS::PathToUTF8String(path));
+            }
+            return {};
+        }
+        valid_size = static_cast<u64>(file.Tell());
+        const u64 file_size = file.GetSize();
+        while (valid_size < file_size) {
+            EntryType type;
+            if (!file.ReadObject(type)) {
+                break;
+            }
+            if (type == EntryType::Graphics) {
+                if (!graphics.emplace_back().Load(file)) {
+                    graphics.pop_back();
+                    break;
+                }
+            } else if (type == EntryType::Compute) {
+                if (!compute.emplace_back().Load(file)) {
+                    compute.pop_back();
+                    break;
+                }
+            } else {
+                break;
+            }
+            valid_size = static_cast<u64>(file.Tell());
+        }
+        if (valid_size == file_size) {
+            return {std::move(graphics), std::move(compute)};
+        }
+    }
+    // A run that ended while appending leaves a partial entry behind, drop it so new pipelines
+    // are appended after the last complete one
+    LOG_WARNING(Render_Vulkan, "Pipeline cache has a truncated entry, dropping it");
+    std::error_code ec;
+    std::filesystem::resize_file(path, valid_size, ec);
+    if (ec) {
+        LOG_ERROR(Render_Vulkan, "Failed to truncate pipeline cache: {}", ec.message());
+        std::scoped_lock lock{mutex};
+        path.clear();
+    }
+    return {std::move(graphics), std::move(compute)};
+}
+
+void PipelineDiskCache::SaveGraphicsPipeline(const GraphicsPipelineDiskEntry& entry) {
+    Save(static_cast<u32>(EntryType::Graphics), entry);
+}
+
+void PipelineDiskCache::SaveComputePipeline(const ComputePipelineDiskEntry& entry) {
+    Save(static_cast<u32>(EntryType::Compute), entry);
+}
+
+bool PipelineDiskCache::IsEnabled() const {
+    std::scoped_lock lock{mutex};
+    return !path.empty();
+}
+
+template <typename Entry>
+void PipelineDiskCache::Save(u32 type, const Entry& entry) {
+    std::scoped_lock lock{mutex};
+    if (path.empty()) {
+        return;
+    }
+    const IOFile file{path, Common::FS::FileAccessMode::Append, Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render_Vulkan, "Failed to open pipeline cache file={}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    if (file.GetSize() == 0 && !file.WriteObject(header)) {
+        LOG_ERROR(Render_Vulkan, "Failed to write pipeline cache header");
+        return;
+    }
+    if (!file.WriteObject(type) || !entry.Save(file)) {
+        LOG_ERROR(Render_Vulkan, "Failed to write pipeline cache entry");
+    }
+}
+
+} // namespace Vulkan
@@ -0,0 +1,94 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/renderer_vulkan/vk_compute_pipeline.h"
+#include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
+#include "video_core/renderer_vulkan/vk_shader_decompiler.h"
+#include "video_core/renderer_vulkan/vk_texture_cache.h"
+
+namespace Common::FS {
+class IOFile;
+}
+
+namespace Vulkan {
+
+class Device;
+
+/// Describes a graphics pipeline and the SPIR-V it was built from
+struct GraphicsPipelineDiskEntry {
+    bool Load(const Common::FS::IOFile& file);
+
+    bool Save(const Common::FS::IOFile& file) const;
+
+    /// Cache key of the pipeline, its render pass handle is only meaningful within a single run
+    GraphicsPipelineCacheKey key{};
+    /// Attachments of the render pass the pipeline was built for
+    RenderPassKey renderpass_key{};
+    u32 num_color_buffers = 0;
+    /// Identifier of the guest code of each stage, zero for disabled stages
+    std::array<u64, Maxwell::MaxShaderStage> unique_identifiers{};
+    SPIRVProgram program;
+};
+
+/// Describes a compute pipeline and the SPIR-V it was built from
+struct ComputePipelineDiskEntry {
+    bool Load(const Common::FS::IOFile& file);
+
+    bool Save(const Common::FS::IOFile& file) const;
+
+    ComputePipelineCacheKey key{};
+    u64 unique_identifier = 0;
+    SPIRVShader shader;
+};
+
+/// Stores the pipelines built by a title so they can be rebuilt before its first frame
+class PipelineDiskCache {
+public:
+    explicit PipelineDiskCache(const Device& device);
+    ~PipelineDiskCache();
+
+    /// Binds the cache to a title and returns the pipelines saved by its previous runs.
+    /// Files written by another build or device are deleted.
+    std::pair<std::vector<GraphicsPipelineDiskEntry>, std::vector<ComputePipelineDiskEntry>> Load(
+        const std::filesystem::path& base_dir, u64 title_id);
+
+    /// Appends a graphics pipeline to the bound title's cache, it can be called from any thread
+    void SaveGraphicsPipeline(const GraphicsPipelineDiskEntry& entry);
+
+    /// Appends a compute pipeline to the bound title's cache, it can be called from any thread
+    void SaveComputePipeline(const ComputePipelineDiskEntry& entry);
+
+    /// Returns true when a title has been bound
+    bool IsEnabled() const;
+
+private:
+    struct Header {
+        bool operator==(const Header&) const = default;
+
+        u32 version;
+        u32 driver_id;
+        u32 driver_version;
+        std::array<char, VK_MAX_PHYSICAL_DEVICE_NAME_SIZE> model_name;
+        std::array<char, 64> build_version;
+    };
+
+    template <typename Entry>
+    void Save(u32 type, const Entry& entry);
+
+    Header header{};
+    mutable std::mutex mutex;
+    std::filesystem::path path;
+};
+
+} // namespace Vulkan
@@ -285,8 +285,8 @@ void RasterizerVulkan::Draw(bool is_indexed, bool is_instanced) {
     const Framebuffer* const framebuffer = texture_cache.GetFramebuffer();
     graphics_key.renderpass = framebuffer->RenderPass();
 
-    VKGraphicsPipeline* const pipeline = pipeline_cache.GetGraphicsPipeline(
-        graphics_key, framebuffer->NumColorBuffers(), async_shaders);
+    VKGraphicsPipeline* const pipeline =
+        pipeline_cache.GetGraphicsPipeline(graphics_key, *framebuffer, async_shaders);
     if (pipeline == nullptr || pipeline->GetHandle() == VK_NULL_HANDLE) {
         // Async graphics pipeline was not ready.
         return;
@@ -677,6 +677,11 @@ bool RasterizerVulkan::AccelerateDisplay(const Tegra::FramebufferConfig& config,
     return true;
 }
 
+void RasterizerVulkan::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
+                                         const VideoCore::DiskResourceLoadCallback& callback) {
+    pipeline_cache.LoadDiskResources(title_id, stop_loading, callback, texture_cache_runtime);
+}
+
 void RasterizerVulkan::FlushWork() {
     static constexpr u32 DRAWS_TO_DISPATCH = 4096;
 
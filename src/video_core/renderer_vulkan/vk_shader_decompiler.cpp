@@ -1116,8 +1116,8 @@ private:
         }
     }
 
-    Expression Visit(const Node& node) {
-        if (const auto operation = std::get_if<OperationNode>(&*node)) {
+    Expression Visit(Node node) {
+        if (const auto operation = std::get_if<OperationNode>(node)) {
             if (const auto amend_index = operation->GetAmendIndex()) {
                 [[maybe_unused]] const Type type = Visit(ir.GetAmendNode(*amend_index)).type;
                 ASSERT(type == Type::Void);
@@ -1130,7 +1130,7 @@ private:
             return (this->*decompiler)(*operation);
         }
 
-        if (const auto gpr = std::get_if<GprNode>(&*node)) {
+        if (const auto gpr = std::get_if<GprNode>(node)) {
             const u32 index = gpr->GetIndex();
             if (index == Register::ZeroIndex) {
                 return {v_float_zero, Type::Float};
@@ -1138,16 +1138,16 @@ private:
             return {OpLoad(t_float, registers.at(index)), Type::Float};
         }
 
-        if (const auto cv = std::get_if<CustomVarNode>(&*node)) {
+        if (const auto cv = std::get_if<CustomVarNode>(node)) {
             const u32 index = cv->GetIndex();
             return {OpLoad(t_float, custom_variables.at(index)), Type::Float};
         }
 
-        if (const auto immediate = std::get_if<ImmediateNode>(&*node)) {
+        if (const auto immediate = std::get_if<ImmediateNode>(node)) {
             return {Constant(t_uint, immediate->GetValue()), Type::Uint};
         }
 
-        if (const auto predicate = std::get_if<PredicateNode>(&*node)) {
+        if (const auto predicate = std::get_if<PredicateNode>(node)) {
             const auto value = [&]() -> Id {
                 switch (const auto index = predicate->GetIndex(); index) {
                 case Tegra::Shader::Pred::UnusedIndex:
@@ -1164,7 +1164,7 @@ private:
             return {value, Type::Bool};
         }
 
-        if (const auto abuf = std::get_if<AbufNode>(&*node)) {
+        if (const auto abuf = std::get_if<AbufNode>(node)) {
             const auto attribute = abuf->GetIndex();
             const u32 element = abuf->GetElement();
             const auto& buffer = abuf->GetBuffer();
@@ -1251,8 +1251,8 @@ private:
             return {v_float_zero, Type::Float};
         }
 
-        if (const auto cbuf = std::get_if<CbufNode>(&*node)) {
-            const Node& offset = cbuf->GetOffset();
+        if (const auto cbuf = std::get_if<CbufNode>(node)) {
+            const Node offset = cbuf->GetOffset();
             const Id buffer_id = constant_buffers.at(cbuf->GetIndex());
 
             Id pointer{};
@@ -1264,7 +1264,7 @@ private:
             } else {
                 Id buffer_index{};
                 Id buffer_element{};
-                if (const auto immediate = std::get_if<ImmediateNode>(&*offset)) {
+                if (const auto immediate = std::get_if<ImmediateNode>(offset)) {
                     // Direct access
                     const u32 offset_imm = immediate->GetValue();
                     ASSERT(offset_imm % 4 == 0);
@@ -1287,27 +1287,27 @@ private:
             return {OpLoad(t_float, pointer), Type::Float};
         }
 
-        if (const auto gmem = std::get_if<GmemNode>(&*node)) {
+        if (const auto gmem = std::get_if<GmemNode>(node)) {
             return {OpLoad(t_uint, GetGlobalMemoryPointer(*gmem)), Type::Uint};
         }
 
-        if (const auto lmem = std::get_if<LmemNode>(&*node)) {
+        if (const auto lmem = std::get_if<LmemNode>(node)) {
             Id address = AsUint(Visit(lmem->GetAddress()));
             address = OpShiftRightLogical(t_uint, address, Constant(t_uint, 2U));
             const Id pointer = OpAccessChain(t_prv_float, local_memory, address);
             return {OpLoad(t_float, pointer), Type::Float};
         }
 
-        if (const auto smem = std::get_if<SmemNode>(&*node)) {
+        if (const auto smem = std::get_if<SmemNode>(node)) {
             return {OpLoad(t_uint, GetSharedMemoryPointer(*smem)), Type::Uint};
         }
 
-        if (const auto internal_flag = std::get_if<InternalFlagNode>(&*node)) {
+        if (const auto internal_flag = std::get_if<InternalFlagNode>(node)) {
             const Id flag = internal_flags.at(static_cast<std::size_t>(internal_flag->GetFlag()));
             return {OpLoad(t_bool, flag), Type::Bool};
         }
 
-        if (const auto conditional = std::get_if<ConditionalNode>(&*node)) {
+        if (const auto conditional = std::get_if<ConditionalNode>(node)) {
             if (const auto amend_index = conditional->GetAmendIndex()) {
                 [[maybe_unused]] const Type type = Visit(ir.GetAmendNode(*amend_index)).type;
                 ASSERT(type == Type::Void);
@@ -1333,7 +1333,7 @@ private:
             return {};
         }
 
-        if (const auto comment = std::get_if<CommentNode>(&*node)) {
+        if (const auto comment = std::get_if<CommentNode>(node)) {
             if (device.HasDebuggingToolAttached()) {
                 // We should insert comments with OpString instead of using named variables
                 Name(OpUndef(t_int), comment->GetText());
@@ -1403,11 +1403,11 @@ private:
     }
 
     Expression Assign(Operation operation) {
-        const Node& dest = operation[0];
-        const Node& src = operation[1];
+        const Node dest = operation[0];
+        const Node src = operation[1];
 
         Expression target{};
-        if (const auto gpr = std::get_if<GprNode>(&*dest)) {
+        if (const auto gpr = std::get_if<GprNode>(dest)) {
             if (gpr->GetIndex() == Register::ZeroIndex) {
                 // Writing to Register::ZeroIndex is a no op but we still have to visit its source
                 // because it might have side effects.
@@ -1416,7 +1416,7 @@ private:
             }
             target = {registers.at(gpr->GetIndex()), Type::Float};
 
-        } else if (const auto abuf = std::get_if<AbufNode>(&*dest)) {
+        } else if (const auto abuf = std::get_if<AbufNode>(dest)) {
             const auto& buffer = abuf->GetBuffer();
             const auto ArrayPass = [&](Id pointer_type, Id composite, std::vector<u32> indices) {
                 std::vector<Id> members;
@@ -1488,7 +1488,7 @@ private:
                 }
             }();
 
-        } else if (const auto patch = std::get_if<PatchNode>(&*dest)) {
+        } else if (const auto patch = std::get_if<PatchNode>(dest)) {
             target = [&]() -> Expression {
                 const u32 offset = patch->GetOffset();
                 switch (offset) {
@@ -1505,18 +1505,18 @@ private:
                 return {};
             }();
 
-        } else if (const auto lmem = std::get_if<LmemNode>(&*dest)) {
+        } else if (const auto lmem = std::get_if<LmemNode>(dest)) {
             Id address = AsUint(Visit(lmem->GetAddress()));
             address = OpUDiv(t_uint, address, Constant(t_uint, 4));
             target = {OpAccessChain(t_prv_float, local_memory, address), Type::Float};
 
-        } else if (const auto smem = std::get_if<SmemNode>(&*dest)) {
+        } else if (const auto smem = std::get_if<SmemNode>(dest)) {
             target = {GetSharedMemoryPointer(*smem), Type::Uint};
 
-        } else if (const auto gmem = std::get_if<GmemNode>(&*dest)) {
+        } else if (const auto gmem = std::get_if<GmemNode>(dest)) {
             target = {GetGlobalMemoryPointer(*gmem), Type::Uint};
 
-        } else if (const auto cv = std::get_if<CustomVarNode>(&*dest)) {
+        } else if (const auto cv = std::get_if<CustomVarNode>(dest)) {
             target = {custom_variables.at(cv->GetIndex()), Type::Float};
 
         } else {
@@ -1643,11 +1643,11 @@ private:
     }
 
     Expression LogicalAssign(Operation operation) {
-        const Node& dest = operation[0];
-        const Node& src = operation[1];
+        const Node dest = operation[0];
+        const Node src = operation[1];
 
         Id target{};
-        if (const auto pred = std::get_if<PredicateNode>(&*dest)) {
+        if (const auto pred = std::get_if<PredicateNode>(dest)) {
             ASSERT_MSG(!pred->IsNegated(), "Negating logical assignment");
 
             const auto index = pred->GetIndex();
@@ -1659,7 +1659,7 @@ private:
             }
             target = predicates.at(index);
 
-        } else if (const auto flag = std::get_if<InternalFlagNode>(&*dest)) {
+        } else if (const auto flag = std::get_if<InternalFlagNode>(dest)) {
             target = internal_flags.at(static_cast<u32>(flag->GetFlag()));
         }
 
@@ -1863,7 +1863,7 @@ private:
         } else {
             u32 component_value = 0;
             if (meta.component) {
-                const auto component = std::get_if<ImmediateNode>(&*meta.component);
+                const auto component = std::get_if<ImmediateNode>(meta.component);
                 ASSERT_MSG(component, "Component is not an immediate value");
                 component_value = component->GetValue();
             }
@@ -2015,9 +2015,9 @@ private:
     template <Id (Module::*func)(Id, Id, Id, Id, Id)>
     Expression Atomic(Operation operation) {
         Id pointer;
-        if (const auto smem = std::get_if<SmemNode>(&*operation[0])) {
+        if (const auto smem = std::get_if<SmemNode>(operation[0])) {
             pointer = GetSharedMemoryPointer(*smem);
-        } else if (const auto gmem = std::get_if<GmemNode>(&*operation[0])) {
+        } else if (const auto gmem = std::get_if<GmemNode>(operation[0])) {
             pointer = GetGlobalMemoryPointer(*gmem);
         } else {
             UNREACHABLE();
@@ -66,6 +66,9 @@ struct TextureCacheRuntime {
 
     void Finish();
 
+    /// Returns the render pass of the given attachments, creating it on first use
+    [[nodiscard]] VkRenderPass RenderPass(const RenderPassKey& key);
+
     [[nodiscard]] StagingBufferRef UploadStagingBuffer(size_t size);
 
     [[nodiscard]] StagingBufferRef DownloadStagingBuffer(size_t size);
@@ -228,6 +231,10 @@ public:
         return renderpass;
     }
 
+    [[nodiscard]] const RenderPassKey& GetRenderPassKey() const noexcept {
+        return renderpass_key;
+    }
+
     [[nodiscard]] VkExtent2D RenderArea() const noexcept {
         return render_area;
     }
@@ -255,6 +262,7 @@ public:
 private:
     vk::Framebuffer framebuffer;
     VkRenderPass renderpass{};
+    RenderPassKey renderpass_key{};
     VkExtent2D render_area{};
     VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
     u32 num_color_buffers = 0;
@@ -148,7 +148,7 @@ void AsyncShaders::QueueVulkanShader(Vulkan::VKPipelineCache* pp_cache,
                                      Vulkan::VKDescriptorPool& descriptor_pool,
                                      Vulkan::VKUpdateDescriptorQueue& update_descriptor_queue,
                                      std::vector<VkDescriptorSetLayoutBinding> bindings,
-                                     Vulkan::SPIRVProgram program,
+                                     Vulkan::DeferredProgram program,
                                      Vulkan::GraphicsPipelineCacheKey key, u32 num_color_buffers) {
     std::unique_lock lock(queue_mutex);
     pending_queue.push({
@@ -221,12 +221,14 @@ void AsyncShaders::ShaderCompilerThread(Core::Frontend::GraphicsContext* context
                 finished_work.push_back(std::move(result));
             }
         } else if (work.backend == Backend::Vulkan) {
+            const Vulkan::SPIRVProgram program =
+                Vulkan::DecompileDeferredProgram(*work.vk_device, *work.program);
             auto pipeline = std::make_unique<Vulkan::VKGraphicsPipeline>(
                 *work.vk_device, *work.scheduler, *work.descriptor_pool,
-                *work.update_descriptor_queue, work.key, work.bindings, work.program,
-                work.num_color_buffers);
+                *work.update_descriptor_queue, work.key, work.bindings, program,
+                work.num_color_buffers, work.pp_cache->GetDriverCache());
 
-            work.pp_cache->EmplacePipeline(std::move(pipeline));
+            work.pp_cache->EmplacePipeline(std::move(pipeline), *work.program, program);
         }
     }
 }
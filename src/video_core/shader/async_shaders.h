@@ -90,7 +90,7 @@ public:
                            Vulkan::VKDescriptorPool& descriptor_pool,
                            Vulkan::VKUpdateDescriptorQueue& update_descriptor_queue,
                            std::vector<VkDescriptorSetLayoutBinding> bindings,
-                           Vulkan::SPIRVProgram program, Vulkan::GraphicsPipelineCacheKey key,
+                           Vulkan::DeferredProgram program, Vulkan::GraphicsPipelineCacheKey key,
                            u32 num_color_buffers);
 
 private:
@@ -119,7 +119,7 @@ private:
         Vulkan::VKDescriptorPool* descriptor_pool;
         Vulkan::VKUpdateDescriptorQueue* update_descriptor_queue;
         std::vector<VkDescriptorSetLayoutBinding> bindings;
-        Vulkan::SPIRVProgram program;
+        std::optional<Vulkan::DeferredProgram> program;
         Vulkan::GraphicsPipelineCacheKey key;
         u32 num_color_buffers;
     };
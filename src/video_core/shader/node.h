@@ -271,7 +271,8 @@ class CommentNode;
 using NodeData = std::variant<OperationNode, ConditionalNode, GprNode, CustomVarNode, ImmediateNode,
                               InternalFlagNode, PredicateNode, AbufNode, PatchNode, CbufNode,
                               LmemNode, SmemNode, GmemNode, CommentNode>;
-using Node = std::shared_ptr<NodeData>;
+/// Non-owning handle, nodes live in the NodeArena of the ShaderIR that created them
+using Node = NodeData*;
 using Node4 = std::array<Node, 4>;
 using NodeBlock = std::vector<Node>;
 
@@ -465,7 +466,7 @@ public:
         return operands.size();
     }
 
-    [[nodiscard]] const Node& operator[](std::size_t operand_index) const {
+    [[nodiscard]] Node operator[](std::size_t operand_index) const {
         return operands.at(operand_index);
     }
 
@@ -481,7 +482,7 @@ public:
     explicit ConditionalNode(Node condition_, std::vector<Node>&& code_)
         : condition{std::move(condition_)}, code{std::move(code_)} {}
 
-    [[nodiscard]] const Node& GetCondition() const {
+    [[nodiscard]] Node GetCondition() const {
         return condition;
     }
 
@@ -584,7 +585,7 @@ public:
         return element;
     }
 
-    [[nodiscard]] const Node& GetBuffer() const {
+    [[nodiscard]] Node GetBuffer() const {
         return buffer;
     }
 
@@ -592,7 +593,7 @@ public:
         return static_cast<bool>(physical_address);
     }
 
-    [[nodiscard]] const Node& GetPhysicalAddress() const {
+    [[nodiscard]] Node GetPhysicalAddress() const {
         return physical_address;
     }
 
@@ -625,7 +626,7 @@ public:
         return index;
     }
 
-    [[nodiscard]] const Node& GetOffset() const {
+    [[nodiscard]] Node GetOffset() const {
         return offset;
     }
 
@@ -639,7 +640,7 @@ class LmemNode final {
 public:
     explicit LmemNode(Node address_) : address{std::move(address_)} {}
 
-    [[nodiscard]] const Node& GetAddress() const {
+    [[nodiscard]] Node GetAddress() const {
         return address;
     }
 
@@ -652,7 +653,7 @@ class SmemNode final {
 public:
     explicit SmemNode(Node address_) : address{std::move(address_)} {}
 
-    [[nodiscard]] const Node& GetAddress() const {
+    [[nodiscard]] Node GetAddress() const {
         return address;
     }
 
@@ -667,11 +668,11 @@ public:
         : real_address{std::move(real_address_)}, base_address{std::move(base_address_)},
           descriptor{descriptor_} {}
 
-    [[nodiscard]] const Node& GetRealAddress() const {
+    [[nodiscard]] Node GetRealAddress() const {
         return real_address;
     }
 
-    [[nodiscard]] const Node& GetBaseAddress() const {
+    [[nodiscard]] Node GetBaseAddress() const {
         return base_address;
     }
 
@@ -0,0 +1,59 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstdint>
+#include <new>
+
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "video_core/shader/node_arena.h"
+
+namespace VideoCommon::Shader {
+
+namespace {
+thread_local NodeArena* current_arena = nullptr;
+} // Anonymous namespace
+
+NodeArena::Scope::Scope(NodeArena& arena) noexcept : previous{current_arena} {
+    current_arena = &arena;
+}
+
+NodeArena::Scope::~Scope() {
+    current_arena = previous;
+}
+
+NodeArena::NodeArena() = default;
+
+NodeArena::~NodeArena() {
+    // Objects may refer to the ones created before them, destroy them in reverse order
+    for (auto it = destructors.rbegin(); it != destructors.rend(); ++it) {
+        it->destroy(it->object);
+    }
+}
+
+void* NodeArena::Allocate(std::size_t size, std::size_t alignment) {
+    ASSERT(alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+    u8* const aligned = reinterpret_cast<u8*>(
+        Common::AlignUp(reinterpret_cast<std::uintptr_t>(cursor), alignment));
+    if (cursor && aligned <= chunk_end && size <= static_cast<std::size_t>(chunk_end - aligned)) {
+        cursor = aligned + size;
+        return aligned;
+    }
+    // Oversized requests get a dedicated chunk and leave the current one untouched
+    if (size > CHUNK_SIZE / 4) {
+        return chunks.emplace_back(std::make_unique<u8[]>(size)).get();
+    }
+    u8* const chunk = chunks.emplace_back(std::make_unique<u8[]>(CHUNK_SIZE)).get();
+    cursor = chunk + size;
+    chunk_end = chunk + CHUNK_SIZE;
+    return chunk;
+}
+
+NodeArena& NodeArena::Current() noexcept {
+    ASSERT_MSG(current_arena, "Node created without a bound arena");
+    return *current_arena;
+}
+
+} // namespace VideoCommon::Shader
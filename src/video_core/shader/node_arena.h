@@ -0,0 +1,78 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace VideoCommon::Shader {
+
+/**
+ * Bump allocator owning the nodes created while a ShaderIR is being decoded.
+ * Individual objects are never released, the whole arena is destroyed at once. Handles to objects
+ * created in an arena must not be used after the arena is destroyed.
+ */
+class NodeArena {
+public:
+    /// Binds an arena to the calling thread for the lifetime of the scope
+    class Scope {
+    public:
+        explicit Scope(NodeArena& arena) noexcept;
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        NodeArena* previous;
+    };
+
+    NodeArena();
+    ~NodeArena();
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    /// Constructs an object in the arena, it is destroyed together with the arena
+    template <typename T, typename... Args>
+    [[nodiscard]] T* Create(Args&&... args) {
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        } else {
+            // Reserve the destructor slot first, so a throwing push can't leak a live object
+            destructors.reserve(destructors.size() + 1);
+            T* const object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            destructors.push_back({object, [](void* pointer) { static_cast<T*>(pointer)->~T(); }});
+            return object;
+        }
+    }
+
+    /// Allocates uninitialized memory from the arena
+    [[nodiscard]] void* Allocate(std::size_t size, std::size_t alignment);
+
+    /// Returns the arena bound to the calling thread, one must be bound
+    [[nodiscard]] static NodeArena& Current() noexcept;
+
+private:
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+    struct Destructor {
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    std::vector<std::unique_ptr<u8[]>> chunks;
+    std::vector<Destructor> destructors;
+    u8* cursor = nullptr;
+    u8* chunk_end = nullptr;
+};
+
+} // namespace VideoCommon::Shader
@@ -13,6 +13,7 @@
 
 #include "common/common_types.h"
 #include "video_core/shader/node.h"
+#include "video_core/shader/node_arena.h"
 
 namespace VideoCommon::Shader {
 
@@ -42,7 +43,7 @@ OperationCode SignedToUnsignedCode(OperationCode operation_code, bool is_signed)
 template <typename T, typename... Args>
 Node MakeNode(Args&&... args) {
     static_assert(std::is_convertible_v<T, NodeData>);
-    return std::make_shared<NodeData>(T(std::forward<Args>(args)...));
+    return NodeArena::Current().Create<NodeData>(T(std::forward<Args>(args)...));
 }
 
 template <typename T, typename... Args>
@@ -66,6 +66,15 @@ Registry::Registry(ShaderType shader_stage, ConstBufferEngineInterface& engine_)
 
 Registry::~Registry() = default;
 
+Registry Registry::Snapshot() const {
+    Registry snapshot = *this;
+    if (engine) {
+        snapshot.stored_guest_driver_profile = engine->AccessGuestDriverProfile();
+        snapshot.engine = nullptr;
+    }
+    return snapshot;
+}
+
 std::optional<u32> Registry::ObtainKey(u32 buffer, u32 offset) {
     const std::pair<u32, u32> key = {buffer, offset};
     const auto iter = keys.find(key);
@@ -98,6 +98,10 @@ public:
 
     ~Registry();
 
+    /// Returns a copy detached from the engine that only answers from the keys registered so far.
+    /// It has to be taken on the thread that owns the engine, the copy can be used from any thread.
+    [[nodiscard]] Registry Snapshot() const;
+
     /// Retrieves a key from the registry, if it's registered, it will give the registered value, if
     /// not it will obtain it from maxwell3d and register it.
     std::optional<u32> ObtainKey(u32 buffer, u32 offset);
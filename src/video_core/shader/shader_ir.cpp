@@ -29,6 +29,7 @@ ShaderIR::ShaderIR(const ProgramCode& program_code_, u32 main_offset_, CompilerS
                    Registry& registry_)
     : program_code{program_code_}, main_offset{main_offset_}, settings{settings_}, registry{
                                                                                        registry_} {
+    const NodeArena::Scope arena_scope{*node_arena};
     Decode();
     PostDecode();
 }
@@ -72,7 +73,7 @@ Node ShaderIR::GetConstBufferIndirect(u64 index_, u64 offset_, Node node) {
     Node final_offset = [&] {
         // Attempt to inline constant buffer without a variable offset. This is done to allow
         // tracking LDC calls.
-        if (const auto gpr = std::get_if<GprNode>(&*node)) {
+        if (const auto gpr = std::get_if<GprNode>(node)) {
             if (gpr->GetIndex() == Register::ZeroIndex) {
                 return Immediate(offset);
             }
@@ -337,16 +338,28 @@ OperationCode ShaderIR::GetPredicateCombiner(PredOperation operation) {
 }
 
 Node ShaderIR::GetConditionCode(ConditionCode cc) const {
+    // Decompilers call this after decoding, nodes are shared so repeated calls don't grow the arena
+    const auto index = static_cast<std::size_t>(cc);
+    ASSERT(index < condition_codes.size());
+    Node& node = condition_codes[index];
+    if (node) {
+        return node;
+    }
+    const NodeArena::Scope arena_scope{*node_arena};
     switch (cc) {
     case ConditionCode::NEU:
-        return GetInternalFlag(InternalFlag::Zero, true);
+        node = GetInternalFlag(InternalFlag::Zero, true);
+        break;
     case ConditionCode::FCSM_TR:
         UNIMPLEMENTED_MSG("EXIT.FCSM_TR is not implemented");
-        return MakeNode<PredicateNode>(Pred::NeverExecute, false);
+        node = MakeNode<PredicateNode>(Pred::NeverExecute, false);
+        break;
     default:
         UNIMPLEMENTED_MSG("Unimplemented condition code: {}", cc);
-        return MakeNode<PredicateNode>(Pred::NeverExecute, false);
+        node = MakeNode<PredicateNode>(Pred::NeverExecute, false);
+        break;
     }
+    return node;
 }
 
 void ShaderIR::SetRegister(NodeBlock& bb, Register dest, Node src) {
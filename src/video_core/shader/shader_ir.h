@@ -7,6 +7,7 @@
 #include <array>
 #include <list>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
 #include <tuple>
@@ -20,6 +21,7 @@
 #include "video_core/shader/compiler_settings.h"
 #include "video_core/shader/memory_util.h"
 #include "video_core/shader/node.h"
+#include "video_core/shader/node_arena.h"
 #include "video_core/shader/registry.h"
 
 namespace VideoCommon::Shader {
@@ -179,10 +181,10 @@ public:
         return (address - main_offset) * static_cast<u32>(sizeof(Tegra::Shader::Instruction));
     }
 
-    /// Returns a condition code evaluated from internal flags
+    /// Returns a condition code evaluated from internal flags, the node is shared by every caller
     Node GetConditionCode(Tegra::Shader::ConditionCode cc) const;
 
-    const Node& GetAmendNode(std::size_t index) const {
+    Node GetAmendNode(std::size_t index) const {
         return amend_code[index];
     }
 
@@ -436,6 +438,9 @@ private:
 
     u32 NewCustomVariable();
 
+    /// Owns every node of this IR, declared first so it is destroyed last
+    std::unique_ptr<NodeArena> node_arena = std::make_unique<NodeArena>();
+
     const ProgramCode& program_code;
     const u32 main_offset;
     const CompilerSettings settings;
@@ -453,6 +458,9 @@ private:
     std::vector<Node> amend_code;
     u32 num_custom_variables{};
 
+    /// Condition code nodes indexed by Tegra::Shader::ConditionCode, created on first use
+    mutable std::array<Node, 32> condition_codes{};
+
     std::set<u32> used_registers;
     std::set<Tegra::Shader::Pred> used_predicates;
     std::set<Tegra::Shader::Attribute::Index> used_input_attributes;
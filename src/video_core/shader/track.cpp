@@ -20,13 +20,13 @@ std::pair<Node, s64> FindOperation(const NodeBlock& code, s64 cursor,
     for (; cursor >= 0; --cursor) {
         Node node = code.at(cursor);
 
-        if (const auto operation = std::get_if<OperationNode>(&*node)) {
+        if (const auto operation = std::get_if<OperationNode>(node)) {
             if (operation->GetCode() == operation_code) {
                 return {std::move(node), cursor};
             }
         }
 
-        if (const auto conditional = std::get_if<ConditionalNode>(&*node)) {
+        if (const auto conditional = std::get_if<ConditionalNode>(node)) {
             const auto& conditional_code = conditional->GetCode();
             auto result = FindOperation(
                 conditional_code, static_cast<s64>(conditional_code.size() - 1), operation_code);
@@ -61,11 +61,11 @@ std::optional<std::pair<Node, Node>> DecoupleIndirectRead(const OperationNode& o
 }
 
 bool AmendNodeCv(std::size_t amend_index, Node node) {
-    if (const auto operation = std::get_if<OperationNode>(&*node)) {
+    if (const auto operation = std::get_if<OperationNode>(node)) {
         operation->SetAmendIndex(amend_index);
         return true;
     }
-    if (const auto conditional = std::get_if<ConditionalNode>(&*node)) {
+    if (const auto conditional = std::get_if<ConditionalNode>(node)) {
         conditional->SetAmendIndex(amend_index);
         return true;
     }
@@ -76,16 +76,16 @@ bool AmendNodeCv(std::size_t amend_index, Node node) {
 
 std::pair<Node, TrackSampler> ShaderIR::TrackBindlessSampler(Node tracked, const NodeBlock& code,
                                                              s64 cursor) {
-    if (const auto cbuf = std::get_if<CbufNode>(&*tracked)) {
+    if (const auto cbuf = std::get_if<CbufNode>(tracked)) {
         const u32 cbuf_index = cbuf->GetIndex();
 
         // Constant buffer found, test if it's an immediate
         const auto& offset = cbuf->GetOffset();
-        if (const auto immediate = std::get_if<ImmediateNode>(&*offset)) {
+        if (const auto immediate = std::get_if<ImmediateNode>(offset)) {
             auto track = MakeTrackSampler<BindlessSamplerNode>(cbuf_index, immediate->GetValue());
             return {tracked, track};
         }
-        if (const auto operation = std::get_if<OperationNode>(&*offset)) {
+        if (const auto operation = std::get_if<OperationNode>(offset)) {
             const u32 bound_buffer = registry.GetBoundBuffer();
             if (bound_buffer != cbuf_index) {
                 return {};
@@ -98,7 +98,7 @@ std::pair<Node, TrackSampler> ShaderIR::TrackBindlessSampler(Node tracked, const
         }
         return {};
     }
-    if (const auto gpr = std::get_if<GprNode>(&*tracked)) {
+    if (const auto gpr = std::get_if<GprNode>(tracked)) {
         if (gpr->GetIndex() == Tegra::Shader::Register::ZeroIndex) {
             return {};
         }
@@ -110,7 +110,7 @@ std::pair<Node, TrackSampler> ShaderIR::TrackBindlessSampler(Node tracked, const
         }
         return TrackBindlessSampler(source, code, new_cursor);
     }
-    if (const auto operation = std::get_if<OperationNode>(&*tracked)) {
+    if (const auto operation = std::get_if<OperationNode>(tracked)) {
         const OperationNode& op = *operation;
 
         const OperationCode opcode = operation->GetCode();
@@ -133,7 +133,7 @@ std::pair<Node, TrackSampler> ShaderIR::TrackBindlessSampler(Node tracked, const
         }
         return {};
     }
-    if (const auto conditional = std::get_if<ConditionalNode>(&*tracked)) {
+    if (const auto conditional = std::get_if<ConditionalNode>(tracked)) {
         const auto& conditional_code = conditional->GetCode();
         return TrackBindlessSampler(tracked, conditional_code,
                                     static_cast<s64>(conditional_code.size()));
@@ -163,15 +163,15 @@ std::pair<Node, TrackSampler> ShaderIR::HandleBindlessIndirectRead(
 
 std::tuple<Node, u32, u32> ShaderIR::TrackCbuf(Node tracked, const NodeBlock& code,
                                                s64 cursor) const {
-    if (const auto cbuf = std::get_if<CbufNode>(&*tracked)) {
+    if (const auto cbuf = std::get_if<CbufNode>(tracked)) {
         // Constant buffer found, test if it's an immediate
         const auto& offset = cbuf->GetOffset();
-        if (const auto immediate = std::get_if<ImmediateNode>(&*offset)) {
+        if (const auto immediate = std::get_if<ImmediateNode>(offset)) {
             return {tracked, cbuf->GetIndex(), immediate->GetValue()};
         }
         return {};
     }
-    if (const auto gpr = std::get_if<GprNode>(&*tracked)) {
+    if (const auto gpr = std::get_if<GprNode>(tracked)) {
         if (gpr->GetIndex() == Tegra::Shader::Register::ZeroIndex) {
             return {};
         }
@@ -183,7 +183,7 @@ std::tuple<Node, u32, u32> ShaderIR::TrackCbuf(Node tracked, const NodeBlock& co
         }
         return TrackCbuf(source, code, new_cursor);
     }
-    if (const auto operation = std::get_if<OperationNode>(&*tracked)) {
+    if (const auto operation = std::get_if<OperationNode>(tracked)) {
         for (std::size_t i = operation->GetOperandsCount(); i > 0; --i) {
             if (auto found = TrackCbuf((*operation)[i - 1], code, cursor); std::get<0>(found)) {
                 // Cbuf found in operand.
@@ -192,7 +192,7 @@ std::tuple<Node, u32, u32> ShaderIR::TrackCbuf(Node tracked, const NodeBlock& co
         }
         return {};
     }
-    if (const auto conditional = std::get_if<ConditionalNode>(&*tracked)) {
+    if (const auto conditional = std::get_if<ConditionalNode>(tracked)) {
         const auto& conditional_code = conditional->GetCode();
         return TrackCbuf(tracked, conditional_code, static_cast<s64>(conditional_code.size()));
     }
@@ -207,7 +207,7 @@ std::optional<u32> ShaderIR::TrackImmediate(Node tracked, const NodeBlock& code,
     if (!found) {
         return std::nullopt;
     }
-    if (const auto immediate = std::get_if<ImmediateNode>(&*found)) {
+    if (const auto immediate = std::get_if<ImmediateNode>(found)) {
         return immediate->GetValue();
     }
     return std::nullopt;
@@ -220,11 +220,11 @@ std::pair<Node, s64> ShaderIR::TrackRegister(const GprNode* tracked, const NodeB
         if (!found_node) {
             return {};
         }
-        const auto operation = std::get_if<OperationNode>(&*found_node);
+        const auto operation = std::get_if<OperationNode>(found_node);
         ASSERT(operation);
 
         const auto& target = (*operation)[0];
-        if (const auto gpr_target = std::get_if<GprNode>(&*target)) {
+        if (const auto gpr_target = std::get_if<GprNode>(target)) {
             if (gpr_target->GetIndex() == tracked->GetIndex()) {
                 return {(*operation)[1], new_cursor};
             }
@@ -24,6 +24,8 @@
 #include <boost/container/static_vector.hpp>
 
 #include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "common/parallel_for.h"
 #include "video_core/textures/astc.h"
 
 class InputBitStream {
@@ -1548,32 +1550,60 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
         }
 }
 
-void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
-                uint32_t block_width, uint32_t block_height, std::span<uint8_t> output) {
-    u32 block_index = 0;
-    std::size_t depth_offset = 0;
-    for (u32 z = 0; z < depth; z++) {
-        for (u32 y = 0; y < height; y += block_height) {
-            for (u32 x = 0; x < width; x += block_width) {
-                const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
-
-                // Blocks can be at most 12x12
-                std::array<u32, 12 * 12> uncompData;
-                DecompressBlock(blockPtr, block_width, block_height, uncompData);
-
-                u32 decompWidth = std::min(block_width, width - x);
-                u32 decompHeight = std::min(block_height, height - y);
-
-                const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
-                for (u32 jj = 0; jj < decompHeight; jj++) {
-                    std::memcpy(outRow.data() + jj * width * 4,
-                                uncompData.data() + jj * block_width, decompWidth * 4);
-                }
-                ++block_index;
+/// Minimum number of blocks in an image before decoding is split across threads
+static constexpr u32 PARALLEL_DECODE_MIN_BLOCKS = 1024;
+/// Approximate number of blocks decoded by a thread each time it fetches work
+static constexpr u32 BLOCKS_PER_CHUNK = 256;
+
+static void DecompressBlockRows(std::span<const uint8_t> data, u32 width, u32 height,
+                                u32 block_width, u32 block_height, u32 blocks_x, u32 blocks_y,
+                                u32 row_begin, u32 row_end, std::span<uint8_t> output) {
+    for (u32 row = row_begin; row < row_end; ++row) {
+        const u32 z = row / blocks_y;
+        const u32 y = (row % blocks_y) * block_height;
+        const std::size_t depth_offset = static_cast<std::size_t>(z) * height * width * 4;
+        u32 block_index = row * blocks_x;
+        for (u32 x = 0; x < width; x += block_width) {
+            const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
+
+            // Blocks can be at most 12x12
+            std::array<u32, 12 * 12> uncompData;
+            DecompressBlock(blockPtr, block_width, block_height, uncompData);
+
+            u32 decompWidth = std::min(block_width, width - x);
+            u32 decompHeight = std::min(block_height, height - y);
+
+            const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
+            for (u32 jj = 0; jj < decompHeight; jj++) {
+                std::memcpy(outRow.data() + jj * width * 4, uncompData.data() + jj * block_width,
+                            decompWidth * 4);
             }
+            ++block_index;
         }
-        depth_offset += height * width * 4;
     }
 }
 
+void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
+                uint32_t block_width, uint32_t block_height, std::span<uint8_t> output) {
+    const u32 blocks_x = Common::DivCeil(width, block_width);
+    const u32 blocks_y = Common::DivCeil(height, block_height);
+    const u32 num_rows = blocks_y * depth;
+    const auto decompress_rows = [&](u32 row_begin, u32 row_end) {
+        DecompressBlockRows(data, width, height, block_width, block_height, blocks_x, blocks_y,
+                            row_begin, row_end, output);
+    };
+    if (blocks_x * num_rows < PARALLEL_DECODE_MIN_BLOCKS) {
+        decompress_rows(0, num_rows);
+        return;
+    }
+
+    // Block rows write to disjoint rows of the output, so they can be decoded independently
+    const u32 rows_per_chunk = std::max(BLOCKS_PER_CHUNK / blocks_x, 1U);
+    const u32 num_chunks = Common::DivCeil(num_rows, rows_per_chunk);
+    Common::ParallelFor(num_chunks, [&](std::size_t chunk) {
+        const u32 row_begin = static_cast<u32>(chunk) * rows_per_chunk;
+        decompress_rows(row_begin, std::min(row_begin + rows_per_chunk, num_rows));
+    });
+}
+
 } // namespace Tegra::Texture::ASTC
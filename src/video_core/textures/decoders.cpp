@@ -2,10 +2,12 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstring>
 #include <span>
+#include <type_traits>
 #include <utility>
 
 #include "common/alignment.h"
@@ -18,9 +20,97 @@
 
 namespace Tegra::Texture {
 namespace {
+/// Bytes within a sector are contiguous in both the linear and the block linear layouts
+constexpr u32 SECTOR_SIZE = 16;
+
+/// Returns true when pixels of the given size never straddle a sector boundary
+constexpr bool IsSectorCopyable(u32 bytes_per_pixel) {
+    return bytes_per_pixel != 0 && SECTOR_SIZE % bytes_per_pixel == 0;
+}
+
+/**
+ * Visits the sectors covered by the bytes [x_begin, x_end) of a line within a row of gobs.
+ * Full sectors are handed over with a constant size, so copies of them compile down to a single
+ * 16 byte vector move instead of one call per pixel.
+ *
+ * @param x_begin First byte of the line to visit
+ * @param x_end   One past the last byte of the line to visit
+ * @param x_shift Log2 of the distance in bytes between horizontally adjacent gobs
+ * @param table   Swizzle table row of the line being visited
+ * @param func    Called with (x, swizzled_offset, size) for each sector, returning false stops
+ */
+template <typename Func>
+void ForEachSector(u32 x_begin, u32 x_end, u32 x_shift, const std::array<u32, GOB_SIZE_X>& table,
+                   Func&& func) {
+    u32 x = x_begin;
+    while (x < x_end) {
+        const u32 swizzled_offset = ((x >> GOB_SIZE_X_SHIFT) << x_shift) + table[x % GOB_SIZE_X];
+        const u32 sector_end = Common::AlignUpLog2(x + 1, 4);
+        if (sector_end <= x_end && x % SECTOR_SIZE == 0) {
+            if (!func(x, swizzled_offset, std::integral_constant<u32, SECTOR_SIZE>{})) {
+                return;
+            }
+            x += SECTOR_SIZE;
+        } else {
+            const u32 size = std::min(sector_end, x_end) - x;
+            if (!func(x, swizzled_offset, size)) {
+                return;
+            }
+            x += size;
+        }
+    }
+}
+
 template <bool TO_LINEAR>
-void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
-             u32 height, u32 depth, u32 block_height, u32 block_depth, u32 stride_alignment) {
+void SwizzleSectors(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
+                    u32 width, u32 height, u32 depth, u32 block_height, u32 block_depth,
+                    u32 stride_alignment) {
+    const u32 pitch = width * bytes_per_pixel;
+    const u32 stride = Common::AlignUpLog2(width, stride_alignment) * bytes_per_pixel;
+
+    const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
+    const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height + block_depth);
+    const u32 slice_size =
+        Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT) * block_size;
+
+    const u32 block_height_mask = (1U << block_height) - 1;
+    const u32 block_depth_mask = (1U << block_depth) - 1;
+    const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
+
+    for (u32 z = 0; z < depth; ++z) {
+        const u32 offset_z = (z >> block_depth) * slice_size +
+                             ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
+        for (u32 y = 0; y < height; ++y) {
+            const auto& table = SWIZZLE_TABLE[y % GOB_SIZE_Y];
+
+            const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
+            const u32 offset_y = (block_y >> block_height) * block_size +
+                                 ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+            const u32 base_swizzled_offset = offset_z + offset_y;
+            const u32 base_unswizzled_offset = z * pitch * height + y * pitch;
+
+            ForEachSector(0, pitch, x_shift, table, [&](u32 x, u32 swizzled_offset, auto size) {
+                const u32 swizzled = base_swizzled_offset + swizzled_offset;
+                const u32 unswizzled = base_unswizzled_offset + x;
+                if (const auto offset = (TO_LINEAR ? unswizzled : swizzled);
+                    offset + size > input.size()) {
+                    // TODO(Rodrigo): This is an out of bounds access that should never happen. To
+                    // avoid crashing the emulator, break.
+                    ASSERT_MSG(false, "offset {} exceeds input size {}!", offset, input.size());
+                    return false;
+                }
+                u8* const dst = &output[TO_LINEAR ? swizzled : unswizzled];
+                const u8* const src = &input[TO_LINEAR ? unswizzled : swizzled];
+                std::memcpy(dst, src, size);
+                return true;
+            });
+        }
+    }
+}
+
+template <bool TO_LINEAR>
+void SwizzlePixels(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
+                   u32 height, u32 depth, u32 block_height, u32 block_depth, u32 stride_alignment) {
     // The origin of the transformation can be configured here, leave it as zero as the current API
     // doesn't expose it.
     static constexpr u32 origin_x = 0;
@@ -78,6 +168,18 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
         }
     }
 }
+
+template <bool TO_LINEAR>
+void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
+             u32 height, u32 depth, u32 block_height, u32 block_depth, u32 stride_alignment) {
+    if (IsSectorCopyable(bytes_per_pixel)) {
+        SwizzleSectors<TO_LINEAR>(output, input, bytes_per_pixel, width, height, depth,
+                                  block_height, block_depth, stride_alignment);
+    } else {
+        SwizzlePixels<TO_LINEAR>(output, input, bytes_per_pixel, width, height, depth,
+                                 block_height, block_depth, stride_alignment);
+    }
+}
 } // Anonymous namespace
 
 void UnswizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
@@ -100,12 +202,25 @@ void SwizzleSubrect(u32 subrect_width, u32 subrect_height, u32 source_pitch, u32
     const u32 block_height = 1U << block_height_bit;
     const u32 image_width_in_gobs =
         (swizzled_width * bytes_per_pixel + (GOB_SIZE_X - 1)) / GOB_SIZE_X;
+    const bool sector_copyable = IsSectorCopyable(bytes_per_pixel);
     for (u32 line = 0; line < subrect_height; ++line) {
         const u32 dst_y = line + offset_y;
         const u32 gob_address_y =
             (dst_y / (GOB_SIZE_Y * block_height)) * GOB_SIZE * block_height * image_width_in_gobs +
             ((dst_y % (GOB_SIZE_Y * block_height)) / GOB_SIZE_Y) * GOB_SIZE;
         const auto& table = SWIZZLE_TABLE[dst_y % GOB_SIZE_Y];
+        if (sector_copyable) {
+            const u32 x_begin = offset_x * bytes_per_pixel;
+            const u32 x_end = (offset_x + subrect_width) * bytes_per_pixel;
+            const u8* const source_line = unswizzled_data + line * source_pitch;
+            ForEachSector(x_begin, x_end, GOB_SIZE_SHIFT + block_height_bit, table,
+                          [&](u32 x, u32 swizzled_offset, auto size) {
+                              std::memcpy(swizzled_data + gob_address_y + swizzled_offset,
+                                          source_line + (x - x_begin), size);
+                              return true;
+                          });
+            continue;
+        }
         for (u32 x = 0; x < subrect_width; ++x) {
             const u32 dst_x = x + offset_x;
             const u32 gob_address =
@@ -128,6 +243,7 @@ void UnswizzleSubrect(u32 line_length_in, u32 line_count, u32 pitch, u32 width,
 
     const u32 block_height_mask = (1U << block_height) - 1;
     const u32 x_shift = GOB_SIZE_SHIFT + block_height;
+    const bool sector_copyable = IsSectorCopyable(bytes_per_pixel);
 
     for (u32 line = 0; line < line_count; ++line) {
         const u32 src_y = line + origin_y;
@@ -136,6 +252,18 @@ void UnswizzleSubrect(u32 line_length_in, u32 line_count, u32 pitch, u32 width,
         const u32 block_y = src_y >> GOB_SIZE_Y_SHIFT;
         const u32 src_offset_y = (block_y >> block_height) * block_size +
                                  ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+        if (sector_copyable) {
+            const u32 x_begin = origin_x * bytes_per_pixel;
+            const u32 x_end = (origin_x + line_length_in) * bytes_per_pixel;
+            u8* const output_line = output + line * pitch;
+            ForEachSector(x_begin, x_end, x_shift, table,
+                          [&](u32 x, u32 swizzled_offset, auto size) {
+                              std::memcpy(output_line + (x - x_begin),
+                                          input + src_offset_y + swizzled_offset, size);
+                              return true;
+                          });
+            continue;
+        }
         for (u32 column = 0; column < line_length_in; ++column) {
             const u32 src_x = (column + origin_x) * bytes_per_pixel;
             const u32 src_offset_x = (src_x >> GOB_SIZE_X_SHIFT) << x_shift;
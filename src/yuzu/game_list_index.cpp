@@ -0,0 +1,213 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QString>
+
+#include "common/fs/fs.h"
+#include "common/fs/fs_util.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "yuzu/game_list_index.h"
+
+namespace {
+constexpr quint32 INDEX_MAGIC = 0x58444E49; // "INDX"
+
+// Bump whenever the layout of the records or the way their metadata is read changes
+constexpr quint32 INDEX_VERSION = 2;
+
+std::filesystem::path GetIndexPath() {
+    return Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "game_list" / "index.bin";
+}
+
+QString ToQString(const std::filesystem::path& path) {
+    return QString::fromStdString(Common::FS::PathToUTF8String(path));
+}
+
+/// Returns the size and modification time of the file at path, if it exists
+std::optional<std::pair<u64, s64>> GetFileStamp(const std::string& path) {
+    const std::filesystem::path fs_path{Common::FS::ToU8String(path)};
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(fs_path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    const auto modification_time = std::filesystem::last_write_time(fs_path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    return std::make_pair(static_cast<u64>(size),
+                          static_cast<s64>(modification_time.time_since_epoch().count()));
+}
+
+QByteArray ToByteArray(const std::string& str) {
+    return QByteArray(str.data(), static_cast<int>(str.size()));
+}
+} // Anonymous namespace
+
+GameListIndex::GameListIndex() = default;
+
+GameListIndex::~GameListIndex() = default;
+
+void GameListIndex::Load() {
+    records.clear();
+    dirty = false;
+
+    QFile file{ToQString(GetIndexPath())};
+    if (!file.open(QFile::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream{&file};
+    quint32 magic{};
+    quint32 version{};
+    quint32 count{};
+    stream >> magic >> version >> count;
+    if (magic != INDEX_MAGIC || version != INDEX_VERSION) {
+        LOG_INFO(Frontend, "Discarding outdated game list index");
+        return;
+    }
+
+    records.reserve(count);
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QByteArray path;
+        quint64 size{};
+        qint64 modification_time{};
+        qint32 file_type{};
+        quint64 program_id{};
+        bool has_metadata{};
+        QByteArray name;
+        QByteArray icon;
+        quint32 content_count{};
+        stream >> path >> size >> modification_time >> file_type >> program_id >> has_metadata >>
+            name >> icon >> content_count;
+
+        Record record;
+        record.size = size;
+        record.modification_time = modification_time;
+        record.entry.file_type = static_cast<Loader::FileType>(file_type);
+        record.entry.program_id = program_id;
+        record.entry.has_metadata = has_metadata;
+        record.entry.name = name.toStdString();
+        record.entry.icon.assign(icon.begin(), icon.end());
+        for (quint32 j = 0; j < content_count && stream.status() == QDataStream::Ok; ++j) {
+            quint8 title_type{};
+            quint8 record_type{};
+            quint64 title_id{};
+            quint64 offset{};
+            quint64 content_size{};
+            QByteArray content_name;
+            stream >> title_type >> record_type >> title_id >> offset >> content_size >>
+                content_name;
+            record.entry.contents.push_back({
+                .title_type = static_cast<FileSys::TitleType>(title_type),
+                .record_type = static_cast<FileSys::ContentRecordType>(record_type),
+                .title_id = title_id,
+                .offset = offset,
+                .size = content_size,
+                .name = content_name.toStdString(),
+            });
+        }
+        records.insert_or_assign(path.toStdString(), std::move(record));
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        LOG_ERROR(Frontend, "Game list index is corrupted, discarding it");
+        records.clear();
+    }
+}
+
+void GameListIndex::Save() const {
+    std::size_t used_records = 0;
+    for (const auto& [path, record] : records) {
+        if (record.used) {
+            ++used_records;
+        }
+    }
+    if (!dirty && used_records == records.size()) {
+        return;
+    }
+
+    const auto index_path = GetIndexPath();
+    void(Common::FS::CreateParentDirs(index_path));
+
+    // Written to a temporary file first, so that concurrent scans never see a partial index
+    QSaveFile file{ToQString(index_path)};
+    if (!file.open(QFile::WriteOnly)) {
+        LOG_ERROR(Frontend, "Failed to open game list index for writing");
+        return;
+    }
+
+    QDataStream stream{&file};
+    stream << INDEX_MAGIC << INDEX_VERSION << static_cast<quint32>(used_records);
+    for (const auto& [path, record] : records) {
+        if (!record.used) {
+            continue;
+        }
+        const Entry& entry = record.entry;
+        stream << ToByteArray(path) << static_cast<quint64>(record.size)
+               << static_cast<qint64>(record.modification_time)
+               << static_cast<qint32>(entry.file_type) << static_cast<quint64>(entry.program_id)
+               << entry.has_metadata << ToByteArray(entry.name)
+               << QByteArray(reinterpret_cast<const char*>(entry.icon.data()),
+                             static_cast<int>(entry.icon.size()))
+               << static_cast<quint32>(entry.contents.size());
+        for (const Content& content : entry.contents) {
+            stream << static_cast<quint8>(content.title_type)
+                   << static_cast<quint8>(content.record_type)
+                   << static_cast<quint64>(content.title_id) << static_cast<quint64>(content.offset)
+                   << static_cast<quint64>(content.size) << ToByteArray(content.name);
+        }
+    }
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        LOG_ERROR(Frontend, "Failed to write game list index");
+    }
+}
+
+std::optional<GameListIndex::Entry> GameListIndex::Find(const std::string& path) {
+    const auto it = records.find(path);
+    if (it == records.end()) {
+        return std::nullopt;
+    }
+
+    const auto stamp = GetFileStamp(path);
+    if (!stamp || stamp->first != it->second.size ||
+        stamp->second != it->second.modification_time) {
+        records.erase(it);
+        dirty = true;
+        return std::nullopt;
+    }
+
+    it->second.used = true;
+    return it->second.entry;
+}
+
+void GameListIndex::Insert(const std::string& path, Entry entry) {
+    const auto stamp = GetFileStamp(path);
+    if (!stamp) {
+        return;
+    }
+
+    records.insert_or_assign(path, Record{
+                                       .size = stamp->first,
+                                       .modification_time = stamp->second,
+                                       .entry = std::move(entry),
+                                       .used = true,
+                                   });
+    dirty = true;
+}
+
+void GameListIndex::Remove() {
+    if (!Common::FS::RemoveFile(GetIndexPath())) {
+        LOG_ERROR(Frontend, "Failed to remove game list index");
+    }
+}
@@ -0,0 +1,76 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/file_sys/nca_metadata.h"
+#include "core/loader/loader.h"
+
+/**
+ * Persistent index of the metadata shown by the game list for the files found in the game
+ * directories, so that files which did not change since the last scan don't have to be parsed,
+ * decrypted and have their icons extracted again. For containers it also records where each NCA
+ * lies in the file, so their contents can be added to the content provider without a loader.
+ *
+ * Entries are keyed by the path of the file and are only returned while its size and
+ * modification time still match the ones it was indexed with. Saving the index drops the entries
+ * that were not looked up since it was loaded, so removed files don't accumulate.
+ */
+class GameListIndex {
+public:
+    /// An NCA stored in an indexed file, which may be the whole file
+    struct Content {
+        FileSys::TitleType title_type{};
+        FileSys::ContentRecordType record_type{};
+        u64 title_id{};
+        u64 offset{};
+        u64 size{};
+        std::string name;
+    };
+
+    struct Entry {
+        Loader::FileType file_type{Loader::FileType::Unknown};
+        u64 program_id{};
+        /// False if the file provides no title or icon, such as executables
+        bool has_metadata{};
+        std::string name;
+        std::vector<u8> icon;
+        std::vector<Content> contents;
+    };
+
+    GameListIndex();
+    ~GameListIndex();
+
+    /// Loads the index from the cache directory, discarding it if it is invalid or outdated.
+    void Load();
+
+    /// Writes the entries used since the index was loaded back to the cache directory.
+    void Save() const;
+
+    /// Returns the entry for the file at path, if it is indexed and unchanged.
+    std::optional<Entry> Find(const std::string& path);
+
+    /// Indexes the file at path with its current size and modification time.
+    void Insert(const std::string& path, Entry entry);
+
+    /// Deletes the index from the cache directory, so that every file is read again.
+    static void Remove();
+
+private:
+    struct Record {
+        u64 size{};
+        s64 modification_time{};
+        Entry entry;
+        bool used{};
+    };
+
+    std::unordered_map<std::string, Record> records;
+    bool dirty{};
+};
@@ -2,7 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -23,6 +25,7 @@
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/submission_package.h"
+#include "core/file_sys/vfs_offset.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/loader/loader.h"
 #include "yuzu/compatibility_list.h"
@@ -192,10 +195,109 @@ QString FormatPatchNameVersions(const FileSys::PatchManager& patch_manager,
     return out;
 }
 
+/// Returns the offset of file in container, if file is a window into it
+std::optional<u64> FindOffsetInContainer(FileSys::VirtualFile file,
+                                         const FileSys::VirtualFile& container) {
+    u64 offset = 0;
+    while (file != container) {
+        const auto offset_file = std::dynamic_pointer_cast<FileSys::OffsetVfsFile>(file);
+        if (!offset_file) {
+            return std::nullopt;
+        }
+        offset += offset_file->GetOffset();
+        file = offset_file->GetWrappedFile();
+    }
+    return offset;
+}
+
+/// Returns whether a read failed only because the file does not provide that metadata
+bool IsMetadataUnavailable(Loader::ResultStatus result) {
+    return result == Loader::ResultStatus::ErrorNotImplemented ||
+           result == Loader::ResultStatus::ErrorNoIcon ||
+           result == Loader::ResultStatus::ErrorNoControl;
+}
+
+/**
+ * Reads the metadata the game list shows for a file and the NCAs it adds to the content provider,
+ * a null loader gives an entry of type Error
+ * @param indexable Set to whether the metadata was read completely and can be indexed. Files
+ *                  without a title or icon are, failed reads are not, they may succeed once the
+ *                  missing keys are added.
+ */
+GameListIndex::Entry ReadIndexEntry(Loader::AppLoader* loader, const FileSys::VirtualFile& file,
+                                    bool& indexable) {
+    GameListIndex::Entry entry{.file_type = Loader::FileType::Error};
+    indexable = false;
+    if (!loader) {
+        return entry;
+    }
+
+    entry.file_type = loader->GetFileType();
+    if (entry.file_type == Loader::FileType::Unknown ||
+        entry.file_type == Loader::FileType::Error) {
+        return entry;
+    }
+
+    const auto res2 = loader->ReadProgramId(entry.program_id);
+    const auto res1 = loader->ReadIcon(entry.icon);
+
+    entry.name = " ";
+    const auto res3 = loader->ReadTitle(entry.name);
+
+    entry.has_metadata =
+        res1 == Loader::ResultStatus::Success && res3 == Loader::ResultStatus::Success;
+    indexable = (res1 == Loader::ResultStatus::Success || IsMetadataUnavailable(res1)) &&
+                (res3 == Loader::ResultStatus::Success || IsMetadataUnavailable(res3));
+
+    if (res2 != Loader::ResultStatus::Success) {
+        return entry;
+    }
+    if (entry.file_type == Loader::FileType::NCA) {
+        entry.contents.push_back({
+            .title_type = FileSys::TitleType::Application,
+            .record_type = FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType()),
+            .title_id = entry.program_id,
+            .offset = 0,
+            .size = file->GetSize(),
+            .name = file->GetName(),
+        });
+    } else if (entry.file_type == Loader::FileType::XCI ||
+               entry.file_type == Loader::FileType::NSP) {
+        const auto nsp = entry.file_type == Loader::FileType::NSP
+                             ? std::make_shared<FileSys::NSP>(file)
+                             : FileSys::XCI{file}.GetSecurePartitionNSP();
+        for (const auto& [title_id, ncas] : nsp->GetNCAs()) {
+            for (const auto& [type, nca] : ncas) {
+                const auto nca_file = nca->GetBaseFile();
+                const auto offset = FindOffsetInContainer(nca_file, file);
+                if (!offset) {
+                    LOG_WARNING(Frontend, "NCA {} is not stored directly in {}",
+                                nca_file->GetName(), file->GetName());
+                    continue;
+                }
+                entry.contents.push_back({
+                    .title_type = type.first,
+                    .record_type = type.second,
+                    .title_id = title_id,
+                    .offset = *offset,
+                    .size = nca_file->GetSize(),
+                    .name = nca_file->GetName(),
+                });
+            }
+        }
+    }
+    return entry;
+}
+
+/**
+ * @param get_loader Returns the loader of the file, only called when the patch versions of the
+ *                   title are not cached. May return nullptr if the file can no longer be loaded.
+ */
 QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::string& name,
-                                        const std::vector<u8>& icon, Loader::AppLoader& loader,
+                                        const std::vector<u8>& icon, Loader::FileType file_type,
                                         u64 program_id, const CompatibilityList& compatibility_list,
-                                        const FileSys::PatchManager& patch) {
+                                        const FileSys::PatchManager& patch,
+                                        const std::function<Loader::AppLoader*()>& get_loader) {
     const auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
 
     // The game list uses this as compatibility number for untested games
@@ -204,7 +306,6 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
         compatibility = it->second.first;
     }
 
-    const auto file_type = loader.GetFileType();
     const auto file_type_string = QString::fromStdString(Loader::GetFileTypeString(file_type));
 
     QList<QStandardItem*> list{
@@ -216,8 +317,12 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
     };
 
     const auto patch_versions = GetGameListCachedObject(
-        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", [&patch, &loader] {
-            return FormatPatchNameVersions(patch, loader, loader.IsRomFSUpdatable());
+        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", [&patch, &get_loader] {
+            Loader::AppLoader* const loader = get_loader();
+            if (!loader) {
+                return QString{};
+            }
+            return FormatPatchNameVersions(patch, *loader, loader->IsRomFSUpdatable());
         });
     list.insert(2, new GameListItem(patch_versions));
 
@@ -277,8 +382,9 @@ void GameListWorker::AddTitlesToGameList(GameListDir* parent_dir) {
             GetMetadataFromControlNCA(patch, *control, icon, name);
         }
 
-        emit EntryReady(MakeGameListEntry(file->GetFullPath(), name, icon, *loader, program_id,
-                                          compatibility_list, patch),
+        emit EntryReady(MakeGameListEntry(file->GetFullPath(), name, icon, loader->GetFileType(),
+                                          program_id, compatibility_list, patch,
+                                          [&loader] { return loader.get(); }),
                         parent_dir);
     }
 }
@@ -304,49 +410,49 @@ void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_pa
                 return true;
             }
 
-            auto loader = Loader::GetLoader(system, file);
-            if (!loader) {
-                return true;
+            // Unchanged files are listed from the index, which also records the contents they add
+            // to the content provider. Their loader is only created when the patch versions of
+            // the title are not cached.
+            std::unique_ptr<Loader::AppLoader> loader;
+            auto metadata = index.Find(physical_name);
+            if (!metadata) {
+                loader = Loader::GetLoader(system, file);
+                bool indexable{};
+                metadata = ReadIndexEntry(loader.get(), file, indexable);
+                if (indexable) {
+                    index.Insert(physical_name, *metadata);
+                }
             }
 
-            const auto file_type = loader->GetFileType();
+            const auto file_type = metadata->file_type;
             if (file_type == Loader::FileType::Unknown || file_type == Loader::FileType::Error) {
                 return true;
             }
 
-            u64 program_id = 0;
-            const auto res2 = loader->ReadProgramId(program_id);
-
             if (target == ScanTarget::FillManualContentProvider) {
-                if (res2 == Loader::ResultStatus::Success && file_type == Loader::FileType::NCA) {
-                    provider->AddEntry(FileSys::TitleType::Application,
-                                       FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType()),
-                                       program_id, file);
-                } else if (res2 == Loader::ResultStatus::Success &&
-                           (file_type == Loader::FileType::XCI ||
-                            file_type == Loader::FileType::NSP)) {
-                    const auto nsp = file_type == Loader::FileType::NSP
-                                         ? std::make_shared<FileSys::NSP>(file)
-                                         : FileSys::XCI{file}.GetSecurePartitionNSP();
-                    for (const auto& title : nsp->GetNCAs()) {
-                        for (const auto& entry : title.second) {
-                            provider->AddEntry(entry.first.first, entry.first.second, title.first,
-                                               entry.second->GetBaseFile());
-                        }
+                for (const GameListIndex::Content& content : metadata->contents) {
+                    FileSys::VirtualFile nca_file = file;
+                    if (content.offset != 0 || content.size != file->GetSize()) {
+                        nca_file = std::make_shared<FileSys::OffsetVfsFile>(
+                            file, content.size, content.offset, content.name);
                     }
+                    provider->AddEntry(content.title_type, content.record_type, content.title_id,
+                                       nca_file);
                 }
             } else {
-                std::vector<u8> icon;
-                [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
-
-                std::string name = " ";
-                [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
-
-                const FileSys::PatchManager patch{program_id, system.GetFileSystemController(),
+                const FileSys::PatchManager patch{metadata->program_id,
+                                                  system.GetFileSystemController(),
                                                   system.GetContentProvider()};
+                const auto get_loader = [&] {
+                    if (!loader) {
+                        loader = Loader::GetLoader(system, file);
+                    }
+                    return loader.get();
+                };
 
-                emit EntryReady(MakeGameListEntry(physical_name, name, icon, *loader, program_id,
-                                                  compatibility_list, patch),
+                emit EntryReady(MakeGameListEntry(physical_name, metadata->name, metadata->icon,
+                                                  file_type, metadata->program_id,
+                                                  compatibility_list, patch, get_loader),
                                 parent_dir);
             }
         } else if (is_dir) {
@@ -368,6 +474,10 @@ void GameListWorker::run() {
     stop_processing = false;
     provider->ClearAllEntries();
 
+    if (UISettings::values.cache_game_list) {
+        index.Load();
+    }
+
     for (UISettings::GameDir& game_dir : game_dirs) {
         if (game_dir.path == QStringLiteral("SDMC")) {
             auto* const game_list_dir = new GameListDir(game_dir, GameListItemType::SdmcDir);
@@ -392,6 +502,11 @@ void GameListWorker::run() {
         }
     }
 
+    // A cancelled scan only looked up part of the files, saving it would drop the others
+    if (UISettings::values.cache_game_list && !stop_processing) {
+        index.Save();
+    }
+
     emit Finished(watch_list);
 }
 
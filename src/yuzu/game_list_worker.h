@@ -18,6 +18,7 @@
 
 #include "common/common_types.h"
 #include "yuzu/compatibility_list.h"
+#include "yuzu/game_list_index.h"
 
 class QStandardItem;
 
@@ -78,6 +79,7 @@ private:
     QVector<UISettings::GameDir>& game_dirs;
     const CompatibilityList& compatibility_list;
 
+    GameListIndex index;
     QStringList watch_list;
     std::atomic_bool stop_processing;
 };
@@ -33,6 +33,9 @@ InstallDialog::InstallDialog(QWidget* parent, const QStringList& files) : QDialo
     update_description =
         new QLabel(tr("Installing an Update or DLC will overwrite the previously installed one."));
 
+    verify_checkbox = new QCheckBox(tr("Verify the integrity of NSP and XCI contents (slower)"));
+    verify_checkbox->setChecked(false);
+
     buttons = new QDialogButtonBox;
     buttons->addButton(QDialogButtonBox::Cancel);
     buttons->addButton(tr("Install"), QDialogButtonBox::AcceptRole);
@@ -45,6 +48,7 @@ InstallDialog::InstallDialog(QWidget* parent, const QStringList& files) : QDialo
     vbox_layout->addWidget(description);
     vbox_layout->addWidget(update_description);
     vbox_layout->addWidget(file_list);
+    vbox_layout->addWidget(verify_checkbox);
     vbox_layout->addLayout(hbox_layout);
 
     setLayout(vbox_layout);
@@ -67,6 +71,10 @@ QStringList InstallDialog::GetFiles() const {
     return files;
 }
 
+bool InstallDialog::VerifyFiles() const {
+    return verify_checkbox->isChecked();
+}
+
 int InstallDialog::GetMinimumWidth() const {
     return file_list->width();
 }
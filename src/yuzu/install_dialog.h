@@ -21,6 +21,7 @@ public:
     ~InstallDialog() override;
 
     [[nodiscard]] QStringList GetFiles() const;
+    [[nodiscard]] bool VerifyFiles() const;
     [[nodiscard]] int GetMinimumWidth() const;
 
 private:
@@ -31,5 +32,6 @@ private:
 
     QLabel* description;
     QLabel* update_description;
+    QCheckBox* verify_checkbox;
     QDialogButtonBox* buttons;
 };
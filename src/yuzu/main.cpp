@@ -118,6 +118,7 @@ static FileSys::VirtualFile VfsDirectoryCreateFileWrapper(const FileSys::Virtual
 #include "yuzu/debugger/wait_tree.h"
 #include "yuzu/discord.h"
 #include "yuzu/game_list.h"
+#include "yuzu/game_list_index.h"
 #include "yuzu/game_list_p.h"
 #include "yuzu/hotkeys.h"
 #include "yuzu/install_dialog.h"
@@ -2113,8 +2114,8 @@ void GMainWindow::OnMenuLoadFolder() {
     }
 }
 
-void GMainWindow::IncrementInstallProgress() {
-    install_progress->setValue(install_progress->value() + 1);
+void GMainWindow::IncrementInstallProgress(int increment) {
+    install_progress->setValue(install_progress->value() + increment);
 }
 
 void GMainWindow::OnMenuInstallToNAND() {
@@ -2136,6 +2137,7 @@ void GMainWindow::OnMenuInstallToNAND() {
     }
 
     const QStringList files = installDialog.GetFiles();
+    const bool verify_files = installDialog.VerifyFiles();
 
     if (files.isEmpty()) {
         return;
@@ -2178,7 +2180,8 @@ void GMainWindow::OnMenuInstallToNAND() {
         if (file.endsWith(QStringLiteral("xci"), Qt::CaseInsensitive) ||
             file.endsWith(QStringLiteral("nsp"), Qt::CaseInsensitive)) {
 
-            future = QtConcurrent::run([this, &file] { return InstallNSPXCI(file); });
+            future = QtConcurrent::run(
+                [this, &file, verify_files] { return InstallNSPXCI(file, verify_files); });
 
             while (!future.isFinished()) {
                 QCoreApplication::processEvents();
@@ -2237,29 +2240,16 @@ void GMainWindow::OnMenuInstallToNAND() {
     ui.action_Install_File_NAND->setEnabled(true);
 }
 
-InstallResult GMainWindow::InstallNSPXCI(const QString& filename) {
-    const auto qt_raw_copy = [this](const FileSys::VirtualFile& src,
-                                    const FileSys::VirtualFile& dest, std::size_t block_size) {
-        if (src == nullptr || dest == nullptr) {
-            return false;
-        }
-        if (!dest->Resize(src->GetSize())) {
+InstallResult GMainWindow::InstallNSPXCI(const QString& filename, bool verify_files) {
+    // The progress bar counts 4 KiB units, carry over what the blocks written don't fill
+    std::size_t pending_bytes = 0;
+    const auto progress = [this, &pending_bytes](std::size_t written) {
+        if (install_progress->wasCanceled()) {
             return false;
         }
-
-        std::array<u8, 0x1000> buffer{};
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
-            if (install_progress->wasCanceled()) {
-                dest->Resize(0);
-                return false;
-            }
-
-            emit UpdateInstallProgress();
-
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
-        }
+        pending_bytes += written;
+        emit UpdateInstallProgress(static_cast<int>(pending_bytes / 0x1000));
+        pending_bytes %= 0x1000;
         return true;
     };
 
@@ -2281,7 +2271,7 @@ InstallResult GMainWindow::InstallNSPXCI(const QString& filename) {
     }
     const auto res =
         Core::System::GetInstance().GetFileSystemController().GetUserNANDContents()->InstallEntry(
-            *nsp, true, qt_raw_copy);
+            *nsp, true, progress, verify_files);
     switch (res) {
     case FileSys::InstallResult::Success:
         return InstallResult::Success;
@@ -2312,7 +2302,7 @@ InstallResult GMainWindow::InstallNCA(const QString& filename) {
                 return false;
             }
 
-            emit UpdateInstallProgress();
+            emit UpdateInstallProgress(1);
 
             const auto read = src->Read(buffer.data(), buffer.size(), i);
             dest->Write(buffer.data(), read, i);
@@ -3073,7 +3063,8 @@ void GMainWindow::OnReinitializeKeys(ReinitializeKeyBehavior behavior) {
     }
 
     Core::Crypto::KeyManager& keys = Core::Crypto::KeyManager::Instance();
-    if (keys.BaseDeriveNecessary()) {
+    const bool derive_keys = keys.BaseDeriveNecessary();
+    if (derive_keys) {
         Core::Crypto::PartitionDataManager pdm{vfs->OpenDirectory("", FileSys::Mode::Read)};
 
         const auto function = [this, &keys, &pdm] {
@@ -3125,6 +3116,11 @@ void GMainWindow::OnReinitializeKeys(ReinitializeKeyBehavior behavior) {
 
     Core::System::GetInstance().GetFileSystemController().CreateFactories(*vfs);
 
+    // The game list index holds metadata read with the previous keys
+    if (behavior == ReinitializeKeyBehavior::Warning || derive_keys) {
+        GameListIndex::Remove();
+    }
+
     if (behavior == ReinitializeKeyBehavior::Warning) {
         game_list->PopulateAsync(UISettings::values.game_dirs);
     }
@@ -134,7 +134,7 @@ signals:
     // Signal that tells widgets to update icons to use the current theme
     void UpdateThemedIcons();
 
-    void UpdateInstallProgress();
+    void UpdateInstallProgress(int increment);
 
     void ControllerSelectorReconfigureFinished();
 
@@ -255,7 +255,7 @@ private slots:
     void OnGameListOpenPerGameProperties(const std::string& file);
     void OnMenuLoadFile();
     void OnMenuLoadFolder();
-    void IncrementInstallProgress();
+    void IncrementInstallProgress(int increment);
     void OnMenuInstallToNAND();
     void OnMenuRecentFile();
     void OnConfigure();
@@ -285,7 +285,7 @@ private:
     void RemoveTransferableShaderCache(u64 program_id);
     void RemoveCustomConfiguration(u64 program_id, const std::string& game_path);
     std::optional<u64> SelectRomFSDumpTarget(const FileSys::ContentProvider&, u64 program_id);
-    InstallResult InstallNSPXCI(const QString& filename);
+    InstallResult InstallNSPXCI(const QString& filename, bool verify_files);
     InstallResult InstallNCA(const QString& filename);
     void MigrateConfigFiles();
     void UpdateWindowTitle(std::string_view title_name = {}, std::string_view title_version = {},